@@ -0,0 +1,99 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef BENCH_BENCH_UTIL_H_
+#define BENCH_BENCH_UTIL_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ascenddk/presenter/agent/channel.h"
+#include "ascenddk/presenter/agent/presenter_types.h"
+#include "proto/presenter_message.pb.h"
+
+namespace ascend {
+namespace presenter {
+namespace bench {
+
+/**
+ * @brief make an ImageFrame with detection results, data is not owned
+ * @param [in] data                 image data
+ * @param [in] detection_num        number of detection results
+ * @return ImageFrame
+ */
+inline ImageFrame MakeImage(const std::string& data, int detection_num) {
+  ImageFrame image;
+  image.format = ImageFormat::kJpeg;
+  image.width = 1280;
+  image.height = 720;
+  image.size = data.size();
+  image.data = reinterpret_cast<unsigned char*>(
+      const_cast<char*>(data.data()));
+  for (int i = 0; i < detection_num; ++i) {
+    DetectionResult result;
+    result.lt.x = i % 1280;
+    result.lt.y = i % 720;
+    result.rb.x = result.lt.x + 64;
+    result.rb.y = result.lt.y + 64;
+    result.result_text = "face:98%";
+    image.detection_results.push_back(result);
+  }
+
+  return image;
+}
+
+/**
+ * @brief make the message PresentImage sends for the image
+ * @param [in] image                image
+ * @param [out] request             request, referred by the message
+ * @return message, TLV refers to the image data
+ */
+inline PartialMessageWithTlvs MakeImageMessage(
+    const ImageFrame& image, proto::PresentImageRequest& request) {
+  Tlv tlv;
+  tlv.tag = proto::PresentImageRequest::kDataFieldNumber;
+  tlv.length = image.size;
+  tlv.value = reinterpret_cast<const char*>(image.data);
+
+  PartialMessageWithTlvs message;
+  message.message = &request;
+  message.tlv_list.push_back(tlv);
+  return message;
+}
+
+} /* namespace bench */
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* BENCH_BENCH_UTIL_H_ */
@@ -0,0 +1,165 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "ascenddk/presenter/agent/util/buffer_pool.h"
+#include "ascenddk/presenter/agent/util/byte_buffer.h"
+#include "proto/presenter_message.pb.h"
+
+using namespace std;
+using namespace ascend::presenter;
+
+namespace {
+
+const int kBufferSize = 64 * 1024;
+
+// writes the header of a message, the way MessageCodec does
+void BM_ByteBufferWriterHeader(benchmark::State& state) {
+  unique_ptr<char[]> buf(new char[kBufferSize]);
+  string name = proto::PresentImageRequest::descriptor()->full_name();
+  for (auto _ : state) {
+    ByteBufferWriter writer(buf.get(), kBufferSize);
+    writer.PutUInt32(kBufferSize);
+    writer.PutUInt8(name.size());
+    writer.PutString(name);
+    benchmark::DoNotOptimize(writer.GetBuffer().Get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ByteBufferWriterHeader);
+
+// argument: size of bytes written
+void BM_ByteBufferWriterPutBytes(benchmark::State& state) {
+  unique_ptr<char[]> buf(new char[state.range(0)]);
+  string data(state.range(0), 'x');
+  for (auto _ : state) {
+    ByteBufferWriter writer(buf.get(), state.range(0));
+    writer.PutBytes(data.data(), data.size());
+    benchmark::DoNotOptimize(writer.GetBuffer().Get());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ByteBufferWriterPutBytes)->Arg(64)->Arg(4 * 1024)
+    ->Arg(64 * 1024);
+
+void BM_ByteBufferWriterPutMessage(benchmark::State& state) {
+  unique_ptr<char[]> buf(new char[kBufferSize]);
+  proto::OpenChannelRequest request;
+  request.set_channel_name("bench_channel");
+  request.set_content_type(proto::kChannelContentTypeVideo);
+  for (auto _ : state) {
+    ByteBufferWriter writer(buf.get(), kBufferSize);
+    bool ret = writer.PutMessage(request);
+    benchmark::DoNotOptimize(ret);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ByteBufferWriterPutMessage);
+
+// reads the header and body of a message, the way MessageCodec does
+void BM_ByteBufferReader(benchmark::State& state) {
+  proto::OpenChannelResponse response;
+  response.set_error_code(proto::kOpenChannelErrorNone);
+  string name = response.GetDescriptor()->full_name();
+  string body = response.SerializeAsString();
+
+  char buf[256];
+  ByteBufferWriter writer(buf, sizeof(buf));
+  writer.PutUInt8(name.size());
+  writer.PutString(name);
+  writer.PutBytes(body.data(), body.size());
+  int size = writer.GetBuffer().Size();
+
+  for (auto _ : state) {
+    ByteBufferReader reader(buf, size);
+    uint8_t name_size = reader.ReadUInt8();
+    benchmark::DoNotOptimize(reader.ReadString(name_size));
+    proto::OpenChannelResponse message;
+    bool ret = reader.ReadMessage(reader.RemainingBytes(), message);
+    benchmark::DoNotOptimize(ret);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ByteBufferReader);
+
+// reports the pool counters of the run, system_allocs should stay flat
+void SetPoolCounters(benchmark::State& state, const BufferPoolStats& before) {
+  // counters of threads are summed, the pool is process wide
+  if (state.thread_index() != 0) {
+    return;
+  }
+
+  BufferPoolStats after = BufferPool::GetInstance().GetStats();
+  BufferPoolStats delta = after;
+  delta.allocations -= before.allocations;
+  delta.thread_cache_hits -= before.thread_cache_hits;
+  delta.global_hits -= before.global_hits;
+  state.counters["hit_rate"] = delta.HitRate();
+  state.counters["system_allocs"] = static_cast<double>(
+      after.system_allocations - before.system_allocations);
+  state.counters["reserved_MB"] = after.bytes_reserved / 1024.0 / 1024;
+}
+
+// argument: size of buffer, two buffers per frame as MessageCodec does
+void BM_SharedByteBufferMake(benchmark::State& state) {
+  BufferPoolStats before = BufferPool::GetInstance().GetStats();
+  for (auto _ : state) {
+    SharedByteBuffer header = SharedByteBuffer::Make(64);
+    SharedByteBuffer body = SharedByteBuffer::Make(state.range(0));
+    benchmark::DoNotOptimize(header.GetMutable());
+    benchmark::DoNotOptimize(body.GetMutable());
+  }
+  state.SetItemsProcessed(state.iterations());
+  SetPoolCounters(state, before);
+}
+BENCHMARK(BM_SharedByteBufferMake)->Arg(4 * 1024)->Arg(256 * 1024)
+    ->Arg(4 * 1024 * 1024)->ThreadRange(1, 4);
+
+// the buffer is copied into a send queue, as async sending does
+void BM_SharedByteBufferCopy(benchmark::State& state) {
+  SharedByteBuffer buffer = SharedByteBuffer::Make(4096);
+  vector<SharedByteBuffer> queue;
+  queue.reserve(1);
+  for (auto _ : state) {
+    queue.push_back(buffer);
+    queue.clear();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedByteBufferCopy);
+
+}
@@ -0,0 +1,152 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "ascenddk/presenter/agent/codec/compression.h"
+#include "ascenddk/presenter/agent/codec/message_codec.h"
+#include "ascenddk/presenter/agent/presenter/presenter_message_helper.h"
+#include "bench/bench_util.h"
+
+using namespace std;
+using namespace ascend::presenter;
+using google::protobuf::Message;
+
+namespace {
+
+void BM_EncodeMessage(benchmark::State& state) {
+  MessageCodec codec;
+  proto::OpenChannelRequest request;
+  PresenterMessageHelper::CreateOpenChannelRequest(request, "bench_channel",
+                                                   ContentType::kVideo);
+  for (auto _ : state) {
+    SharedByteBuffer buffer = codec.EncodeMessage(request);
+    benchmark::DoNotOptimize(buffer.Get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeMessage);
+
+// encodes the whole image message to self-contained buffers,
+// argument: size of image data
+void BM_EncodeImageMessage(benchmark::State& state) {
+  MessageCodec codec;
+  string data(state.range(0), 'x');
+  ImageFrame image = bench::MakeImage(data, 10);
+  proto::PresentImageRequest request;
+  PresenterMessageHelper::InitPresentImageRequest(request, image);
+  PartialMessageWithTlvs message = bench::MakeImageMessage(image, request);
+  vector<SharedByteBuffer> buffers;
+  for (auto _ : state) {
+    buffers.clear();
+    bool ret = codec.EncodeMessage(message, buffers);
+    benchmark::DoNotOptimize(ret);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncodeImageMessage)->Arg(4 * 1024)->Arg(64 * 1024)
+    ->Arg(1024 * 1024);
+
+void BM_EncodeTagAndLength(benchmark::State& state) {
+  MessageCodec codec;
+  Tlv tlv;
+  tlv.tag = proto::PresentImageRequest::kDataFieldNumber;
+  tlv.length = 1024 * 1024;
+  tlv.value = nullptr;
+  for (auto _ : state) {
+    SharedByteBuffer buffer = codec.EncodeTagAndLength(tlv);
+    benchmark::DoNotOptimize(buffer.Get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeTagAndLength);
+
+// encodes the fields of an image message with many detection results,
+// arguments: compression type, number of detection results
+void BM_EncodeCompressedMessage(benchmark::State& state) {
+  CompressionParam param;
+  param.type = static_cast<CompressionType>(state.range(0));
+  if (!compression::IsSupported(param.type)) {
+    state.SkipWithError("Compression is not built in");
+    return;
+  }
+
+  MessageCodec codec;
+  codec.SetCompression(param);
+  string data(64 * 1024, 'x');
+  ImageFrame image = bench::MakeImage(data, state.range(1));
+  proto::PresentImageRequest request;
+  PresenterMessageHelper::InitPresentImageRequest(request, image);
+  PartialMessageWithTlvs message = bench::MakeImageMessage(image, request);
+  vector<SharedByteBuffer> buffers;
+  for (auto _ : state) {
+    buffers.clear();
+    bool ret = codec.EncodeMessage(message, buffers);
+    benchmark::DoNotOptimize(ret);
+  }
+  state.SetBytesProcessed(
+      state.iterations() * static_cast<int64_t>(request.ByteSizeLong()));
+  // size of the encoded header and fields, smaller if compressed
+  state.counters["fields_bytes"] = buffers.empty() ? 0 : buffers[0].Size();
+}
+BENCHMARK(BM_EncodeCompressedMessage)->Args({0, 500})->Args({1, 500})
+    ->Args({2, 500});
+
+// argument: number of detection results
+void BM_DecodeMessage(benchmark::State& state) {
+  MessageCodec codec;
+  string data(64 * 1024, 'x');
+  ImageFrame image = bench::MakeImage(data, state.range(0));
+  proto::PresentImageRequest request;
+  PresenterMessageHelper::InitPresentImageRequest(request, image);
+  request.set_data(data);
+  SharedByteBuffer buffer = codec.EncodeMessage(request);
+  if (buffer.IsEmpty()) {
+    state.SkipWithError("Failed to encode message");
+    return;
+  }
+
+  for (auto _ : state) {
+    unique_ptr<Message> message(codec.DecodeMessage(
+        buffer.Get() + MessageCodec::kPacketLengthSize,
+        buffer.Size() - MessageCodec::kPacketLengthSize));
+    benchmark::DoNotOptimize(message.get());
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.Size());
+}
+BENCHMARK(BM_DecodeMessage)->Arg(0)->Arg(10)->Arg(500);
+
+}
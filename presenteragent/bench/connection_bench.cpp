@@ -0,0 +1,178 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "ascenddk/presenter/agent/codec/message_codec.h"
+#include "ascenddk/presenter/agent/connection/connection.h"
+#include "ascenddk/presenter/agent/net/raw_socket_factory.h"
+#include "ascenddk/presenter/agent/presenter/presenter_message_helper.h"
+#include "bench/bench_util.h"
+
+using namespace std;
+using namespace ascend::presenter;
+using google::protobuf::Message;
+
+namespace {
+
+/**
+ * In-process server on loopback, it answers every received message with
+ * a PresentImageResponse, like presenter server does
+ */
+class EchoServer {
+ public:
+  // the server lives until the process exits
+  static EchoServer& Instance() {
+    static EchoServer server;
+    return server;
+  }
+
+  uint16_t GetPort() const {
+    return port_;
+  }
+
+ private:
+  EchoServer() {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (listen_fd_ < 0
+        || bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), len) != 0
+        || listen(listen_fd_, 1) != 0
+        || getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr),
+                       &len) != 0) {
+      return;
+    }
+
+    proto::PresentImageResponse response;
+    response.set_error_code(proto::kPresentDataErrorNone);
+    response_ = MessageCodec().EncodeMessage(response);
+    port_ = ntohs(addr.sin_port);
+    thread(&EchoServer::Run, this).detach();
+  }
+
+  bool RecvAll(int fd, char* buf, uint32_t size) {
+    while (size > 0) {
+      ssize_t n = recv(fd, buf, size, 0);
+      if (n <= 0) {
+        return false;
+      }
+      buf += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  void Serve(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    vector<char> buf(MessageCodec::kMaxPacketSize);
+    uint32_t total_size = 0;
+    while (RecvAll(fd, reinterpret_cast<char*>(&total_size),
+                   sizeof(total_size))) {
+      total_size = ntohl(total_size);
+      if (total_size <= MessageCodec::kPacketLengthSize
+          || !RecvAll(fd, buf.data(),
+                      total_size - MessageCodec::kPacketLengthSize)
+          || send(fd, response_.Get(), response_.Size(), MSG_NOSIGNAL)
+              != static_cast<ssize_t>(response_.Size())) {
+        break;
+      }
+    }
+    close(fd);
+  }
+
+  void Run() {
+    while (true) {
+      int fd = accept(listen_fd_, nullptr, nullptr);
+      if (fd >= 0) {
+        Serve(fd);
+      }
+    }
+  }
+
+  int listen_fd_ = -1;
+  uint16_t port_ = 0;
+  SharedByteBuffer response_;
+};
+
+// sends an image and waits for the response, the way DefaultChannel does,
+// argument: size of image data
+void BM_ConnectionLoopback(benchmark::State& state) {
+  uint16_t port = EchoServer::Instance().GetPort();
+  RawSocketFactory factory("127.0.0.1", port);
+  Socket* sock = port == 0 ? nullptr : factory.Create();
+  unique_ptr<Connection> conn(sock == nullptr ? nullptr
+                                              : Connection::New(sock));
+  if (conn == nullptr) {
+    state.SkipWithError("Failed to connect to echo server");
+    return;
+  }
+
+  string data(state.range(0), 'x');
+  ImageFrame image = bench::MakeImage(data, 10);
+  proto::PresentImageRequest request;
+  PresenterMessageHelper::InitPresentImageRequest(request, image);
+  PartialMessageWithTlvs message = bench::MakeImageMessage(image, request);
+  for (auto _ : state) {
+    PresenterErrorCode ret = conn->SendMessage(message);
+    unique_ptr<Message> response;
+    if (ret == PresenterErrorCode::kNone) {
+      ret = conn->ReceiveMessage(response);
+    }
+    if (ret != PresenterErrorCode::kNone) {
+      state.SkipWithError("Failed to send message");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConnectionLoopback)->Arg(4 * 1024)->Arg(64 * 1024)
+    ->Arg(1024 * 1024)->UseRealTime();
+
+}
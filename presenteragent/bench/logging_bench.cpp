@@ -0,0 +1,82 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "ascenddk/presenter/agent/util/logging.h"
+#include "proto/presenter_message.pb.h"
+
+using namespace std;
+using namespace ascend::presenter;
+
+namespace {
+
+// the message logged by the send path of a channel
+const proto::PresentImageRequest& GetMessage() {
+  static proto::PresentImageRequest request;
+  return request;
+}
+
+// debug log of a frame with debug disabled, name copied before the check
+void BM_LogDebugOffEager(benchmark::State& state) {
+  logging::SetLevel(AGENT_LOG_LEVEL_INFO);
+  const proto::PresentImageRequest& message = GetMessage();
+  for (auto _ : state) {
+    string msg_name = message.GetDescriptor()->full_name();
+    AGENT_LOG_DEBUG("To send message: %s", msg_name.c_str());
+  }
+}
+BENCHMARK(BM_LogDebugOffEager);
+
+// debug log of a frame with debug disabled, arguments are not evaluated
+void BM_LogDebugOffLazy(benchmark::State& state) {
+  logging::SetLevel(AGENT_LOG_LEVEL_INFO);
+  const proto::PresentImageRequest& message = GetMessage();
+  for (auto _ : state) {
+    AGENT_LOG_DEBUG("To send message: %s",
+                    message.GetDescriptor()->full_name().c_str());
+  }
+}
+BENCHMARK(BM_LogDebugOffLazy);
+
+// error log repeating in a reconnect storm, most of them are suppressed
+void BM_LogErrorLimited(benchmark::State& state) {
+  logging::SetLevel(AGENT_LOG_LEVEL_INFO);
+  for (auto _ : state) {
+    AGENT_LOG_ERROR("Failed to connect to server: %s:%d", "127.0.0.1", 7006);
+  }
+}
+BENCHMARK(BM_LogErrorLimited);
+
+}
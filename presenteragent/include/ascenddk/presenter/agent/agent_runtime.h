@@ -0,0 +1,62 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_AGENT_RUNTIME_H_
+#define ASCENDDK_PRESENTER_AGENT_AGENT_RUNTIME_H_
+
+#include "ascenddk/presenter/agent/errors.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * @brief Start the shared I/O runtime. Channels opened afterwards are served
+ *        by io_thread_num epoll threads instead of a blocking socket and a
+ *        heartbeat thread per channel. Channels opened before are not
+ *        affected
+ * @param [in] io_thread_num  number of I/O threads, 1 ~ 16
+ * @return PresenterErrorCode
+ */
+PresenterErrorCode StartAgentRuntime(int io_thread_num);
+
+/**
+ * @brief Stop the shared I/O runtime. Channels opened afterwards are
+ *        default blocking channels. Each I/O thread exits once all channels
+ *        it serves are deleted
+ */
+void StopAgentRuntime();
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_AGENT_RUNTIME_H_ */
@@ -36,10 +36,12 @@
 
 #include <string>
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <memory>
 
 #include "ascenddk/presenter/agent/errors.h"
+#include "ascenddk/presenter/agent/presenter_types.h"
 
 namespace google {
 namespace protobuf {
@@ -68,6 +70,13 @@ struct PartialMessageWithTlvs {
   std::vector<Tlv> tlv_list;
 };
 
+/**
+ * Invoked when an asynchronously sent message completes. response is NULL
+ * unless error_code is kNone and the message expects a response
+ */
+typedef std::function<void(PresenterErrorCode error_code,
+    std::unique_ptr<google::protobuf::Message>& response)> ResponseCallback;
+
 /**
  * Deal with channel initialization
  */
@@ -88,6 +97,13 @@ class InitChannelHandler {
    * @return check result
    */
   virtual bool CheckInitResponse(const google::protobuf::Message& response) = 0;
+
+  /**
+   * @brief Get the compression accepted by the server, valid after
+   *        CheckInitResponse() succeeded
+   * @return compression of the messages, none by default
+   */
+  virtual CompressionParam GetCompression() const;
 };
 
 /**
@@ -148,6 +164,18 @@ class Channel {
   virtual PresenterErrorCode ReceiveMessage(
       std::unique_ptr<google::protobuf::Message>& response) = 0;
 
+  /**
+   * @brief send message to server and read the response without blocking
+   *        the caller, the message and TLV values can be released once
+   *        this returns. The default implementation sends synchronously
+   * @param [in] message              message
+   * @param [in] callback             invoked with the response once, only
+   *                                  if kNone is returned
+   * @return PresenterErrorCode
+   */
+  virtual PresenterErrorCode SendMessageAsync(
+      const PartialMessageWithTlvs& message, const ResponseCallback& callback);
+
   /**
    * @brief Get the description of the channel, can be used for logging
    * @return description
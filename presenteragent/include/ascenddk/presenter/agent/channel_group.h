@@ -0,0 +1,94 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_CHANNEL_GROUP_H_
+#define ASCENDDK_PRESENTER_AGENT_CHANNEL_GROUP_H_
+
+#include <memory>
+#include <vector>
+
+#include "ascenddk/presenter/agent/channel.h"
+#include "ascenddk/presenter/agent/errors.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * A group of channels which receive the same messages, e.g. a local and
+ * a remote presenter server showing the same stream. A message is encoded
+ * once and the encoded buffers are shared by all members. Members opened
+ * after StartAgentRuntime() are sent in parallel by the I/O threads, the
+ * others are sent one by one in caller's thread meanwhile
+ */
+class ChannelGroup {
+ public:
+  ChannelGroup() = default;
+  ~ChannelGroup() = default;
+
+  /**
+   * @brief add a member, the channel is not owned by the group, it must
+   *        not be deleted before the group
+   * @param [in] channel              channel, can not be NULL
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode AddChannel(Channel *channel);
+
+  /**
+   * @brief get members, in adding order
+   * @return members
+   */
+  const std::vector<Channel*>& GetChannels() const;
+
+  /**
+   * @brief send message to all members and read their responses, a failed
+   *        member does not affect the others
+   * @param [in] message              message
+   * @param [out] responses           response of each member, in adding
+   *                                  order, NULL if the member failed
+   * @param [out] results             result of each member, in adding order
+   * @return kNone if all members succeeded, otherwise the error of the
+   *         first failed member
+   */
+  PresenterErrorCode SendMessage(
+      const PartialMessageWithTlvs& message,
+      std::vector<std::unique_ptr<google::protobuf::Message>>& responses,
+      std::vector<PresenterErrorCode>& results);
+
+ private:
+  std::vector<Channel*> channels_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_CHANNEL_GROUP_H_ */
@@ -34,7 +34,12 @@
 #ifndef ASCENDDK_PRESENTER_AGENT_PRESENTER_CHANNEL_H_
 #define ASCENDDK_PRESENTER_AGENT_PRESENTER_CHANNEL_H_
 
+#include <functional>
+#include <vector>
+
+#include "ascenddk/presenter/agent/agent_runtime.h"
 #include "ascenddk/presenter/agent/channel.h"
+#include "ascenddk/presenter/agent/channel_group.h"
 #include "ascenddk/presenter/agent/errors.h"
 #include "ascenddk/presenter/agent/presenter_types.h"
 
@@ -46,7 +51,11 @@ namespace presenter {
  * @param [out] channel       channel must be a NULL pointer,
  *                            and it will point to an opened channel if
  *                            open successfully
- * @param [in]  param         parameters for opening a channel
+ * @param [in]  param         parameters for opening a channel. If
+ *                            endpoints is set, the channel is opened on
+ *                            the server chosen by consistent hashing of
+ *                            channel_name, and on the next server of the
+ *                            hash ring if connecting fails
  * @return PresenterErrorCode
  */
 //presenter agent ṩĴͨӿ
@@ -54,13 +63,74 @@ PresenterErrorCode OpenChannel(Channel *&channel,
                                const OpenChannelParam &param);
 
 /**
- * @brief Send the image to server for display through the given channel
+ * @brief Send the image to server for display through the given channel.
+ *        Images larger than 8MB, up to 128MB, are sent in chunks of 1MB,
+ *        other messages of the channel can be sent between the chunks
  * @param [in] channel        the channel to send the image with
  * @param [in] image          the image to display
  * @return PresenterErrorCode
  */
 PresenterErrorCode PresentImage(Channel *channel, const ImageFrame &image);
 
+/**
+ * @brief Send several images to server for display in one message, the
+ *        server acknowledges the whole batch with one response. It suits
+ *        small images at high frame rate, where the per-message cost
+ *        dominates. The encoded batch must not exceed 10MB
+ * @param [in] channel        the channel to send the images with
+ * @param [in] images         the images to display, in display order
+ * @return PresenterErrorCode
+ */
+PresenterErrorCode PresentImages(Channel *channel,
+                                 const std::vector<ImageFrame> &images);
+
+/**
+ * @brief Send crops of the detected objects to server for display instead
+ *        of the full frame, optionally with a low-res full frame which the
+ *        server shows behind the crops. The whole message is limited to 10MB
+ * @param [in] channel        the channel to send the crops with
+ * @param [in] frame          the crops to display
+ * @return PresenterErrorCode
+ */
+PresenterErrorCode PresentRois(Channel *channel, const RoiFrame &frame);
+
+/**
+ * @brief Send the image to all channels of the group for display, the
+ *        image is encoded once for all of them. Large images are chunked
+ *        as in PresentImage(), a channel failing a chunk is not sent the
+ *        rest of them
+ * @param [in] group          the channels to send the image with
+ * @param [in] image          the image to display
+ * @param [out] results       result of each channel, in adding order
+ * @return kNone if all channels succeeded, otherwise the error of the first
+ *         failed channel
+ */
+PresenterErrorCode PresentImage(ChannelGroup &group, const ImageFrame &image,
+                                std::vector<PresenterErrorCode> &results);
+
+/**
+ * Invoked with the result of PresentImageAsync()
+ */
+typedef std::function<void(PresenterErrorCode error_code)> PresentImageCallback;
+
+/**
+ * @brief Send the image to server for display without waiting for the
+ *        response. The image is copied, so it can be released once this
+ *        returns. Large images are chunked as in PresentImage(), all the
+ *        chunks but the last one are sent before this returns, only the
+ *        last one is copied. If the channel is opened after
+ *        StartAgentRuntime(), the callback runs in the I/O thread, it must
+ *        not block or delete the channel; otherwise the image is sent
+ *        synchronously
+ * @param [in] channel        the channel to send the image with
+ * @param [in] image          the image to display
+ * @param [in] callback       invoked with the result, only if kNone is
+ *                            returned, can be NULL
+ * @return PresenterErrorCode
+ */
+PresenterErrorCode PresentImageAsync(Channel *channel, const ImageFrame &image,
+                                     const PresentImageCallback &callback);
+
 /**
  * @brief Send the image message to server for display through the given channel
  * @param [in] channel        the channel to send the image with
@@ -0,0 +1,135 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_PRESENTER_COROUTINE_H_
+#define ASCENDDK_PRESENTER_AGENT_PRESENTER_COROUTINE_H_
+
+#if __cplusplus < 202002L
+#error "presenter_coroutine.h requires C++20, build with -std=c++20"
+#endif
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+
+#include "ascenddk/presenter/agent/presenter_channel.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Awaitable for presenting an image in a C++20 coroutine
+ *
+ *   PresenterErrorCode error_code =
+ *       co_await PresentImageAwaitable(channel, image);
+ *
+ * It is built on PresentImageAsync(): the coroutine is suspended while the
+ * I/O thread of the agent runtime writes the image and waits for the
+ * response, then resumed with the result. The channel should be opened
+ * after StartAgentRuntime(), otherwise the image is sent synchronously
+ * before suspending.
+ *
+ * By default the coroutine is resumed in the I/O thread, so it must not
+ * block there. Pass a resumer to move it to the executor of the app, e.g.
+ *   [&pool](std::coroutine_handle<> h) { pool.Post([h]() { h.resume(); }); }
+ */
+class PresentImageAwaitable {
+ public:
+  typedef std::function<void(std::coroutine_handle<>)> Resumer;
+
+  /**
+   * @param [in] channel        the channel to send the image with
+   * @param [in] image          the image to display, copied when suspending
+   * @param [in] resumer        resumes the coroutine, can be NULL
+   */
+  PresentImageAwaitable(Channel *channel, const ImageFrame &image,
+                        Resumer resumer = nullptr)
+      : channel_(channel),
+        image_(image),
+        resumer_(std::move(resumer)),
+        error_code_(PresenterErrorCode::kOther),
+        completed_(false) {
+  }
+
+  // the callback refers to this object
+  PresentImageAwaitable(const PresentImageAwaitable&) = delete;
+  PresentImageAwaitable& operator=(const PresentImageAwaitable&) = delete;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    PresenterErrorCode error_code = PresentImageAsync(
+        channel_, image_, [this](PresenterErrorCode code) {
+          error_code_ = code;
+          // whoever comes second resumes the coroutine
+          if (completed_.exchange(true)) {
+            Resume();
+          }
+        });
+    if (error_code != PresenterErrorCode::kNone) {
+      error_code_ = error_code;
+      return false;
+    }
+
+    // do not suspend if the response already arrived
+    return !completed_.exchange(true);
+  }
+
+  PresenterErrorCode await_resume() const noexcept {
+    return error_code_;
+  }
+
+ private:
+  void Resume() {
+    if (resumer_) {
+      resumer_(handle_);
+    } else {
+      handle_.resume();
+    }
+  }
+
+  Channel *channel_;
+  ImageFrame image_;
+  Resumer resumer_;
+  std::coroutine_handle<> handle_;
+  PresenterErrorCode error_code_;
+  std::atomic_bool completed_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_PRESENTER_COROUTINE_H_ */
@@ -65,6 +65,39 @@ enum class ImageFormat {
   kReserved = 127,
 };
 
+/**
+ * CompressionType
+ */
+enum class CompressionType {
+  // No compression
+  kNone = 0,
+
+  // LZ4, fast
+  kLz4 = 1,
+
+  // zstd, better ratio
+  kZstd = 2,
+};
+
+/**
+ * CompressionParam. The protobuf fields of a message, e.g. the detection
+ * results, are compressed if they take threshold bytes or more, and the
+ * server accepts the type. Image data is sent as is, JPEG does not compress
+ * further
+ */
+struct CompressionParam {
+  CompressionType type = CompressionType::kNone;
+  std::uint32_t threshold = 1024;
+};
+
+/**
+ * ServerEndpoint, address of a presenter server
+ */
+struct ServerEndpoint {
+  std::string host_ip;
+  std::uint16_t port;
+};
+
 /**
  * OpenChannelParam
  */
@@ -73,6 +106,11 @@ struct OpenChannelParam {
   std::uint16_t port;
   std::string channel_name;
   ContentType content_type;
+  // Servers of a cluster. If not empty, host_ip and port are ignored, the
+  // server is chosen by consistent hashing of channel_name
+  std::vector<ServerEndpoint> endpoints;
+  // compression of the messages, only used if the agent is built with it
+  CompressionParam compression;
 };
 
 struct Point {
@@ -97,6 +135,27 @@ struct ImageFrame {
   std::vector<DetectionResult> detection_results;
 };
 
+/**
+ * RoiCrop, image of a detected object
+ */
+struct RoiCrop {
+  DetectionResult region;   //Region of the crop in the full frame
+  std::uint32_t size;
+  unsigned char *data;
+};
+
+/**
+ * RoiFrame, crops of the detected objects in a frame
+ */
+struct RoiFrame {
+  ImageFormat format;
+  std::uint32_t width;    //Width of the full frame
+  std::uint32_t height;   //Height of the full frame
+  std::uint32_t size;     //Size of the low-res full frame, 0 if not sent
+  unsigned char *data;    //Low-res full frame, stretched to width x height
+  std::vector<RoiCrop> crops;
+};
+
 } /* namespace presenter */
 } /* namespace ascend */
 
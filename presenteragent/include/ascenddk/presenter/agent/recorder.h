@@ -0,0 +1,127 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_RECORDER_H_
+#define ASCENDDK_PRESENTER_AGENT_RECORDER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ascenddk/presenter/agent/channel.h"
+#include "ascenddk/presenter/agent/errors.h"
+#include "ascenddk/presenter/agent/presenter_types.h"
+
+namespace ascend {
+namespace presenter {
+
+class SegmentLogWriter;
+
+/**
+ * RecorderParam
+ */
+struct RecorderParam {
+  std::string dir;              //Directory of segment files, must exist
+  std::uint32_t segment_size;   //Size of each segment file, 64KB ~ 1GB
+  std::uint32_t max_segments;   //The oldest segment is removed when exceeded
+};
+
+/**
+ * ReplayMode
+ */
+enum class ReplayMode {
+  // send the next frame once the previous one is acknowledged
+  kMaxSpeed = 0,
+
+  // keep the intervals between frames as they were recorded
+  kOriginalTiming = 1,
+};
+
+/**
+ * Records images to memory-mapped segment files on local disk, e.g. when
+ * PresentImage() returns kConnection, so that they can be replayed by
+ * ReplayRecording() once the server is reachable again. Images are stored
+ * as the exact bytes sent to server. The disk used is at most
+ * segment_size * max_segments, the oldest images are dropped beyond that.
+ * A segment can be replayed once it is sealed: when it is full, Seal() is
+ * called or the recorder is destroyed
+ */
+class Recorder {
+ public:
+  /**
+   * @brief create a recorder, segments already in the directory are kept
+   * @param [in] param          parameters of the recorder
+   * @return recorder, NULL if any of the parameters is invalid
+   */
+  static Recorder* New(const RecorderParam &param);
+
+  ~Recorder();
+
+  /**
+   * @brief record an image, thread safe
+   * @param [in] image          the image to record
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode RecordImage(const ImageFrame &image);
+
+  /**
+   * @brief seal the segment being recorded to, so that all the images
+   *        recorded so far can be replayed, thread safe
+   */
+  void Seal();
+
+ private:
+  Recorder() = default;
+
+  std::unique_ptr<SegmentLogWriter> writer_;
+};
+
+/**
+ * @brief Send the images of the sealed segments in the directory to server
+ *        through the given channel, oldest first, so it can be called while
+ *        a Recorder is recording to the directory. Replayed images are
+ *        removed from disk. Replaying stops at the first image which is
+ *        failed to present, and the next call resumes from it. An image may
+ *        be sent again if the process crashes before it is acknowledged
+ * @param [in] channel        the channel to send the images with
+ * @param [in] dir            directory of the recorder
+ * @param [in] mode           replay mode
+ * @return PresenterErrorCode
+ */
+PresenterErrorCode ReplayRecording(Channel *channel, const std::string &dir,
+                                   ReplayMode mode);
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_RECORDER_H_ */
@@ -57,6 +57,21 @@ class PresentImageResponseDefaultTypeInternal {
   ::google::protobuf::internal::ExplicitlyConstructed<PresentImageResponse>
       _instance;
 } _PresentImageResponse_default_instance_;
+class PresentImageBatchRequestDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<PresentImageBatchRequest>
+      _instance;
+} _PresentImageBatchRequest_default_instance_;
+class PresentRoiRequestDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<PresentRoiRequest>
+      _instance;
+} _PresentRoiRequest_default_instance_;
+class PresentImageChunkDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<PresentImageChunk>
+      _instance;
+} _PresentImageChunk_default_instance_;
 }  // namespace proto
 }  // namespace presenter
 }  // namespace ascend
@@ -210,8 +225,74 @@ void InitDefaultsPresentImageResponse() {
   ::google::protobuf::GoogleOnceInit(&once, &InitDefaultsPresentImageResponseImpl);
 }
 
-::google::protobuf::Metadata file_level_metadata[7];
-const ::google::protobuf::EnumDescriptor* file_level_enum_descriptors[4];
+void InitDefaultsPresentImageBatchRequestImpl() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+#ifdef GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  ::google::protobuf::internal::InitProtobufDefaultsForceUnique();
+#else
+  ::google::protobuf::internal::InitProtobufDefaults();
+#endif  // GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageRequest();
+  {
+    void* ptr = &::ascend::presenter::proto::_PresentImageBatchRequest_default_instance_;
+    new (ptr) ::ascend::presenter::proto::PresentImageBatchRequest();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::ascend::presenter::proto::PresentImageBatchRequest::InitAsDefaultInstance();
+}
+
+void InitDefaultsPresentImageBatchRequest() {
+  static GOOGLE_PROTOBUF_DECLARE_ONCE(once);
+  ::google::protobuf::GoogleOnceInit(&once, &InitDefaultsPresentImageBatchRequestImpl);
+}
+
+void InitDefaultsPresentRoiRequestImpl() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+#ifdef GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  ::google::protobuf::internal::InitProtobufDefaultsForceUnique();
+#else
+  ::google::protobuf::internal::InitProtobufDefaults();
+#endif  // GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  protobuf_presenter_5fmessage_2eproto::InitDefaultsRectangle_Attr();
+  {
+    void* ptr = &::ascend::presenter::proto::_PresentRoiRequest_default_instance_;
+    new (ptr) ::ascend::presenter::proto::PresentRoiRequest();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::ascend::presenter::proto::PresentRoiRequest::InitAsDefaultInstance();
+}
+
+void InitDefaultsPresentRoiRequest() {
+  static GOOGLE_PROTOBUF_DECLARE_ONCE(once);
+  ::google::protobuf::GoogleOnceInit(&once, &InitDefaultsPresentRoiRequestImpl);
+}
+
+void InitDefaultsPresentImageChunkImpl() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+#ifdef GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  ::google::protobuf::internal::InitProtobufDefaultsForceUnique();
+#else
+  ::google::protobuf::internal::InitProtobufDefaults();
+#endif  // GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageRequest();
+  {
+    void* ptr = &::ascend::presenter::proto::_PresentImageChunk_default_instance_;
+    new (ptr) ::ascend::presenter::proto::PresentImageChunk();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::ascend::presenter::proto::PresentImageChunk::InitAsDefaultInstance();
+}
+
+void InitDefaultsPresentImageChunk() {
+  static GOOGLE_PROTOBUF_DECLARE_ONCE(once);
+  ::google::protobuf::GoogleOnceInit(&once, &InitDefaultsPresentImageChunkImpl);
+}
+
+::google::protobuf::Metadata file_level_metadata[10];
+const ::google::protobuf::EnumDescriptor* file_level_enum_descriptors[5];
 
 const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   ~0u,  // no _has_bits_
@@ -221,6 +302,7 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   ~0u,  // no _weak_field_map_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::OpenChannelRequest, channel_name_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::OpenChannelRequest, content_type_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::OpenChannelRequest, compression_),
   ~0u,  // no _has_bits_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::OpenChannelResponse, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -228,6 +310,7 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   ~0u,  // no _weak_field_map_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::OpenChannelResponse, error_code_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::OpenChannelResponse, error_message_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::OpenChannelResponse, compression_),
   ~0u,  // no _has_bits_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::HeartbeatMessage, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -265,15 +348,47 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   ~0u,  // no _weak_field_map_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageResponse, error_code_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageResponse, error_message_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageBatchRequest, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageBatchRequest, image_list_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageBatchRequest, data_list_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentRoiRequest, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentRoiRequest, format_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentRoiRequest, width_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentRoiRequest, height_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentRoiRequest, data_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentRoiRequest, rectangle_list_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentRoiRequest, data_list_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageChunk, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageChunk, frame_id_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageChunk, index_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageChunk, last_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageChunk, total_size_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageChunk, image_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::proto::PresentImageChunk, data_),
 };
 static const ::google::protobuf::internal::MigrationSchema schemas[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::ascend::presenter::proto::OpenChannelRequest)},
-  { 7, -1, sizeof(::ascend::presenter::proto::OpenChannelResponse)},
-  { 14, -1, sizeof(::ascend::presenter::proto::HeartbeatMessage)},
-  { 19, -1, sizeof(::ascend::presenter::proto::Coordinate)},
-  { 26, -1, sizeof(::ascend::presenter::proto::Rectangle_Attr)},
-  { 34, -1, sizeof(::ascend::presenter::proto::PresentImageRequest)},
-  { 44, -1, sizeof(::ascend::presenter::proto::PresentImageResponse)},
+  { 8, -1, sizeof(::ascend::presenter::proto::OpenChannelResponse)},
+  { 16, -1, sizeof(::ascend::presenter::proto::HeartbeatMessage)},
+  { 21, -1, sizeof(::ascend::presenter::proto::Coordinate)},
+  { 28, -1, sizeof(::ascend::presenter::proto::Rectangle_Attr)},
+  { 36, -1, sizeof(::ascend::presenter::proto::PresentImageRequest)},
+  { 46, -1, sizeof(::ascend::presenter::proto::PresentImageResponse)},
+  { 53, -1, sizeof(::ascend::presenter::proto::PresentImageBatchRequest)},
+  { 60, -1, sizeof(::ascend::presenter::proto::PresentRoiRequest)},
+  { 71, -1, sizeof(::ascend::presenter::proto::PresentImageChunk)},
 };
 
 static ::google::protobuf::Message const * const file_default_instances[] = {
@@ -284,6 +399,9 @@ static ::google::protobuf::Message const * const file_default_instances[] = {
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::proto::_Rectangle_Attr_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::proto::_PresentImageRequest_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::proto::_PresentImageResponse_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::proto::_PresentImageBatchRequest_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::proto::_PresentRoiRequest_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::proto::_PresentImageChunk_default_instance_),
 };
 
 void protobuf_AssignDescriptors() {
@@ -302,46 +420,64 @@ void protobuf_AssignDescriptorsOnce() {
 void protobuf_RegisterTypes(const ::std::string&) GOOGLE_PROTOBUF_ATTRIBUTE_COLD;
 void protobuf_RegisterTypes(const ::std::string&) {
   protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 7);
+  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 10);
 }
 
 void AddDescriptorsImpl() {
   InitDefaults();
   static const char descriptor[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
       "\n\027presenter_message.proto\022\026ascend.presen"
-      "ter.proto\"l\n\022OpenChannelRequest\022\024\n\014chann"
-      "el_name\030\001 \001(\t\022@\n\014content_type\030\002 \001(\0162*.as"
-      "cend.presenter.proto.ChannelContentType\""
-      "n\n\023OpenChannelResponse\022@\n\nerror_code\030\001 \001"
-      "(\0162,.ascend.presenter.proto.OpenChannelE"
-      "rrorCode\022\025\n\rerror_message\030\002 \001(\t\"\022\n\020Heart"
-      "beatMessage\"\"\n\nCoordinate\022\t\n\001x\030\001 \001(\r\022\t\n\001"
-      "y\030\002 \001(\r\"\224\001\n\016Rectangle_Attr\0224\n\010left_top\030\001"
-      " \001(\0132\".ascend.presenter.proto.Coordinate"
-      "\0228\n\014right_bottom\030\002 \001(\0132\".ascend.presente"
-      "r.proto.Coordinate\022\022\n\nlabel_text\030\003 \001(\t\"\267"
-      "\001\n\023PresentImageRequest\0223\n\006format\030\001 \001(\0162#"
-      ".ascend.presenter.proto.ImageFormat\022\r\n\005w"
-      "idth\030\002 \001(\r\022\016\n\006height\030\003 \001(\r\022\014\n\004data\030\004 \001(\014"
-      "\022>\n\016rectangle_list\030\005 \003(\0132&.ascend.presen"
-      "ter.proto.Rectangle_Attr\"o\n\024PresentImage"
-      "Response\022@\n\nerror_code\030\001 \001(\0162,.ascend.pr"
-      "esenter.proto.PresentDataErrorCode\022\025\n\rer"
-      "ror_message\030\002 \001(\t*\245\001\n\024OpenChannelErrorCo"
-      "de\022\031\n\025kOpenChannelErrorNone\020\000\022\"\n\036kOpenCh"
-      "annelErrorNoSuchChannel\020\001\022)\n%kOpenChanne"
-      "lErrorChannelAlreadyOpened\020\002\022#\n\026kOpenCha"
-      "nnelErrorOther\020\377\377\377\377\377\377\377\377\377\001*P\n\022ChannelCont"
-      "entType\022\034\n\030kChannelContentTypeImage\020\000\022\034\n"
-      "\030kChannelContentTypeVideo\020\001*#\n\013ImageForm"
-      "at\022\024\n\020kImageFormatJpeg\020\000*\244\001\n\024PresentData"
-      "ErrorCode\022\031\n\025kPresentDataErrorNone\020\000\022$\n "
-      "kPresentDataErrorUnsupportedType\020\001\022&\n\"kP"
-      "resentDataErrorUnsupportedFormat\020\002\022#\n\026kP"
-      "resentDataErrorOther\020\377\377\377\377\377\377\377\377\377\001b\006proto3"
+      "ter.proto\"\252\001\n\022OpenChannelRequest\022\024\n\014chan"
+      "nel_name\030\001 \001(\t\022@\n\014content_type\030\002 \001(\0162*.a"
+      "scend.presenter.proto.ChannelContentType"
+      "\022<\n\013compression\030\003 \001(\0162\'.ascend.presenter"
+      ".proto.CompressionType\"\254\001\n\023OpenChannelRe"
+      "sponse\022@\n\nerror_code\030\001 \001(\0162,.ascend.pres"
+      "enter.proto.OpenChannelErrorCode\022\025\n\rerro"
+      "r_message\030\002 \001(\t\022<\n\013compression\030\003 \001(\0162\'.a"
+      "scend.presenter.proto.CompressionType\"\022\n"
+      "\020HeartbeatMessage\"\"\n\nCoordinate\022\t\n\001x\030\001 \001"
+      "(\r\022\t\n\001y\030\002 \001(\r\"\224\001\n\016Rectangle_Attr\0224\n\010left"
+      "_top\030\001 \001(\0132\".ascend.presenter.proto.Coor"
+      "dinate\0228\n\014right_bottom\030\002 \001(\0132\".ascend.pr"
+      "esenter.proto.Coordinate\022\022\n\nlabel_text\030\003"
+      " \001(\t\"\267\001\n\023PresentImageRequest\0223\n\006format\030\001"
+      " \001(\0162#.ascend.presenter.proto.ImageForma"
+      "t\022\r\n\005width\030\002 \001(\r\022\016\n\006height\030\003 \001(\r\022\014\n\004data"
+      "\030\004 \001(\014\022>\n\016rectangle_list\030\005 \003(\0132&.ascend."
+      "presenter.proto.Rectangle_Attr\"o\n\024Presen"
+      "tImageResponse\022@\n\nerror_code\030\001 \001(\0162,.asc"
+      "end.presenter.proto.PresentDataErrorCode"
+      "\022\025\n\rerror_message\030\002 \001(\t\"n\n\030PresentImageB"
+      "atchRequest\022?\n\nimage_list\030\001 \003(\0132+.ascend"
+      ".presenter.proto.PresentImageRequest\022\021\n\t"
+      "data_list\030\002 \003(\014\"\310\001\n\021PresentRoiRequest\0223\n"
+      "\006format\030\001 \001(\0162#.ascend.presenter.proto.I"
+      "mageFormat\022\r\n\005width\030\002 \001(\r\022\016\n\006height\030\003 \001("
+      "\r\022\014\n\004data\030\004 \001(\014\022>\n\016rectangle_list\030\005 \003(\0132"
+      "&.ascend.presenter.proto.Rectangle_Attr\022"
+      "\021\n\tdata_list\030\006 \003(\014\"\240\001\n\021PresentImageChunk"
+      "\022\020\n\010frame_id\030\001 \001(\r\022\r\n\005index\030\002 \001(\r\022\014\n\004las"
+      "t\030\003 \001(\010\022\022\n\ntotal_size\030\004 \001(\r\022:\n\005image\030\005 \001"
+      "(\0132+.ascend.presenter.proto.PresentImage"
+      "Request\022\014\n\004data\030\006 \001(\014*\245\001\n\024OpenChannelErr"
+      "orCode\022\031\n\025kOpenChannelErrorNone\020\000\022\"\n\036kOp"
+      "enChannelErrorNoSuchChannel\020\001\022)\n%kOpenCh"
+      "annelErrorChannelAlreadyOpened\020\002\022#\n\026kOpe"
+      "nChannelErrorOther\020\377\377\377\377\377\377\377\377\377\001*P\n\022Channel"
+      "ContentType\022\034\n\030kChannelContentTypeImage\020"
+      "\000\022\034\n\030kChannelContentTypeVideo\020\001*R\n\017Compr"
+      "essionType\022\024\n\020kCompressionNone\020\000\022\023\n\017kCom"
+      "pressionLz4\020\001\022\024\n\020kCompressionZstd\020\002*#\n\013I"
+      "mageFormat\022\024\n\020kImageFormatJpeg\020\000*\244\001\n\024Pre"
+      "sentDataErrorCode\022\031\n\025kPresentDataErrorNo"
+      "ne\020\000\022$\n kPresentDataErrorUnsupportedType"
+      "\020\001\022&\n\"kPresentDataErrorUnsupportedFormat"
+      "\020\002\022#\n\026kPresentDataErrorOther\020\377\377\377\377\377\377\377\377\377\001b"
+      "\006proto3"
   };
   ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-      descriptor, 1239);
+      descriptor, 1927);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "presenter_message.proto", &protobuf_RegisterTypes);
 }
@@ -390,10 +526,25 @@ bool ChannelContentType_IsValid(int value) {
   }
 }
 
-const ::google::protobuf::EnumDescriptor* ImageFormat_descriptor() {
+const ::google::protobuf::EnumDescriptor* CompressionType_descriptor() {
   protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
   return protobuf_presenter_5fmessage_2eproto::file_level_enum_descriptors[2];
 }
+bool CompressionType_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+    case 2:
+      return true;
+    default:
+      return false;
+  }
+}
+
+const ::google::protobuf::EnumDescriptor* ImageFormat_descriptor() {
+  protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return protobuf_presenter_5fmessage_2eproto::file_level_enum_descriptors[3];
+}
 bool ImageFormat_IsValid(int value) {
   switch (value) {
     case 0:
@@ -405,7 +556,7 @@ bool ImageFormat_IsValid(int value) {
 
 const ::google::protobuf::EnumDescriptor* PresentDataErrorCode_descriptor() {
   protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
-  return protobuf_presenter_5fmessage_2eproto::file_level_enum_descriptors[3];
+  return protobuf_presenter_5fmessage_2eproto::file_level_enum_descriptors[4];
 }
 bool PresentDataErrorCode_IsValid(int value) {
   switch (value) {
@@ -427,6 +578,7 @@ void OpenChannelRequest::InitAsDefaultInstance() {
 #if !defined(_MSC_VER) || _MSC_VER >= 1900
 const int OpenChannelRequest::kChannelNameFieldNumber;
 const int OpenChannelRequest::kContentTypeFieldNumber;
+const int OpenChannelRequest::kCompressionFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 OpenChannelRequest::OpenChannelRequest()
@@ -446,13 +598,17 @@ OpenChannelRequest::OpenChannelRequest(const OpenChannelRequest& from)
   if (from.channel_name().size() > 0) {
     channel_name_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.channel_name_);
   }
-  content_type_ = from.content_type_;
+  ::memcpy(&content_type_, &from.content_type_,
+    static_cast<size_t>(reinterpret_cast<char*>(&compression_) -
+    reinterpret_cast<char*>(&content_type_)) + sizeof(compression_));
   // @@protoc_insertion_point(copy_constructor:ascend.presenter.proto.OpenChannelRequest)
 }
 
 void OpenChannelRequest::SharedCtor() {
   channel_name_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  content_type_ = 0;
+  ::memset(&content_type_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&compression_) -
+      reinterpret_cast<char*>(&content_type_)) + sizeof(compression_));
   _cached_size_ = 0;
 }
 
@@ -495,7 +651,9 @@ void OpenChannelRequest::Clear() {
   (void) cached_has_bits;
 
   channel_name_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  content_type_ = 0;
+  ::memset(&content_type_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&compression_) -
+      reinterpret_cast<char*>(&content_type_)) + sizeof(compression_));
   _internal_metadata_.Clear();
 }
 
@@ -540,6 +698,21 @@ bool OpenChannelRequest::MergePartialFromCodedStream(
         break;
       }
 
+      // .ascend.presenter.proto.CompressionType compression = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(24u /* 24 & 0xFF */)) {
+          int value;
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
+                 input, &value)));
+          set_compression(static_cast< ::ascend::presenter::proto::CompressionType >(value));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -582,6 +755,12 @@ void OpenChannelRequest::SerializeWithCachedSizes(
       2, this->content_type(), output);
   }
 
+  // .ascend.presenter.proto.CompressionType compression = 3;
+  if (this->compression() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteEnum(
+      3, this->compression(), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -613,6 +792,12 @@ void OpenChannelRequest::SerializeWithCachedSizes(
       2, this->content_type(), target);
   }
 
+  // .ascend.presenter.proto.CompressionType compression = 3;
+  if (this->compression() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
+      3, this->compression(), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -643,6 +828,12 @@ size_t OpenChannelRequest::ByteSizeLong() const {
       ::google::protobuf::internal::WireFormatLite::EnumSize(this->content_type());
   }
 
+  // .ascend.presenter.proto.CompressionType compression = 3;
+  if (this->compression() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::EnumSize(this->compression());
+  }
+
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = cached_size;
@@ -679,6 +870,9 @@ void OpenChannelRequest::MergeFrom(const OpenChannelRequest& from) {
   if (from.content_type() != 0) {
     set_content_type(from.content_type());
   }
+  if (from.compression() != 0) {
+    set_compression(from.compression());
+  }
 }
 
 void OpenChannelRequest::CopyFrom(const ::google::protobuf::Message& from) {
@@ -707,6 +901,7 @@ void OpenChannelRequest::InternalSwap(OpenChannelRequest* other) {
   using std::swap;
   channel_name_.Swap(&other->channel_name_);
   swap(content_type_, other->content_type_);
+  swap(compression_, other->compression_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   swap(_cached_size_, other->_cached_size_);
 }
@@ -724,6 +919,7 @@ void OpenChannelResponse::InitAsDefaultInstance() {
 #if !defined(_MSC_VER) || _MSC_VER >= 1900
 const int OpenChannelResponse::kErrorCodeFieldNumber;
 const int OpenChannelResponse::kErrorMessageFieldNumber;
+const int OpenChannelResponse::kCompressionFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 OpenChannelResponse::OpenChannelResponse()
@@ -743,13 +939,17 @@ OpenChannelResponse::OpenChannelResponse(const OpenChannelResponse& from)
   if (from.error_message().size() > 0) {
     error_message_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.error_message_);
   }
-  error_code_ = from.error_code_;
+  ::memcpy(&error_code_, &from.error_code_,
+    static_cast<size_t>(reinterpret_cast<char*>(&compression_) -
+    reinterpret_cast<char*>(&error_code_)) + sizeof(compression_));
   // @@protoc_insertion_point(copy_constructor:ascend.presenter.proto.OpenChannelResponse)
 }
 
 void OpenChannelResponse::SharedCtor() {
   error_message_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  error_code_ = 0;
+  ::memset(&error_code_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&compression_) -
+      reinterpret_cast<char*>(&error_code_)) + sizeof(compression_));
   _cached_size_ = 0;
 }
 
@@ -792,7 +992,9 @@ void OpenChannelResponse::Clear() {
   (void) cached_has_bits;
 
   error_message_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  error_code_ = 0;
+  ::memset(&error_code_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&compression_) -
+      reinterpret_cast<char*>(&error_code_)) + sizeof(compression_));
   _internal_metadata_.Clear();
 }
 
@@ -837,6 +1039,21 @@ bool OpenChannelResponse::MergePartialFromCodedStream(
         break;
       }
 
+      // .ascend.presenter.proto.CompressionType compression = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(24u /* 24 & 0xFF */)) {
+          int value;
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
+                 input, &value)));
+          set_compression(static_cast< ::ascend::presenter::proto::CompressionType >(value));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -879,6 +1096,12 @@ void OpenChannelResponse::SerializeWithCachedSizes(
       2, this->error_message(), output);
   }
 
+  // .ascend.presenter.proto.CompressionType compression = 3;
+  if (this->compression() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteEnum(
+      3, this->compression(), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -910,6 +1133,12 @@ void OpenChannelResponse::SerializeWithCachedSizes(
         2, this->error_message(), target);
   }
 
+  // .ascend.presenter.proto.CompressionType compression = 3;
+  if (this->compression() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
+      3, this->compression(), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -940,6 +1169,12 @@ size_t OpenChannelResponse::ByteSizeLong() const {
       ::google::protobuf::internal::WireFormatLite::EnumSize(this->error_code());
   }
 
+  // .ascend.presenter.proto.CompressionType compression = 3;
+  if (this->compression() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::EnumSize(this->compression());
+  }
+
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = cached_size;
@@ -976,6 +1211,9 @@ void OpenChannelResponse::MergeFrom(const OpenChannelResponse& from) {
   if (from.error_code() != 0) {
     set_error_code(from.error_code());
   }
+  if (from.compression() != 0) {
+    set_compression(from.compression());
+  }
 }
 
 void OpenChannelResponse::CopyFrom(const ::google::protobuf::Message& from) {
@@ -1004,6 +1242,7 @@ void OpenChannelResponse::InternalSwap(OpenChannelResponse* other) {
   using std::swap;
   error_message_.Swap(&other->error_message_);
   swap(error_code_, other->error_code_);
+  swap(compression_, other->compression_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   swap(_cached_size_, other->_cached_size_);
 }
@@ -2547,6 +2786,1170 @@ void PresentImageResponse::InternalSwap(PresentImageResponse* other) {
 }
 
 
+// ===================================================================
+
+void PresentImageBatchRequest::InitAsDefaultInstance() {
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int PresentImageBatchRequest::kImageListFieldNumber;
+const int PresentImageBatchRequest::kDataListFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+PresentImageBatchRequest::PresentImageBatchRequest()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  if (GOOGLE_PREDICT_TRUE(this != internal_default_instance())) {
+    ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageBatchRequest();
+  }
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:ascend.presenter.proto.PresentImageBatchRequest)
+}
+PresentImageBatchRequest::PresentImageBatchRequest(const PresentImageBatchRequest& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      image_list_(from.image_list_),
+      data_list_(from.data_list_),
+      _cached_size_(0) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:ascend.presenter.proto.PresentImageBatchRequest)
+}
+
+void PresentImageBatchRequest::SharedCtor() {
+  _cached_size_ = 0;
+}
+
+PresentImageBatchRequest::~PresentImageBatchRequest() {
+  // @@protoc_insertion_point(destructor:ascend.presenter.proto.PresentImageBatchRequest)
+  SharedDtor();
+}
+
+void PresentImageBatchRequest::SharedDtor() {
+}
+
+void PresentImageBatchRequest::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* PresentImageBatchRequest::descriptor() {
+  ::protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_presenter_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const PresentImageBatchRequest& PresentImageBatchRequest::default_instance() {
+  ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageBatchRequest();
+  return *internal_default_instance();
+}
+
+PresentImageBatchRequest* PresentImageBatchRequest::New(::google::protobuf::Arena* arena) const {
+  PresentImageBatchRequest* n = new PresentImageBatchRequest;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void PresentImageBatchRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:ascend.presenter.proto.PresentImageBatchRequest)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  image_list_.Clear();
+  data_list_.Clear();
+  _internal_metadata_.Clear();
+}
+
+bool PresentImageBatchRequest::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:ascend.presenter.proto.PresentImageBatchRequest)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // repeated .ascend.presenter.proto.PresentImageRequest image_list = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(10u /* 10 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(input, add_image_list()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated bytes data_list = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(18u /* 18 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_data_list()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:ascend.presenter.proto.PresentImageBatchRequest)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:ascend.presenter.proto.PresentImageBatchRequest)
+  return false;
+#undef DO_
+}
+
+void PresentImageBatchRequest::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:ascend.presenter.proto.PresentImageBatchRequest)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .ascend.presenter.proto.PresentImageRequest image_list = 1;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->image_list_size()); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, this->image_list(static_cast<int>(i)), output);
+  }
+
+  // repeated bytes data_list = 2;
+  for (int i = 0, n = this->data_list_size(); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      2, this->data_list(i), output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:ascend.presenter.proto.PresentImageBatchRequest)
+}
+
+::google::protobuf::uint8* PresentImageBatchRequest::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:ascend.presenter.proto.PresentImageBatchRequest)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .ascend.presenter.proto.PresentImageRequest image_list = 1;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->image_list_size()); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        1, this->image_list(static_cast<int>(i)), deterministic, target);
+  }
+
+  // repeated bytes data_list = 2;
+  for (int i = 0, n = this->data_list_size(); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(2, this->data_list(i), target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:ascend.presenter.proto.PresentImageBatchRequest)
+  return target;
+}
+
+size_t PresentImageBatchRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:ascend.presenter.proto.PresentImageBatchRequest)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // repeated .ascend.presenter.proto.PresentImageRequest image_list = 1;
+  {
+    unsigned int count = static_cast<unsigned int>(this->image_list_size());
+    total_size += 1UL * count;
+    for (unsigned int i = 0; i < count; i++) {
+      total_size +=
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          this->image_list(static_cast<int>(i)));
+    }
+  }
+
+  // repeated bytes data_list = 2;
+  total_size += 1 *
+      ::google::protobuf::internal::FromIntSize(this->data_list_size());
+  for (int i = 0, n = this->data_list_size(); i < n; i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->data_list(i));
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = cached_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void PresentImageBatchRequest::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:ascend.presenter.proto.PresentImageBatchRequest)
+  GOOGLE_DCHECK_NE(&from, this);
+  const PresentImageBatchRequest* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const PresentImageBatchRequest>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:ascend.presenter.proto.PresentImageBatchRequest)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:ascend.presenter.proto.PresentImageBatchRequest)
+    MergeFrom(*source);
+  }
+}
+
+void PresentImageBatchRequest::MergeFrom(const PresentImageBatchRequest& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:ascend.presenter.proto.PresentImageBatchRequest)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  image_list_.MergeFrom(from.image_list_);
+  data_list_.MergeFrom(from.data_list_);
+}
+
+void PresentImageBatchRequest::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:ascend.presenter.proto.PresentImageBatchRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void PresentImageBatchRequest::CopyFrom(const PresentImageBatchRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:ascend.presenter.proto.PresentImageBatchRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PresentImageBatchRequest::IsInitialized() const {
+  return true;
+}
+
+void PresentImageBatchRequest::Swap(PresentImageBatchRequest* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void PresentImageBatchRequest::InternalSwap(PresentImageBatchRequest* other) {
+  using std::swap;
+  image_list_.InternalSwap(&other->image_list_);
+  data_list_.InternalSwap(&other->data_list_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata PresentImageBatchRequest::GetMetadata() const {
+  protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_presenter_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
+// ===================================================================
+
+void PresentRoiRequest::InitAsDefaultInstance() {
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int PresentRoiRequest::kFormatFieldNumber;
+const int PresentRoiRequest::kWidthFieldNumber;
+const int PresentRoiRequest::kHeightFieldNumber;
+const int PresentRoiRequest::kDataFieldNumber;
+const int PresentRoiRequest::kRectangleListFieldNumber;
+const int PresentRoiRequest::kDataListFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+PresentRoiRequest::PresentRoiRequest()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  if (GOOGLE_PREDICT_TRUE(this != internal_default_instance())) {
+    ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentRoiRequest();
+  }
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:ascend.presenter.proto.PresentRoiRequest)
+}
+PresentRoiRequest::PresentRoiRequest(const PresentRoiRequest& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      rectangle_list_(from.rectangle_list_),
+      data_list_(from.data_list_),
+      _cached_size_(0) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  data_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (from.data().size() > 0) {
+    data_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.data_);
+  }
+  ::memcpy(&format_, &from.format_,
+    static_cast<size_t>(reinterpret_cast<char*>(&height_) -
+    reinterpret_cast<char*>(&format_)) + sizeof(height_));
+  // @@protoc_insertion_point(copy_constructor:ascend.presenter.proto.PresentRoiRequest)
+}
+
+void PresentRoiRequest::SharedCtor() {
+  data_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  ::memset(&format_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&height_) -
+      reinterpret_cast<char*>(&format_)) + sizeof(height_));
+  _cached_size_ = 0;
+}
+
+PresentRoiRequest::~PresentRoiRequest() {
+  // @@protoc_insertion_point(destructor:ascend.presenter.proto.PresentRoiRequest)
+  SharedDtor();
+}
+
+void PresentRoiRequest::SharedDtor() {
+  data_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+
+void PresentRoiRequest::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* PresentRoiRequest::descriptor() {
+  ::protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_presenter_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const PresentRoiRequest& PresentRoiRequest::default_instance() {
+  ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentRoiRequest();
+  return *internal_default_instance();
+}
+
+PresentRoiRequest* PresentRoiRequest::New(::google::protobuf::Arena* arena) const {
+  PresentRoiRequest* n = new PresentRoiRequest;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void PresentRoiRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:ascend.presenter.proto.PresentRoiRequest)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  rectangle_list_.Clear();
+  data_list_.Clear();
+  data_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  ::memset(&format_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&height_) -
+      reinterpret_cast<char*>(&format_)) + sizeof(height_));
+  _internal_metadata_.Clear();
+}
+
+bool PresentRoiRequest::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:ascend.presenter.proto.PresentRoiRequest)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // .ascend.presenter.proto.ImageFormat format = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(8u /* 8 & 0xFF */)) {
+          int value;
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
+                 input, &value)));
+          set_format(static_cast< ::ascend::presenter::proto::ImageFormat >(value));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // uint32 width = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(16u /* 16 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &width_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // uint32 height = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(24u /* 24 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &height_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // bytes data = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(34u /* 34 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_data()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated .ascend.presenter.proto.Rectangle_Attr rectangle_list = 5;
+      case 5: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(42u /* 42 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(input, add_rectangle_list()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated bytes data_list = 6;
+      case 6: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(50u /* 50 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_data_list()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:ascend.presenter.proto.PresentRoiRequest)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:ascend.presenter.proto.PresentRoiRequest)
+  return false;
+#undef DO_
+}
+
+void PresentRoiRequest::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:ascend.presenter.proto.PresentRoiRequest)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .ascend.presenter.proto.ImageFormat format = 1;
+  if (this->format() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteEnum(
+      1, this->format(), output);
+  }
+
+  // uint32 width = 2;
+  if (this->width() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->width(), output);
+  }
+
+  // uint32 height = 3;
+  if (this->height() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(3, this->height(), output);
+  }
+
+  // bytes data = 4;
+  if (this->data().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      4, this->data(), output);
+  }
+
+  // repeated .ascend.presenter.proto.Rectangle_Attr rectangle_list = 5;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->rectangle_list_size()); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      5, this->rectangle_list(static_cast<int>(i)), output);
+  }
+
+  // repeated bytes data_list = 6;
+  for (int i = 0, n = this->data_list_size(); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      6, this->data_list(i), output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:ascend.presenter.proto.PresentRoiRequest)
+}
+
+::google::protobuf::uint8* PresentRoiRequest::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:ascend.presenter.proto.PresentRoiRequest)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .ascend.presenter.proto.ImageFormat format = 1;
+  if (this->format() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
+      1, this->format(), target);
+  }
+
+  // uint32 width = 2;
+  if (this->width() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->width(), target);
+  }
+
+  // uint32 height = 3;
+  if (this->height() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(3, this->height(), target);
+  }
+
+  // bytes data = 4;
+  if (this->data().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        4, this->data(), target);
+  }
+
+  // repeated .ascend.presenter.proto.Rectangle_Attr rectangle_list = 5;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->rectangle_list_size()); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        5, this->rectangle_list(static_cast<int>(i)), deterministic, target);
+  }
+
+  // repeated bytes data_list = 6;
+  for (int i = 0, n = this->data_list_size(); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(6, this->data_list(i), target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:ascend.presenter.proto.PresentRoiRequest)
+  return target;
+}
+
+size_t PresentRoiRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:ascend.presenter.proto.PresentRoiRequest)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // repeated .ascend.presenter.proto.Rectangle_Attr rectangle_list = 5;
+  {
+    unsigned int count = static_cast<unsigned int>(this->rectangle_list_size());
+    total_size += 1UL * count;
+    for (unsigned int i = 0; i < count; i++) {
+      total_size +=
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          this->rectangle_list(static_cast<int>(i)));
+    }
+  }
+
+  // repeated bytes data_list = 6;
+  total_size += 1 *
+      ::google::protobuf::internal::FromIntSize(this->data_list_size());
+  for (int i = 0, n = this->data_list_size(); i < n; i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->data_list(i));
+  }
+
+  // bytes data = 4;
+  if (this->data().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->data());
+  }
+
+  // .ascend.presenter.proto.ImageFormat format = 1;
+  if (this->format() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::EnumSize(this->format());
+  }
+
+  // uint32 width = 2;
+  if (this->width() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->width());
+  }
+
+  // uint32 height = 3;
+  if (this->height() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->height());
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = cached_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void PresentRoiRequest::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:ascend.presenter.proto.PresentRoiRequest)
+  GOOGLE_DCHECK_NE(&from, this);
+  const PresentRoiRequest* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const PresentRoiRequest>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:ascend.presenter.proto.PresentRoiRequest)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:ascend.presenter.proto.PresentRoiRequest)
+    MergeFrom(*source);
+  }
+}
+
+void PresentRoiRequest::MergeFrom(const PresentRoiRequest& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:ascend.presenter.proto.PresentRoiRequest)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  rectangle_list_.MergeFrom(from.rectangle_list_);
+  data_list_.MergeFrom(from.data_list_);
+  if (from.data().size() > 0) {
+
+    data_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.data_);
+  }
+  if (from.format() != 0) {
+    set_format(from.format());
+  }
+  if (from.width() != 0) {
+    set_width(from.width());
+  }
+  if (from.height() != 0) {
+    set_height(from.height());
+  }
+}
+
+void PresentRoiRequest::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:ascend.presenter.proto.PresentRoiRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void PresentRoiRequest::CopyFrom(const PresentRoiRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:ascend.presenter.proto.PresentRoiRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PresentRoiRequest::IsInitialized() const {
+  return true;
+}
+
+void PresentRoiRequest::Swap(PresentRoiRequest* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void PresentRoiRequest::InternalSwap(PresentRoiRequest* other) {
+  using std::swap;
+  rectangle_list_.InternalSwap(&other->rectangle_list_);
+  data_list_.InternalSwap(&other->data_list_);
+  data_.Swap(&other->data_);
+  swap(format_, other->format_);
+  swap(width_, other->width_);
+  swap(height_, other->height_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata PresentRoiRequest::GetMetadata() const {
+  protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_presenter_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
+// ===================================================================
+
+void PresentImageChunk::InitAsDefaultInstance() {
+  ::ascend::presenter::proto::_PresentImageChunk_default_instance_._instance.get_mutable()->image_ = const_cast< ::ascend::presenter::proto::PresentImageRequest*>(
+      ::ascend::presenter::proto::PresentImageRequest::internal_default_instance());
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int PresentImageChunk::kFrameIdFieldNumber;
+const int PresentImageChunk::kIndexFieldNumber;
+const int PresentImageChunk::kLastFieldNumber;
+const int PresentImageChunk::kTotalSizeFieldNumber;
+const int PresentImageChunk::kImageFieldNumber;
+const int PresentImageChunk::kDataFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+PresentImageChunk::PresentImageChunk()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  if (GOOGLE_PREDICT_TRUE(this != internal_default_instance())) {
+    ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageChunk();
+  }
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:ascend.presenter.proto.PresentImageChunk)
+}
+PresentImageChunk::PresentImageChunk(const PresentImageChunk& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      _cached_size_(0) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  data_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (from.data().size() > 0) {
+    data_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.data_);
+  }
+  if (from.has_image()) {
+    image_ = new ::ascend::presenter::proto::PresentImageRequest(*from.image_);
+  } else {
+    image_ = NULL;
+  }
+  ::memcpy(&frame_id_, &from.frame_id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&total_size_) -
+    reinterpret_cast<char*>(&frame_id_)) + sizeof(total_size_));
+  // @@protoc_insertion_point(copy_constructor:ascend.presenter.proto.PresentImageChunk)
+}
+
+void PresentImageChunk::SharedCtor() {
+  data_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  ::memset(&image_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&total_size_) -
+      reinterpret_cast<char*>(&image_)) + sizeof(total_size_));
+  _cached_size_ = 0;
+}
+
+PresentImageChunk::~PresentImageChunk() {
+  // @@protoc_insertion_point(destructor:ascend.presenter.proto.PresentImageChunk)
+  SharedDtor();
+}
+
+void PresentImageChunk::SharedDtor() {
+  data_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (this != internal_default_instance()) delete image_;
+}
+
+void PresentImageChunk::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* PresentImageChunk::descriptor() {
+  ::protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_presenter_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const PresentImageChunk& PresentImageChunk::default_instance() {
+  ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageChunk();
+  return *internal_default_instance();
+}
+
+PresentImageChunk* PresentImageChunk::New(::google::protobuf::Arena* arena) const {
+  PresentImageChunk* n = new PresentImageChunk;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void PresentImageChunk::Clear() {
+// @@protoc_insertion_point(message_clear_start:ascend.presenter.proto.PresentImageChunk)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  data_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (GetArenaNoVirtual() == NULL && image_ != NULL) {
+    delete image_;
+  }
+  image_ = NULL;
+  ::memset(&frame_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&total_size_) -
+      reinterpret_cast<char*>(&frame_id_)) + sizeof(total_size_));
+  _internal_metadata_.Clear();
+}
+
+bool PresentImageChunk::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:ascend.presenter.proto.PresentImageChunk)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // uint32 frame_id = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(8u /* 8 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &frame_id_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // uint32 index = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(16u /* 16 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &index_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // bool last = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(24u /* 24 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &last_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // uint32 total_size = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(32u /* 32 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &total_size_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // .ascend.presenter.proto.PresentImageRequest image = 5;
+      case 5: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(42u /* 42 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(
+               input, mutable_image()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // bytes data = 6;
+      case 6: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(50u /* 50 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_data()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:ascend.presenter.proto.PresentImageChunk)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:ascend.presenter.proto.PresentImageChunk)
+  return false;
+#undef DO_
+}
+
+void PresentImageChunk::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:ascend.presenter.proto.PresentImageChunk)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // uint32 frame_id = 1;
+  if (this->frame_id() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->frame_id(), output);
+  }
+
+  // uint32 index = 2;
+  if (this->index() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->index(), output);
+  }
+
+  // bool last = 3;
+  if (this->last() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(3, this->last(), output);
+  }
+
+  // uint32 total_size = 4;
+  if (this->total_size() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(4, this->total_size(), output);
+  }
+
+  // .ascend.presenter.proto.PresentImageRequest image = 5;
+  if (this->has_image()) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      5, *this->image_, output);
+  }
+
+  // bytes data = 6;
+  if (this->data().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      6, this->data(), output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:ascend.presenter.proto.PresentImageChunk)
+}
+
+::google::protobuf::uint8* PresentImageChunk::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:ascend.presenter.proto.PresentImageChunk)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // uint32 frame_id = 1;
+  if (this->frame_id() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->frame_id(), target);
+  }
+
+  // uint32 index = 2;
+  if (this->index() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->index(), target);
+  }
+
+  // bool last = 3;
+  if (this->last() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(3, this->last(), target);
+  }
+
+  // uint32 total_size = 4;
+  if (this->total_size() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(4, this->total_size(), target);
+  }
+
+  // .ascend.presenter.proto.PresentImageRequest image = 5;
+  if (this->has_image()) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        5, *this->image_, deterministic, target);
+  }
+
+  // bytes data = 6;
+  if (this->data().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        6, this->data(), target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:ascend.presenter.proto.PresentImageChunk)
+  return target;
+}
+
+size_t PresentImageChunk::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:ascend.presenter.proto.PresentImageChunk)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // bytes data = 6;
+  if (this->data().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->data());
+  }
+
+  // .ascend.presenter.proto.PresentImageRequest image = 5;
+  if (this->has_image()) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::MessageSize(
+        *this->image_);
+  }
+
+  // uint32 frame_id = 1;
+  if (this->frame_id() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->frame_id());
+  }
+
+  // uint32 index = 2;
+  if (this->index() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->index());
+  }
+
+  // bool last = 3;
+  if (this->last() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // uint32 total_size = 4;
+  if (this->total_size() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->total_size());
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = cached_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void PresentImageChunk::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:ascend.presenter.proto.PresentImageChunk)
+  GOOGLE_DCHECK_NE(&from, this);
+  const PresentImageChunk* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const PresentImageChunk>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:ascend.presenter.proto.PresentImageChunk)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:ascend.presenter.proto.PresentImageChunk)
+    MergeFrom(*source);
+  }
+}
+
+void PresentImageChunk::MergeFrom(const PresentImageChunk& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:ascend.presenter.proto.PresentImageChunk)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.data().size() > 0) {
+
+    data_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.data_);
+  }
+  if (from.has_image()) {
+    mutable_image()->::ascend::presenter::proto::PresentImageRequest::MergeFrom(from.image());
+  }
+  if (from.frame_id() != 0) {
+    set_frame_id(from.frame_id());
+  }
+  if (from.index() != 0) {
+    set_index(from.index());
+  }
+  if (from.last() != 0) {
+    set_last(from.last());
+  }
+  if (from.total_size() != 0) {
+    set_total_size(from.total_size());
+  }
+}
+
+void PresentImageChunk::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:ascend.presenter.proto.PresentImageChunk)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void PresentImageChunk::CopyFrom(const PresentImageChunk& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:ascend.presenter.proto.PresentImageChunk)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PresentImageChunk::IsInitialized() const {
+  return true;
+}
+
+void PresentImageChunk::Swap(PresentImageChunk* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void PresentImageChunk::InternalSwap(PresentImageChunk* other) {
+  using std::swap;
+  data_.Swap(&other->data_);
+  swap(image_, other->image_);
+  swap(frame_id_, other->frame_id_);
+  swap(index_, other->index_);
+  swap(last_, other->last_);
+  swap(total_size_, other->total_size_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata PresentImageChunk::GetMetadata() const {
+  protobuf_presenter_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_presenter_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace proto
 }  // namespace presenter
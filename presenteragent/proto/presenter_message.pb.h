@@ -37,7 +37,7 @@ namespace protobuf_presenter_5fmessage_2eproto {
 struct TableStruct {
   static const ::google::protobuf::internal::ParseTableField entries[];
   static const ::google::protobuf::internal::AuxillaryParseTableField aux[];
-  static const ::google::protobuf::internal::ParseTable schema[7];
+  static const ::google::protobuf::internal::ParseTable schema[10];
   static const ::google::protobuf::internal::FieldMetadata field_metadata[];
   static const ::google::protobuf::internal::SerializationTable serialization_table[];
   static const ::google::protobuf::uint32 offsets[];
@@ -57,6 +57,12 @@ void InitDefaultsPresentImageRequestImpl();
 void InitDefaultsPresentImageRequest();
 void InitDefaultsPresentImageResponseImpl();
 void InitDefaultsPresentImageResponse();
+void InitDefaultsPresentImageBatchRequestImpl();
+void InitDefaultsPresentImageBatchRequest();
+void InitDefaultsPresentRoiRequestImpl();
+void InitDefaultsPresentRoiRequest();
+void InitDefaultsPresentImageChunkImpl();
+void InitDefaultsPresentImageChunk();
 inline void InitDefaults() {
   InitDefaultsOpenChannelRequest();
   InitDefaultsOpenChannelResponse();
@@ -65,6 +71,9 @@ inline void InitDefaults() {
   InitDefaultsRectangle_Attr();
   InitDefaultsPresentImageRequest();
   InitDefaultsPresentImageResponse();
+  InitDefaultsPresentImageBatchRequest();
+  InitDefaultsPresentRoiRequest();
+  InitDefaultsPresentImageChunk();
 }
 }  // namespace protobuf_presenter_5fmessage_2eproto
 namespace ascend {
@@ -82,12 +91,21 @@ extern OpenChannelRequestDefaultTypeInternal _OpenChannelRequest_default_instanc
 class OpenChannelResponse;
 class OpenChannelResponseDefaultTypeInternal;
 extern OpenChannelResponseDefaultTypeInternal _OpenChannelResponse_default_instance_;
+class PresentImageBatchRequest;
+class PresentImageBatchRequestDefaultTypeInternal;
+extern PresentImageBatchRequestDefaultTypeInternal _PresentImageBatchRequest_default_instance_;
+class PresentImageChunk;
+class PresentImageChunkDefaultTypeInternal;
+extern PresentImageChunkDefaultTypeInternal _PresentImageChunk_default_instance_;
 class PresentImageRequest;
 class PresentImageRequestDefaultTypeInternal;
 extern PresentImageRequestDefaultTypeInternal _PresentImageRequest_default_instance_;
 class PresentImageResponse;
 class PresentImageResponseDefaultTypeInternal;
 extern PresentImageResponseDefaultTypeInternal _PresentImageResponse_default_instance_;
+class PresentRoiRequest;
+class PresentRoiRequestDefaultTypeInternal;
+extern PresentRoiRequestDefaultTypeInternal _PresentRoiRequest_default_instance_;
 class Rectangle_Attr;
 class Rectangle_AttrDefaultTypeInternal;
 extern Rectangle_AttrDefaultTypeInternal _Rectangle_Attr_default_instance_;
@@ -142,6 +160,28 @@ inline bool ChannelContentType_Parse(
   return ::google::protobuf::internal::ParseNamedEnum<ChannelContentType>(
     ChannelContentType_descriptor(), name, value);
 }
+enum CompressionType {
+  kCompressionNone = 0,
+  kCompressionLz4 = 1,
+  kCompressionZstd = 2,
+  CompressionType_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
+  CompressionType_INT_MAX_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32max
+};
+bool CompressionType_IsValid(int value);
+const CompressionType CompressionType_MIN = kCompressionNone;
+const CompressionType CompressionType_MAX = kCompressionZstd;
+const int CompressionType_ARRAYSIZE = CompressionType_MAX + 1;
+
+const ::google::protobuf::EnumDescriptor* CompressionType_descriptor();
+inline const ::std::string& CompressionType_Name(CompressionType value) {
+  return ::google::protobuf::internal::NameOfEnum(
+    CompressionType_descriptor(), value);
+}
+inline bool CompressionType_Parse(
+    const ::std::string& name, CompressionType* value) {
+  return ::google::protobuf::internal::ParseNamedEnum<CompressionType>(
+    CompressionType_descriptor(), name, value);
+}
 enum ImageFormat {
   kImageFormatJpeg = 0,
   ImageFormat_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
@@ -289,12 +329,19 @@ class OpenChannelRequest : public ::google::protobuf::Message /* @@protoc_insert
   ::ascend::presenter::proto::ChannelContentType content_type() const;
   void set_content_type(::ascend::presenter::proto::ChannelContentType value);
 
+  // .ascend.presenter.proto.CompressionType compression = 3;
+  void clear_compression();
+  static const int kCompressionFieldNumber = 3;
+  ::ascend::presenter::proto::CompressionType compression() const;
+  void set_compression(::ascend::presenter::proto::CompressionType value);
+
   // @@protoc_insertion_point(class_scope:ascend.presenter.proto.OpenChannelRequest)
  private:
 
   ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
   ::google::protobuf::internal::ArenaStringPtr channel_name_;
   int content_type_;
+  int compression_;
   mutable int _cached_size_;
   friend struct ::protobuf_presenter_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_presenter_5fmessage_2eproto::InitDefaultsOpenChannelRequestImpl();
@@ -403,12 +450,19 @@ class OpenChannelResponse : public ::google::protobuf::Message /* @@protoc_inser
   ::ascend::presenter::proto::OpenChannelErrorCode error_code() const;
   void set_error_code(::ascend::presenter::proto::OpenChannelErrorCode value);
 
+  // .ascend.presenter.proto.CompressionType compression = 3;
+  void clear_compression();
+  static const int kCompressionFieldNumber = 3;
+  ::ascend::presenter::proto::CompressionType compression() const;
+  void set_compression(::ascend::presenter::proto::CompressionType value);
+
   // @@protoc_insertion_point(class_scope:ascend.presenter.proto.OpenChannelResponse)
  private:
 
   ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
   ::google::protobuf::internal::ArenaStringPtr error_message_;
   int error_code_;
+  int compression_;
   mutable int _cached_size_;
   friend struct ::protobuf_presenter_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_presenter_5fmessage_2eproto::InitDefaultsOpenChannelResponseImpl();
@@ -993,214 +1047,679 @@ class PresentImageResponse : public ::google::protobuf::Message /* @@protoc_inse
   friend struct ::protobuf_presenter_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageResponseImpl();
 };
-// ===================================================================
+// -------------------------------------------------------------------
 
+class PresentImageBatchRequest : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:ascend.presenter.proto.PresentImageBatchRequest) */ {
+ public:
+  PresentImageBatchRequest();
+  virtual ~PresentImageBatchRequest();
 
-// ===================================================================
+  PresentImageBatchRequest(const PresentImageBatchRequest& from);
 
-#ifdef __GNUC__
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// OpenChannelRequest
+  inline PresentImageBatchRequest& operator=(const PresentImageBatchRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  PresentImageBatchRequest(PresentImageBatchRequest&& from) noexcept
+    : PresentImageBatchRequest() {
+    *this = ::std::move(from);
+  }
 
-// string channel_name = 1;
-inline void OpenChannelRequest::clear_channel_name() {
-  channel_name_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-}
-inline const ::std::string& OpenChannelRequest::channel_name() const {
-  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelRequest.channel_name)
-  return channel_name_.GetNoArena();
-}
-inline void OpenChannelRequest::set_channel_name(const ::std::string& value) {
-  
-  channel_name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
-  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelRequest.channel_name)
-}
-#if LANG_CXX11
-inline void OpenChannelRequest::set_channel_name(::std::string&& value) {
-  
-  channel_name_.SetNoArena(
-    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
-  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.proto.OpenChannelRequest.channel_name)
-}
-#endif
-inline void OpenChannelRequest::set_channel_name(const char* value) {
-  GOOGLE_DCHECK(value != NULL);
-  
-  channel_name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
-  // @@protoc_insertion_point(field_set_char:ascend.presenter.proto.OpenChannelRequest.channel_name)
-}
-inline void OpenChannelRequest::set_channel_name(const char* value, size_t size) {
-  
-  channel_name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
-      ::std::string(reinterpret_cast<const char*>(value), size));
-  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.proto.OpenChannelRequest.channel_name)
-}
-inline ::std::string* OpenChannelRequest::mutable_channel_name() {
-  
-  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.OpenChannelRequest.channel_name)
-  return channel_name_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-}
-inline ::std::string* OpenChannelRequest::release_channel_name() {
-  // @@protoc_insertion_point(field_release:ascend.presenter.proto.OpenChannelRequest.channel_name)
-  
-  return channel_name_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-}
-inline void OpenChannelRequest::set_allocated_channel_name(::std::string* channel_name) {
-  if (channel_name != NULL) {
-    
-  } else {
-    
+  inline PresentImageBatchRequest& operator=(PresentImageBatchRequest&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
-  channel_name_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), channel_name);
-  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.proto.OpenChannelRequest.channel_name)
-}
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const PresentImageBatchRequest& default_instance();
 
-// .ascend.presenter.proto.ChannelContentType content_type = 2;
-inline void OpenChannelRequest::clear_content_type() {
-  content_type_ = 0;
-}
-inline ::ascend::presenter::proto::ChannelContentType OpenChannelRequest::content_type() const {
-  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelRequest.content_type)
-  return static_cast< ::ascend::presenter::proto::ChannelContentType >(content_type_);
-}
-inline void OpenChannelRequest::set_content_type(::ascend::presenter::proto::ChannelContentType value) {
-  
-  content_type_ = value;
-  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelRequest.content_type)
-}
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const PresentImageBatchRequest* internal_default_instance() {
+    return reinterpret_cast<const PresentImageBatchRequest*>(
+               &_PresentImageBatchRequest_default_instance_);
+  }
+  static PROTOBUF_CONSTEXPR int const kIndexInFileMessages =
+    7;
 
-// -------------------------------------------------------------------
+  void Swap(PresentImageBatchRequest* other);
+  friend void swap(PresentImageBatchRequest& a, PresentImageBatchRequest& b) {
+    a.Swap(&b);
+  }
 
-// OpenChannelResponse
+  // implements Message ----------------------------------------------
 
-// .ascend.presenter.proto.OpenChannelErrorCode error_code = 1;
-inline void OpenChannelResponse::clear_error_code() {
-  error_code_ = 0;
-}
-inline ::ascend::presenter::proto::OpenChannelErrorCode OpenChannelResponse::error_code() const {
-  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelResponse.error_code)
-  return static_cast< ::ascend::presenter::proto::OpenChannelErrorCode >(error_code_);
-}
-inline void OpenChannelResponse::set_error_code(::ascend::presenter::proto::OpenChannelErrorCode value) {
-  
-  error_code_ = value;
-  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelResponse.error_code)
-}
+  inline PresentImageBatchRequest* New() const PROTOBUF_FINAL { return New(NULL); }
 
-// string error_message = 2;
-inline void OpenChannelResponse::clear_error_message() {
-  error_message_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-}
-inline const ::std::string& OpenChannelResponse::error_message() const {
-  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelResponse.error_message)
-  return error_message_.GetNoArena();
-}
-inline void OpenChannelResponse::set_error_message(const ::std::string& value) {
-  
-  error_message_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
-  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelResponse.error_message)
-}
-#if LANG_CXX11
-inline void OpenChannelResponse::set_error_message(::std::string&& value) {
-  
-  error_message_.SetNoArena(
-    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
-  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.proto.OpenChannelResponse.error_message)
-}
-#endif
-inline void OpenChannelResponse::set_error_message(const char* value) {
-  GOOGLE_DCHECK(value != NULL);
-  
-  error_message_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
-  // @@protoc_insertion_point(field_set_char:ascend.presenter.proto.OpenChannelResponse.error_message)
-}
-inline void OpenChannelResponse::set_error_message(const char* value, size_t size) {
-  
-  error_message_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
-      ::std::string(reinterpret_cast<const char*>(value), size));
-  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.proto.OpenChannelResponse.error_message)
-}
-inline ::std::string* OpenChannelResponse::mutable_error_message() {
-  
-  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.OpenChannelResponse.error_message)
-  return error_message_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-}
-inline ::std::string* OpenChannelResponse::release_error_message() {
-  // @@protoc_insertion_point(field_release:ascend.presenter.proto.OpenChannelResponse.error_message)
-  
-  return error_message_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-}
-inline void OpenChannelResponse::set_allocated_error_message(::std::string* error_message) {
-  if (error_message != NULL) {
-    
-  } else {
-    
-  }
-  error_message_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), error_message);
-  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.proto.OpenChannelResponse.error_message)
-}
+  PresentImageBatchRequest* New(::google::protobuf::Arena* arena) const PROTOBUF_FINAL;
+  void CopyFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void MergeFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void CopyFrom(const PresentImageBatchRequest& from);
+  void MergeFrom(const PresentImageBatchRequest& from);
+  void Clear() PROTOBUF_FINAL;
+  bool IsInitialized() const PROTOBUF_FINAL;
 
-// -------------------------------------------------------------------
+  size_t ByteSizeLong() const PROTOBUF_FINAL;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) PROTOBUF_FINAL;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const PROTOBUF_FINAL;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const PROTOBUF_FINAL;
+  int GetCachedSize() const PROTOBUF_FINAL { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const PROTOBUF_FINAL;
+  void InternalSwap(PresentImageBatchRequest* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
 
-// HeartbeatMessage
+  ::google::protobuf::Metadata GetMetadata() const PROTOBUF_FINAL;
 
-// -------------------------------------------------------------------
+  // nested types ----------------------------------------------------
 
-// Coordinate
+  // accessors -------------------------------------------------------
 
-// uint32 x = 1;
-inline void Coordinate::clear_x() {
-  x_ = 0u;
-}
-inline ::google::protobuf::uint32 Coordinate::x() const {
-  // @@protoc_insertion_point(field_get:ascend.presenter.proto.Coordinate.x)
-  return x_;
-}
-inline void Coordinate::set_x(::google::protobuf::uint32 value) {
-  
-  x_ = value;
-  // @@protoc_insertion_point(field_set:ascend.presenter.proto.Coordinate.x)
-}
+  // repeated .ascend.presenter.proto.PresentImageRequest image_list = 1;
+  int image_list_size() const;
+  void clear_image_list();
+  static const int kImageListFieldNumber = 1;
+  const ::ascend::presenter::proto::PresentImageRequest& image_list(int index) const;
+  ::ascend::presenter::proto::PresentImageRequest* mutable_image_list(int index);
+  ::ascend::presenter::proto::PresentImageRequest* add_image_list();
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::PresentImageRequest >*
+      mutable_image_list();
+  const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::PresentImageRequest >&
+      image_list() const;
+
+  // repeated bytes data_list = 2;
+  int data_list_size() const;
+  void clear_data_list();
+  static const int kDataListFieldNumber = 2;
+  const ::std::string& data_list(int index) const;
+  ::std::string* mutable_data_list(int index);
+  void set_data_list(int index, const ::std::string& value);
+  #if LANG_CXX11
+  void set_data_list(int index, ::std::string&& value);
+  #endif
+  void set_data_list(int index, const char* value);
+  void set_data_list(int index, const void* value, size_t size);
+  ::std::string* add_data_list();
+  void add_data_list(const ::std::string& value);
+  #if LANG_CXX11
+  void add_data_list(::std::string&& value);
+  #endif
+  void add_data_list(const char* value);
+  void add_data_list(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& data_list() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_data_list();
 
-// uint32 y = 2;
-inline void Coordinate::clear_y() {
-  y_ = 0u;
-}
-inline ::google::protobuf::uint32 Coordinate::y() const {
-  // @@protoc_insertion_point(field_get:ascend.presenter.proto.Coordinate.y)
-  return y_;
-}
-inline void Coordinate::set_y(::google::protobuf::uint32 value) {
-  
-  y_ = value;
-  // @@protoc_insertion_point(field_set:ascend.presenter.proto.Coordinate.y)
-}
+  // @@protoc_insertion_point(class_scope:ascend.presenter.proto.PresentImageBatchRequest)
+ private:
 
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::PresentImageRequest > image_list_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> data_list_;
+  mutable int _cached_size_;
+  friend struct ::protobuf_presenter_5fmessage_2eproto::TableStruct;
+  friend void ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageBatchRequestImpl();
+};
 // -------------------------------------------------------------------
 
-// Rectangle_Attr
+class PresentRoiRequest : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:ascend.presenter.proto.PresentRoiRequest) */ {
+ public:
+  PresentRoiRequest();
+  virtual ~PresentRoiRequest();
 
-// .ascend.presenter.proto.Coordinate left_top = 1;
-inline bool Rectangle_Attr::has_left_top() const {
-  return this != internal_default_instance() && left_top_ != NULL;
-}
-inline void Rectangle_Attr::clear_left_top() {
-  if (GetArenaNoVirtual() == NULL && left_top_ != NULL) {
-    delete left_top_;
+  PresentRoiRequest(const PresentRoiRequest& from);
+
+  inline PresentRoiRequest& operator=(const PresentRoiRequest& from) {
+    CopyFrom(from);
+    return *this;
   }
-  left_top_ = NULL;
-}
-inline const ::ascend::presenter::proto::Coordinate& Rectangle_Attr::left_top() const {
-  const ::ascend::presenter::proto::Coordinate* p = left_top_;
-  // @@protoc_insertion_point(field_get:ascend.presenter.proto.Rectangle_Attr.left_top)
-  return p != NULL ? *p : *reinterpret_cast<const ::ascend::presenter::proto::Coordinate*>(
-      &::ascend::presenter::proto::_Coordinate_default_instance_);
-}
-inline ::ascend::presenter::proto::Coordinate* Rectangle_Attr::release_left_top() {
-  // @@protoc_insertion_point(field_release:ascend.presenter.proto.Rectangle_Attr.left_top)
-  
+  #if LANG_CXX11
+  PresentRoiRequest(PresentRoiRequest&& from) noexcept
+    : PresentRoiRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline PresentRoiRequest& operator=(PresentRoiRequest&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const PresentRoiRequest& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const PresentRoiRequest* internal_default_instance() {
+    return reinterpret_cast<const PresentRoiRequest*>(
+               &_PresentRoiRequest_default_instance_);
+  }
+  static PROTOBUF_CONSTEXPR int const kIndexInFileMessages =
+    8;
+
+  void Swap(PresentRoiRequest* other);
+  friend void swap(PresentRoiRequest& a, PresentRoiRequest& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline PresentRoiRequest* New() const PROTOBUF_FINAL { return New(NULL); }
+
+  PresentRoiRequest* New(::google::protobuf::Arena* arena) const PROTOBUF_FINAL;
+  void CopyFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void MergeFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void CopyFrom(const PresentRoiRequest& from);
+  void MergeFrom(const PresentRoiRequest& from);
+  void Clear() PROTOBUF_FINAL;
+  bool IsInitialized() const PROTOBUF_FINAL;
+
+  size_t ByteSizeLong() const PROTOBUF_FINAL;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) PROTOBUF_FINAL;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const PROTOBUF_FINAL;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const PROTOBUF_FINAL;
+  int GetCachedSize() const PROTOBUF_FINAL { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const PROTOBUF_FINAL;
+  void InternalSwap(PresentRoiRequest* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const PROTOBUF_FINAL;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated .ascend.presenter.proto.Rectangle_Attr rectangle_list = 5;
+  int rectangle_list_size() const;
+  void clear_rectangle_list();
+  static const int kRectangleListFieldNumber = 5;
+  const ::ascend::presenter::proto::Rectangle_Attr& rectangle_list(int index) const;
+  ::ascend::presenter::proto::Rectangle_Attr* mutable_rectangle_list(int index);
+  ::ascend::presenter::proto::Rectangle_Attr* add_rectangle_list();
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::Rectangle_Attr >*
+      mutable_rectangle_list();
+  const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::Rectangle_Attr >&
+      rectangle_list() const;
+
+  // repeated bytes data_list = 6;
+  int data_list_size() const;
+  void clear_data_list();
+  static const int kDataListFieldNumber = 6;
+  const ::std::string& data_list(int index) const;
+  ::std::string* mutable_data_list(int index);
+  void set_data_list(int index, const ::std::string& value);
+  #if LANG_CXX11
+  void set_data_list(int index, ::std::string&& value);
+  #endif
+  void set_data_list(int index, const char* value);
+  void set_data_list(int index, const void* value, size_t size);
+  ::std::string* add_data_list();
+  void add_data_list(const ::std::string& value);
+  #if LANG_CXX11
+  void add_data_list(::std::string&& value);
+  #endif
+  void add_data_list(const char* value);
+  void add_data_list(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& data_list() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_data_list();
+
+  // bytes data = 4;
+  void clear_data();
+  static const int kDataFieldNumber = 4;
+  const ::std::string& data() const;
+  void set_data(const ::std::string& value);
+  #if LANG_CXX11
+  void set_data(::std::string&& value);
+  #endif
+  void set_data(const char* value);
+  void set_data(const void* value, size_t size);
+  ::std::string* mutable_data();
+  ::std::string* release_data();
+  void set_allocated_data(::std::string* data);
+
+  // .ascend.presenter.proto.ImageFormat format = 1;
+  void clear_format();
+  static const int kFormatFieldNumber = 1;
+  ::ascend::presenter::proto::ImageFormat format() const;
+  void set_format(::ascend::presenter::proto::ImageFormat value);
+
+  // uint32 width = 2;
+  void clear_width();
+  static const int kWidthFieldNumber = 2;
+  ::google::protobuf::uint32 width() const;
+  void set_width(::google::protobuf::uint32 value);
+
+  // uint32 height = 3;
+  void clear_height();
+  static const int kHeightFieldNumber = 3;
+  ::google::protobuf::uint32 height() const;
+  void set_height(::google::protobuf::uint32 value);
+
+  // @@protoc_insertion_point(class_scope:ascend.presenter.proto.PresentRoiRequest)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::Rectangle_Attr > rectangle_list_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> data_list_;
+  ::google::protobuf::internal::ArenaStringPtr data_;
+  int format_;
+  ::google::protobuf::uint32 width_;
+  ::google::protobuf::uint32 height_;
+  mutable int _cached_size_;
+  friend struct ::protobuf_presenter_5fmessage_2eproto::TableStruct;
+  friend void ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentRoiRequestImpl();
+};
+// -------------------------------------------------------------------
+
+class PresentImageChunk : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:ascend.presenter.proto.PresentImageChunk) */ {
+ public:
+  PresentImageChunk();
+  virtual ~PresentImageChunk();
+
+  PresentImageChunk(const PresentImageChunk& from);
+
+  inline PresentImageChunk& operator=(const PresentImageChunk& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  PresentImageChunk(PresentImageChunk&& from) noexcept
+    : PresentImageChunk() {
+    *this = ::std::move(from);
+  }
+
+  inline PresentImageChunk& operator=(PresentImageChunk&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const PresentImageChunk& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const PresentImageChunk* internal_default_instance() {
+    return reinterpret_cast<const PresentImageChunk*>(
+               &_PresentImageChunk_default_instance_);
+  }
+  static PROTOBUF_CONSTEXPR int const kIndexInFileMessages =
+    9;
+
+  void Swap(PresentImageChunk* other);
+  friend void swap(PresentImageChunk& a, PresentImageChunk& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline PresentImageChunk* New() const PROTOBUF_FINAL { return New(NULL); }
+
+  PresentImageChunk* New(::google::protobuf::Arena* arena) const PROTOBUF_FINAL;
+  void CopyFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void MergeFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void CopyFrom(const PresentImageChunk& from);
+  void MergeFrom(const PresentImageChunk& from);
+  void Clear() PROTOBUF_FINAL;
+  bool IsInitialized() const PROTOBUF_FINAL;
+
+  size_t ByteSizeLong() const PROTOBUF_FINAL;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) PROTOBUF_FINAL;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const PROTOBUF_FINAL;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const PROTOBUF_FINAL;
+  int GetCachedSize() const PROTOBUF_FINAL { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const PROTOBUF_FINAL;
+  void InternalSwap(PresentImageChunk* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const PROTOBUF_FINAL;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // bytes data = 6;
+  void clear_data();
+  static const int kDataFieldNumber = 6;
+  const ::std::string& data() const;
+  void set_data(const ::std::string& value);
+  #if LANG_CXX11
+  void set_data(::std::string&& value);
+  #endif
+  void set_data(const char* value);
+  void set_data(const void* value, size_t size);
+  ::std::string* mutable_data();
+  ::std::string* release_data();
+  void set_allocated_data(::std::string* data);
+
+  // .ascend.presenter.proto.PresentImageRequest image = 5;
+  bool has_image() const;
+  void clear_image();
+  static const int kImageFieldNumber = 5;
+  const ::ascend::presenter::proto::PresentImageRequest& image() const;
+  ::ascend::presenter::proto::PresentImageRequest* release_image();
+  ::ascend::presenter::proto::PresentImageRequest* mutable_image();
+  void set_allocated_image(::ascend::presenter::proto::PresentImageRequest* image);
+
+  // uint32 frame_id = 1;
+  void clear_frame_id();
+  static const int kFrameIdFieldNumber = 1;
+  ::google::protobuf::uint32 frame_id() const;
+  void set_frame_id(::google::protobuf::uint32 value);
+
+  // uint32 index = 2;
+  void clear_index();
+  static const int kIndexFieldNumber = 2;
+  ::google::protobuf::uint32 index() const;
+  void set_index(::google::protobuf::uint32 value);
+
+  // bool last = 3;
+  void clear_last();
+  static const int kLastFieldNumber = 3;
+  bool last() const;
+  void set_last(bool value);
+
+  // uint32 total_size = 4;
+  void clear_total_size();
+  static const int kTotalSizeFieldNumber = 4;
+  ::google::protobuf::uint32 total_size() const;
+  void set_total_size(::google::protobuf::uint32 value);
+
+  // @@protoc_insertion_point(class_scope:ascend.presenter.proto.PresentImageChunk)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::internal::ArenaStringPtr data_;
+  ::ascend::presenter::proto::PresentImageRequest* image_;
+  ::google::protobuf::uint32 frame_id_;
+  ::google::protobuf::uint32 index_;
+  bool last_;
+  ::google::protobuf::uint32 total_size_;
+  mutable int _cached_size_;
+  friend struct ::protobuf_presenter_5fmessage_2eproto::TableStruct;
+  friend void ::protobuf_presenter_5fmessage_2eproto::InitDefaultsPresentImageChunkImpl();
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// OpenChannelRequest
+
+// string channel_name = 1;
+inline void OpenChannelRequest::clear_channel_name() {
+  channel_name_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& OpenChannelRequest::channel_name() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelRequest.channel_name)
+  return channel_name_.GetNoArena();
+}
+inline void OpenChannelRequest::set_channel_name(const ::std::string& value) {
+  
+  channel_name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelRequest.channel_name)
+}
+#if LANG_CXX11
+inline void OpenChannelRequest::set_channel_name(::std::string&& value) {
+  
+  channel_name_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.proto.OpenChannelRequest.channel_name)
+}
+#endif
+inline void OpenChannelRequest::set_channel_name(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  channel_name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.proto.OpenChannelRequest.channel_name)
+}
+inline void OpenChannelRequest::set_channel_name(const char* value, size_t size) {
+  
+  channel_name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.proto.OpenChannelRequest.channel_name)
+}
+inline ::std::string* OpenChannelRequest::mutable_channel_name() {
+  
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.OpenChannelRequest.channel_name)
+  return channel_name_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* OpenChannelRequest::release_channel_name() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.proto.OpenChannelRequest.channel_name)
+  
+  return channel_name_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void OpenChannelRequest::set_allocated_channel_name(::std::string* channel_name) {
+  if (channel_name != NULL) {
+    
+  } else {
+    
+  }
+  channel_name_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), channel_name);
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.proto.OpenChannelRequest.channel_name)
+}
+
+// .ascend.presenter.proto.ChannelContentType content_type = 2;
+inline void OpenChannelRequest::clear_content_type() {
+  content_type_ = 0;
+}
+inline ::ascend::presenter::proto::ChannelContentType OpenChannelRequest::content_type() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelRequest.content_type)
+  return static_cast< ::ascend::presenter::proto::ChannelContentType >(content_type_);
+}
+inline void OpenChannelRequest::set_content_type(::ascend::presenter::proto::ChannelContentType value) {
+  
+  content_type_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelRequest.content_type)
+}
+
+// .ascend.presenter.proto.CompressionType compression = 3;
+inline void OpenChannelRequest::clear_compression() {
+  compression_ = 0;
+}
+inline ::ascend::presenter::proto::CompressionType OpenChannelRequest::compression() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelRequest.compression)
+  return static_cast< ::ascend::presenter::proto::CompressionType >(compression_);
+}
+inline void OpenChannelRequest::set_compression(::ascend::presenter::proto::CompressionType value) {
+  
+  compression_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelRequest.compression)
+}
+
+// -------------------------------------------------------------------
+
+// OpenChannelResponse
+
+// .ascend.presenter.proto.OpenChannelErrorCode error_code = 1;
+inline void OpenChannelResponse::clear_error_code() {
+  error_code_ = 0;
+}
+inline ::ascend::presenter::proto::OpenChannelErrorCode OpenChannelResponse::error_code() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelResponse.error_code)
+  return static_cast< ::ascend::presenter::proto::OpenChannelErrorCode >(error_code_);
+}
+inline void OpenChannelResponse::set_error_code(::ascend::presenter::proto::OpenChannelErrorCode value) {
+  
+  error_code_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelResponse.error_code)
+}
+
+// string error_message = 2;
+inline void OpenChannelResponse::clear_error_message() {
+  error_message_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& OpenChannelResponse::error_message() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelResponse.error_message)
+  return error_message_.GetNoArena();
+}
+inline void OpenChannelResponse::set_error_message(const ::std::string& value) {
+  
+  error_message_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelResponse.error_message)
+}
+#if LANG_CXX11
+inline void OpenChannelResponse::set_error_message(::std::string&& value) {
+  
+  error_message_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.proto.OpenChannelResponse.error_message)
+}
+#endif
+inline void OpenChannelResponse::set_error_message(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  error_message_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.proto.OpenChannelResponse.error_message)
+}
+inline void OpenChannelResponse::set_error_message(const char* value, size_t size) {
+  
+  error_message_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.proto.OpenChannelResponse.error_message)
+}
+inline ::std::string* OpenChannelResponse::mutable_error_message() {
+  
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.OpenChannelResponse.error_message)
+  return error_message_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* OpenChannelResponse::release_error_message() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.proto.OpenChannelResponse.error_message)
+  
+  return error_message_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void OpenChannelResponse::set_allocated_error_message(::std::string* error_message) {
+  if (error_message != NULL) {
+    
+  } else {
+    
+  }
+  error_message_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), error_message);
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.proto.OpenChannelResponse.error_message)
+}
+
+// .ascend.presenter.proto.CompressionType compression = 3;
+inline void OpenChannelResponse::clear_compression() {
+  compression_ = 0;
+}
+inline ::ascend::presenter::proto::CompressionType OpenChannelResponse::compression() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.OpenChannelResponse.compression)
+  return static_cast< ::ascend::presenter::proto::CompressionType >(compression_);
+}
+inline void OpenChannelResponse::set_compression(::ascend::presenter::proto::CompressionType value) {
+  
+  compression_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.OpenChannelResponse.compression)
+}
+
+// -------------------------------------------------------------------
+
+// HeartbeatMessage
+
+// -------------------------------------------------------------------
+
+// Coordinate
+
+// uint32 x = 1;
+inline void Coordinate::clear_x() {
+  x_ = 0u;
+}
+inline ::google::protobuf::uint32 Coordinate::x() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.Coordinate.x)
+  return x_;
+}
+inline void Coordinate::set_x(::google::protobuf::uint32 value) {
+  
+  x_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.Coordinate.x)
+}
+
+// uint32 y = 2;
+inline void Coordinate::clear_y() {
+  y_ = 0u;
+}
+inline ::google::protobuf::uint32 Coordinate::y() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.Coordinate.y)
+  return y_;
+}
+inline void Coordinate::set_y(::google::protobuf::uint32 value) {
+  
+  y_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.Coordinate.y)
+}
+
+// -------------------------------------------------------------------
+
+// Rectangle_Attr
+
+// .ascend.presenter.proto.Coordinate left_top = 1;
+inline bool Rectangle_Attr::has_left_top() const {
+  return this != internal_default_instance() && left_top_ != NULL;
+}
+inline void Rectangle_Attr::clear_left_top() {
+  if (GetArenaNoVirtual() == NULL && left_top_ != NULL) {
+    delete left_top_;
+  }
+  left_top_ = NULL;
+}
+inline const ::ascend::presenter::proto::Coordinate& Rectangle_Attr::left_top() const {
+  const ::ascend::presenter::proto::Coordinate* p = left_top_;
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.Rectangle_Attr.left_top)
+  return p != NULL ? *p : *reinterpret_cast<const ::ascend::presenter::proto::Coordinate*>(
+      &::ascend::presenter::proto::_Coordinate_default_instance_);
+}
+inline ::ascend::presenter::proto::Coordinate* Rectangle_Attr::release_left_top() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.proto.Rectangle_Attr.left_top)
+  
   ::ascend::presenter::proto::Coordinate* temp = left_top_;
   left_top_ = NULL;
   return temp;
@@ -1535,6 +2054,470 @@ inline void PresentImageResponse::set_allocated_error_message(::std::string* err
   // @@protoc_insertion_point(field_set_allocated:ascend.presenter.proto.PresentImageResponse.error_message)
 }
 
+// -------------------------------------------------------------------
+
+// PresentImageBatchRequest
+
+// repeated .ascend.presenter.proto.PresentImageRequest image_list = 1;
+inline int PresentImageBatchRequest::image_list_size() const {
+  return image_list_.size();
+}
+inline void PresentImageBatchRequest::clear_image_list() {
+  image_list_.Clear();
+}
+inline const ::ascend::presenter::proto::PresentImageRequest& PresentImageBatchRequest::image_list(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentImageBatchRequest.image_list)
+  return image_list_.Get(index);
+}
+inline ::ascend::presenter::proto::PresentImageRequest* PresentImageBatchRequest::mutable_image_list(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.PresentImageBatchRequest.image_list)
+  return image_list_.Mutable(index);
+}
+inline ::ascend::presenter::proto::PresentImageRequest* PresentImageBatchRequest::add_image_list() {
+  // @@protoc_insertion_point(field_add:ascend.presenter.proto.PresentImageBatchRequest.image_list)
+  return image_list_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::PresentImageRequest >*
+PresentImageBatchRequest::mutable_image_list() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.proto.PresentImageBatchRequest.image_list)
+  return &image_list_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::PresentImageRequest >&
+PresentImageBatchRequest::image_list() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.proto.PresentImageBatchRequest.image_list)
+  return image_list_;
+}
+
+// repeated bytes data_list = 2;
+inline int PresentImageBatchRequest::data_list_size() const {
+  return data_list_.size();
+}
+inline void PresentImageBatchRequest::clear_data_list() {
+  data_list_.Clear();
+}
+inline const ::std::string& PresentImageBatchRequest::data_list(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+  return data_list_.Get(index);
+}
+inline ::std::string* PresentImageBatchRequest::mutable_data_list(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+  return data_list_.Mutable(index);
+}
+inline void PresentImageBatchRequest::set_data_list(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+  data_list_.Mutable(index)->assign(value);
+}
+#if LANG_CXX11
+inline void PresentImageBatchRequest::set_data_list(int index, ::std::string&& value) {
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+  data_list_.Mutable(index)->assign(std::move(value));
+}
+#endif
+inline void PresentImageBatchRequest::set_data_list(int index, const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  data_list_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+}
+inline void PresentImageBatchRequest::set_data_list(int index, const void* value, size_t size) {
+  data_list_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+}
+inline ::std::string* PresentImageBatchRequest::add_data_list() {
+  // @@protoc_insertion_point(field_add_mutable:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+  return data_list_.Add();
+}
+inline void PresentImageBatchRequest::add_data_list(const ::std::string& value) {
+  data_list_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+}
+#if LANG_CXX11
+inline void PresentImageBatchRequest::add_data_list(::std::string&& value) {
+  data_list_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+}
+#endif
+inline void PresentImageBatchRequest::add_data_list(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  data_list_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+}
+inline void PresentImageBatchRequest::add_data_list(const void* value, size_t size) {
+  data_list_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+PresentImageBatchRequest::data_list() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+  return data_list_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+PresentImageBatchRequest::mutable_data_list() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.proto.PresentImageBatchRequest.data_list)
+  return &data_list_;
+}
+
+// -------------------------------------------------------------------
+
+// PresentRoiRequest
+
+// .ascend.presenter.proto.ImageFormat format = 1;
+inline void PresentRoiRequest::clear_format() {
+  format_ = 0;
+}
+inline ::ascend::presenter::proto::ImageFormat PresentRoiRequest::format() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentRoiRequest.format)
+  return static_cast< ::ascend::presenter::proto::ImageFormat >(format_);
+}
+inline void PresentRoiRequest::set_format(::ascend::presenter::proto::ImageFormat value) {
+  
+  format_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentRoiRequest.format)
+}
+
+// uint32 width = 2;
+inline void PresentRoiRequest::clear_width() {
+  width_ = 0u;
+}
+inline ::google::protobuf::uint32 PresentRoiRequest::width() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentRoiRequest.width)
+  return width_;
+}
+inline void PresentRoiRequest::set_width(::google::protobuf::uint32 value) {
+  
+  width_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentRoiRequest.width)
+}
+
+// uint32 height = 3;
+inline void PresentRoiRequest::clear_height() {
+  height_ = 0u;
+}
+inline ::google::protobuf::uint32 PresentRoiRequest::height() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentRoiRequest.height)
+  return height_;
+}
+inline void PresentRoiRequest::set_height(::google::protobuf::uint32 value) {
+  
+  height_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentRoiRequest.height)
+}
+
+// bytes data = 4;
+inline void PresentRoiRequest::clear_data() {
+  data_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& PresentRoiRequest::data() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentRoiRequest.data)
+  return data_.GetNoArena();
+}
+inline void PresentRoiRequest::set_data(const ::std::string& value) {
+  
+  data_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentRoiRequest.data)
+}
+#if LANG_CXX11
+inline void PresentRoiRequest::set_data(::std::string&& value) {
+  
+  data_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.proto.PresentRoiRequest.data)
+}
+#endif
+inline void PresentRoiRequest::set_data(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  data_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.proto.PresentRoiRequest.data)
+}
+inline void PresentRoiRequest::set_data(const void* value, size_t size) {
+  
+  data_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.proto.PresentRoiRequest.data)
+}
+inline ::std::string* PresentRoiRequest::mutable_data() {
+  
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.PresentRoiRequest.data)
+  return data_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* PresentRoiRequest::release_data() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.proto.PresentRoiRequest.data)
+  
+  return data_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void PresentRoiRequest::set_allocated_data(::std::string* data) {
+  if (data != NULL) {
+    
+  } else {
+    
+  }
+  data_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), data);
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.proto.PresentRoiRequest.data)
+}
+
+// repeated .ascend.presenter.proto.Rectangle_Attr rectangle_list = 5;
+inline int PresentRoiRequest::rectangle_list_size() const {
+  return rectangle_list_.size();
+}
+inline void PresentRoiRequest::clear_rectangle_list() {
+  rectangle_list_.Clear();
+}
+inline const ::ascend::presenter::proto::Rectangle_Attr& PresentRoiRequest::rectangle_list(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentRoiRequest.rectangle_list)
+  return rectangle_list_.Get(index);
+}
+inline ::ascend::presenter::proto::Rectangle_Attr* PresentRoiRequest::mutable_rectangle_list(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.PresentRoiRequest.rectangle_list)
+  return rectangle_list_.Mutable(index);
+}
+inline ::ascend::presenter::proto::Rectangle_Attr* PresentRoiRequest::add_rectangle_list() {
+  // @@protoc_insertion_point(field_add:ascend.presenter.proto.PresentRoiRequest.rectangle_list)
+  return rectangle_list_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::Rectangle_Attr >*
+PresentRoiRequest::mutable_rectangle_list() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.proto.PresentRoiRequest.rectangle_list)
+  return &rectangle_list_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::proto::Rectangle_Attr >&
+PresentRoiRequest::rectangle_list() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.proto.PresentRoiRequest.rectangle_list)
+  return rectangle_list_;
+}
+
+// repeated bytes data_list = 6;
+inline int PresentRoiRequest::data_list_size() const {
+  return data_list_.size();
+}
+inline void PresentRoiRequest::clear_data_list() {
+  data_list_.Clear();
+}
+inline const ::std::string& PresentRoiRequest::data_list(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentRoiRequest.data_list)
+  return data_list_.Get(index);
+}
+inline ::std::string* PresentRoiRequest::mutable_data_list(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.PresentRoiRequest.data_list)
+  return data_list_.Mutable(index);
+}
+inline void PresentRoiRequest::set_data_list(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentRoiRequest.data_list)
+  data_list_.Mutable(index)->assign(value);
+}
+#if LANG_CXX11
+inline void PresentRoiRequest::set_data_list(int index, ::std::string&& value) {
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentRoiRequest.data_list)
+  data_list_.Mutable(index)->assign(std::move(value));
+}
+#endif
+inline void PresentRoiRequest::set_data_list(int index, const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  data_list_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.proto.PresentRoiRequest.data_list)
+}
+inline void PresentRoiRequest::set_data_list(int index, const void* value, size_t size) {
+  data_list_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.proto.PresentRoiRequest.data_list)
+}
+inline ::std::string* PresentRoiRequest::add_data_list() {
+  // @@protoc_insertion_point(field_add_mutable:ascend.presenter.proto.PresentRoiRequest.data_list)
+  return data_list_.Add();
+}
+inline void PresentRoiRequest::add_data_list(const ::std::string& value) {
+  data_list_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:ascend.presenter.proto.PresentRoiRequest.data_list)
+}
+#if LANG_CXX11
+inline void PresentRoiRequest::add_data_list(::std::string&& value) {
+  data_list_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:ascend.presenter.proto.PresentRoiRequest.data_list)
+}
+#endif
+inline void PresentRoiRequest::add_data_list(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  data_list_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:ascend.presenter.proto.PresentRoiRequest.data_list)
+}
+inline void PresentRoiRequest::add_data_list(const void* value, size_t size) {
+  data_list_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:ascend.presenter.proto.PresentRoiRequest.data_list)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+PresentRoiRequest::data_list() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.proto.PresentRoiRequest.data_list)
+  return data_list_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+PresentRoiRequest::mutable_data_list() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.proto.PresentRoiRequest.data_list)
+  return &data_list_;
+}
+
+// -------------------------------------------------------------------
+
+// PresentImageChunk
+
+// uint32 frame_id = 1;
+inline void PresentImageChunk::clear_frame_id() {
+  frame_id_ = 0u;
+}
+inline ::google::protobuf::uint32 PresentImageChunk::frame_id() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentImageChunk.frame_id)
+  return frame_id_;
+}
+inline void PresentImageChunk::set_frame_id(::google::protobuf::uint32 value) {
+  
+  frame_id_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentImageChunk.frame_id)
+}
+
+// uint32 index = 2;
+inline void PresentImageChunk::clear_index() {
+  index_ = 0u;
+}
+inline ::google::protobuf::uint32 PresentImageChunk::index() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentImageChunk.index)
+  return index_;
+}
+inline void PresentImageChunk::set_index(::google::protobuf::uint32 value) {
+  
+  index_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentImageChunk.index)
+}
+
+// bool last = 3;
+inline void PresentImageChunk::clear_last() {
+  last_ = false;
+}
+inline bool PresentImageChunk::last() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentImageChunk.last)
+  return last_;
+}
+inline void PresentImageChunk::set_last(bool value) {
+  
+  last_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentImageChunk.last)
+}
+
+// uint32 total_size = 4;
+inline void PresentImageChunk::clear_total_size() {
+  total_size_ = 0u;
+}
+inline ::google::protobuf::uint32 PresentImageChunk::total_size() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentImageChunk.total_size)
+  return total_size_;
+}
+inline void PresentImageChunk::set_total_size(::google::protobuf::uint32 value) {
+  
+  total_size_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentImageChunk.total_size)
+}
+
+// .ascend.presenter.proto.PresentImageRequest image = 5;
+inline bool PresentImageChunk::has_image() const {
+  return this != internal_default_instance() && image_ != NULL;
+}
+inline void PresentImageChunk::clear_image() {
+  if (GetArenaNoVirtual() == NULL && image_ != NULL) {
+    delete image_;
+  }
+  image_ = NULL;
+}
+inline const ::ascend::presenter::proto::PresentImageRequest& PresentImageChunk::image() const {
+  const ::ascend::presenter::proto::PresentImageRequest* p = image_;
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentImageChunk.image)
+  return p != NULL ? *p : *reinterpret_cast<const ::ascend::presenter::proto::PresentImageRequest*>(
+      &::ascend::presenter::proto::_PresentImageRequest_default_instance_);
+}
+inline ::ascend::presenter::proto::PresentImageRequest* PresentImageChunk::release_image() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.proto.PresentImageChunk.image)
+  
+  ::ascend::presenter::proto::PresentImageRequest* temp = image_;
+  image_ = NULL;
+  return temp;
+}
+inline ::ascend::presenter::proto::PresentImageRequest* PresentImageChunk::mutable_image() {
+  
+  if (image_ == NULL) {
+    image_ = new ::ascend::presenter::proto::PresentImageRequest;
+  }
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.PresentImageChunk.image)
+  return image_;
+}
+inline void PresentImageChunk::set_allocated_image(::ascend::presenter::proto::PresentImageRequest* image) {
+  ::google::protobuf::Arena* message_arena = GetArenaNoVirtual();
+  if (message_arena == NULL) {
+    delete image_;
+  }
+  if (image) {
+    ::google::protobuf::Arena* submessage_arena = NULL;
+    if (message_arena != submessage_arena) {
+      image = ::google::protobuf::internal::GetOwnedMessage(
+          message_arena, image, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  image_ = image;
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.proto.PresentImageChunk.image)
+}
+
+// bytes data = 6;
+inline void PresentImageChunk::clear_data() {
+  data_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& PresentImageChunk::data() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.proto.PresentImageChunk.data)
+  return data_.GetNoArena();
+}
+inline void PresentImageChunk::set_data(const ::std::string& value) {
+  
+  data_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:ascend.presenter.proto.PresentImageChunk.data)
+}
+#if LANG_CXX11
+inline void PresentImageChunk::set_data(::std::string&& value) {
+  
+  data_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.proto.PresentImageChunk.data)
+}
+#endif
+inline void PresentImageChunk::set_data(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  data_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.proto.PresentImageChunk.data)
+}
+inline void PresentImageChunk::set_data(const void* value, size_t size) {
+  
+  data_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.proto.PresentImageChunk.data)
+}
+inline ::std::string* PresentImageChunk::mutable_data() {
+  
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.proto.PresentImageChunk.data)
+  return data_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* PresentImageChunk::release_data() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.proto.PresentImageChunk.data)
+  
+  return data_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void PresentImageChunk::set_allocated_data(::std::string* data) {
+  if (data != NULL) {
+    
+  } else {
+    
+  }
+  data_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), data);
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.proto.PresentImageChunk.data)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -1550,6 +2533,12 @@ inline void PresentImageResponse::set_allocated_error_message(::std::string* err
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -1570,6 +2559,11 @@ template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::ascend::presenter::proto::ChannelContentType>() {
   return ::ascend::presenter::proto::ChannelContentType_descriptor();
 }
+template <> struct is_proto_enum< ::ascend::presenter::proto::CompressionType> : ::google::protobuf::internal::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::ascend::presenter::proto::CompressionType>() {
+  return ::ascend::presenter::proto::CompressionType_descriptor();
+}
 template <> struct is_proto_enum< ::ascend::presenter::proto::ImageFormat> : ::google::protobuf::internal::true_type {};
 template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::ascend::presenter::proto::ImageFormat>() {
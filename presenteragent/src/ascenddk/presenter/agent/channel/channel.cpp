@@ -32,17 +32,40 @@
  */
 
 #include "ascenddk/presenter/agent/channel/default_channel.h"
+#include "ascenddk/presenter/agent/channel/event_loop_channel.h"
+#include "ascenddk/presenter/agent/runtime/agent_runtime.h"
 
 namespace ascend {
 namespace presenter {
 
+CompressionParam InitChannelHandler::GetCompression() const {
+  return CompressionParam();
+}
+
+PresenterErrorCode Channel::SendMessageAsync(
+    const PartialMessageWithTlvs& message, const ResponseCallback& callback) {
+  std::unique_ptr<google::protobuf::Message> response;
+  PresenterErrorCode error_code = SendMessage(message, response);
+  if (error_code == PresenterErrorCode::kNone && callback) {
+    callback(error_code, response);
+  }
+
+  return error_code;
+}
+
 Channel* ChannelFactory::NewChannel(const std::string& host_ip, uint16_t port) {
-  return DefaultChannel::NewChannel(host_ip, port, nullptr);
+  return NewChannel(host_ip, port, nullptr);
 }
 
 Channel* ChannelFactory::NewChannel(
     const std::string& host_ip, uint16_t port,
     std::shared_ptr<InitChannelHandler> handler) {
+  // served by the shared event loops if agent runtime is started
+  std::shared_ptr<EventLoop> loop = AgentRuntime::GetInstance().GetEventLoop();
+  if (loop != nullptr) {
+    return EventLoopChannel::NewChannel(loop, host_ip, port, handler);
+  }
+
   return DefaultChannel::NewChannel(host_ip, port, handler);
 }
 
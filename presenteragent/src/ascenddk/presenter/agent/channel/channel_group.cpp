@@ -0,0 +1,205 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/channel_group.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <google/protobuf/message.h>
+
+#include "ascenddk/presenter/agent/channel/default_channel.h"
+#include "ascenddk/presenter/agent/channel/event_loop_channel.h"
+#include "ascenddk/presenter/agent/codec/message_codec.h"
+#include "ascenddk/presenter/agent/util/logging.h"
+
+using namespace std;
+using namespace google::protobuf;
+
+namespace {
+
+// connections fail pending requests after their own timeouts, this is only
+// a guard in case a loop thread is gone
+const int kWaitTimeoutInSec = 10;
+
+// results of the members sent by the loop threads
+struct GroupCall {
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t remaining = 0;
+  std::vector<ascend::presenter::PresenterErrorCode> results;
+  std::vector<std::unique_ptr<Message>> responses;
+
+  void Complete(size_t index, ascend::presenter::PresenterErrorCode code,
+                std::unique_ptr<Message>& resp) {
+    std::lock_guard<std::mutex> lock(mtx);
+    results[index] = code;
+    responses[index] = std::move(resp);
+    if (--remaining == 0) {
+      cv.notify_one();
+    }
+  }
+
+  bool Wait() {
+    std::unique_lock<std::mutex> lock(mtx);
+    return cv.wait_for(lock, std::chrono::seconds(kWaitTimeoutInSec),
+                       [this]() {return remaining == 0;});
+  }
+};
+
+}
+
+namespace ascend {
+namespace presenter {
+
+PresenterErrorCode ChannelGroup::AddChannel(Channel *channel) {
+  if (channel == nullptr) {
+    AGENT_LOG_ERROR("channel is NULL");
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  channels_.push_back(channel);
+  return PresenterErrorCode::kNone;
+}
+
+const vector<Channel*>& ChannelGroup::GetChannels() const {
+  return channels_;
+}
+
+PresenterErrorCode ChannelGroup::SendMessage(
+    const PartialMessageWithTlvs& message,
+    vector<unique_ptr<Message>>& responses,
+    vector<PresenterErrorCode>& results) {
+  size_t size = channels_.size();
+  responses.clear();
+  responses.resize(size);
+  results.assign(size, PresenterErrorCode::kOther);
+  if (size == 0 || message.message == nullptr) {
+    AGENT_LOG_ERROR("channel group is empty or message is null");
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  // encode once for all members
+  MessageCodec codec;
+  vector<SharedByteBuffer> buffers;
+  try {
+    if (!codec.EncodeMessage(message, buffers)) {
+      AGENT_LOG_ERROR("Failed to encode message");
+      return PresenterErrorCode::kCodec;
+    }
+  } catch (std::exception &e) {  // protobuf may throw FatalException
+    AGENT_LOG_ERROR("Protobuf error: %s", e.what());
+    return PresenterErrorCode::kCodec;
+  }
+
+  shared_ptr<GroupCall> call(new (nothrow) GroupCall());
+  if (call == nullptr) {
+    return PresenterErrorCode::kBadAlloc;
+  }
+
+  // a member whose callback has not run when waiting ends is timed out
+  call->results.assign(size, PresenterErrorCode::kSocketTimeout);
+  call->responses.resize(size);
+
+  // start the members served by loop threads first, they are sent while
+  // the blocking members are sent in this thread
+  vector<bool> is_async(size, false);
+  for (size_t i = 0; i < size; ++i) {
+    EventLoopChannel *channel = dynamic_cast<EventLoopChannel*>(channels_[i]);
+    if (channel == nullptr) {
+      continue;
+    }
+
+    {
+      lock_guard<mutex> lock(call->mtx);
+      ++call->remaining;
+    }
+
+    PresenterErrorCode error_code = channel->SendEncodedMessageAsync(
+        buffers, [call, i](PresenterErrorCode code, unique_ptr<Message>& resp) {
+          call->Complete(i, code, resp);
+        });
+    if (error_code != PresenterErrorCode::kNone) {
+      lock_guard<mutex> lock(call->mtx);
+      --call->remaining;
+      results[i] = error_code;
+      continue;
+    }
+
+    is_async[i] = true;
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    if (dynamic_cast<EventLoopChannel*>(channels_[i]) != nullptr) {
+      continue;
+    }
+
+    DefaultChannel *channel = dynamic_cast<DefaultChannel*>(channels_[i]);
+    if (channel != nullptr) {
+      results[i] = channel->SendEncodedMessage(buffers, responses[i]);
+    } else {  // unknown channel type can only send the message itself
+      results[i] = channels_[i]->SendMessage(message, responses[i]);
+    }
+  }
+
+  if (!call->Wait()) {
+    AGENT_LOG_ERROR("Timeout when waiting for members of channel group");
+  }
+
+  {
+    lock_guard<mutex> lock(call->mtx);
+    for (size_t i = 0; i < size; ++i) {
+      if (is_async[i]) {
+        results[i] = call->results[i];
+        responses[i] = std::move(call->responses[i]);
+      }
+    }
+  }
+
+  PresenterErrorCode ret = PresenterErrorCode::kNone;
+  for (size_t i = 0; i < size; ++i) {
+    if (results[i] != PresenterErrorCode::kNone) {
+      AGENT_LOG_ERROR("Failed to send message to member %zu, error = %d", i,
+                      static_cast<int>(results[i]));
+      responses[i].reset();
+      if (ret == PresenterErrorCode::kNone) {
+        ret = results[i];
+      }
+    }
+  }
+
+  return ret;
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
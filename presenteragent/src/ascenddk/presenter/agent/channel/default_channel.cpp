@@ -41,6 +41,7 @@
 #include "proto/presenter_message.pb.h"
 
 #include "ascenddk/presenter/agent/channel/default_channel.h"
+#include "ascenddk/presenter/agent/channel/sync_call.h"
 #include "ascenddk/presenter/agent/net/raw_socket_factory.h"
 #include "ascenddk/presenter/agent/util/logging.h"
 
@@ -49,6 +50,14 @@ using namespace google::protobuf;
 
 namespace {
 const int HEARTBEAT_INTERVAL = 1500;  // 1.5s
+
+// the writer thread fails requests after the socket timeout, this is only
+// a guard in case it is stuck. Callers lending TLVs to the writer thread
+// keep waiting after it, until their message is done with
+const int kWaitTimeoutInSec = 10;
+
+// blocking callers retry to queue their message when the queue is full
+const int kSpaceWaitIntervalInMs = 10;
 }
 
 namespace ascend {
@@ -81,14 +90,25 @@ DefaultChannel* DefaultChannel::NewChannel(
 DefaultChannel::DefaultChannel(std::shared_ptr<SocketFactory> socket_factory)
     : socket_factory_(socket_factory),
       open_(false),
-      disposed_(false) {
+      disposed_(false),
+      space_waiters_(0),
+      writer_waiting_(false),
+      writer_id_(thread::id()) {
+  atomic_store(&compression_, shared_ptr<const CompressionParam>(
+      new (nothrow) CompressionParam()));
 }
 
 DefaultChannel::~DefaultChannel() {
-  disposed_ = true;
+  {
+    lock_guard<mutex> lock(mtx_);
+    disposed_ = true;
+  }
+  cv_wakeup_.notify_one();
   if (heartbeat_thread_ != nullptr) {
     heartbeat_thread_->join();
   }
+
+  FailQueuedMessages();
 }
 
 void DefaultChannel::SetInitChannelHandler(
@@ -105,7 +125,8 @@ PresenterErrorCode DefaultChannel::HandleInitialization(
   // send init request
   PresenterErrorCode error_code = conn_->SendMessage(message);
   if (error_code != PresenterErrorCode::kNone) {
-    AGENT_LOG_ERROR("Failed to send init request, %d", error_code);
+    AGENT_LOG_ERROR("Failed to send init request, %d",
+                    static_cast<int>(error_code));
     return error_code;
   }
 
@@ -113,7 +134,8 @@ PresenterErrorCode DefaultChannel::HandleInitialization(
   unique_ptr<Message> resp;
   error_code = conn_->ReceiveMessage(resp);
   if (error_code != PresenterErrorCode::kNone) {
-    AGENT_LOG_ERROR("Failed to send init response, %d", error_code);
+    AGENT_LOG_ERROR("Failed to send init response, %d",
+                    static_cast<int>(error_code));
     return error_code;
   }
 
@@ -123,6 +145,17 @@ PresenterErrorCode DefaultChannel::HandleInitialization(
     return PresenterErrorCode::kAppDefinedError;
   }
 
+  // published as a new object, callers encoding with the old one are not
+  // affected
+  CompressionParam compression = init_channel_handler_->GetCompression();
+  shared_ptr<const CompressionParam> published(
+      new (nothrow) CompressionParam(compression));
+  if (published == nullptr) {
+    return PresenterErrorCode::kBadAlloc;
+  }
+
+  atomic_store(&compression_, published);
+  conn_->SetCompression(compression);
   return PresenterErrorCode::kNone;
 }
 
@@ -143,7 +176,8 @@ PresenterErrorCode DefaultChannel::Open() {
   PresenterErrorCode error_code = socket_factory_->GetErrorCode();
   //ʾ쳣򴴽ʧ
   if (error_code != PresenterErrorCode::kNone) {
-    AGENT_LOG_ERROR("Failed to create socket, %d", error_code);
+    AGENT_LOG_ERROR("Failed to create socket, %d",
+                    static_cast<int>(error_code));
     return error_code;
   }
   //һӣConnectionʵ.ConnectionĹ캯ֻǱsock,
@@ -187,19 +221,126 @@ void DefaultChannel::StartHeartbeatThread() {
 }
 
 void DefaultChannel::KeepAlive() {
+  writer_id_ = this_thread::get_id();
   chrono::milliseconds heartbeatInterval(HEARTBEAT_INTERVAL);
+  chrono::steady_clock::time_point next_heartbeat = chrono::steady_clock::now();
   while (!disposed_) {
-    SendHeartbeat();
+    SendQueuedMessages();
+    if (chrono::steady_clock::now() >= next_heartbeat) {
+      SendHeartbeat();
+      next_heartbeat = chrono::steady_clock::now() + heartbeatInterval;
+    }
+
+    // read one response, then send the messages queued meanwhile, so
+    // requests are pipelined instead of waiting for each other
+    if (!in_flight_.empty()) {
+      ReceiveResponse();
+      continue;
+    }
 
-    // interruptable wait
+    // interruptable wait, producers notify only if the writer is waiting.
+    // writer_waiting_ is set before checking the queue, and producers push
+    // before checking writer_waiting_, both with a fence in between, so
+    // either of them sees the other
     unique_lock<mutex> lock(mtx_);
-    cv_shutdown_.wait_for(lock, heartbeatInterval,
-                         [this]() {return disposed_.load();});
+    writer_waiting_ = true;
+    atomic_thread_fence(memory_order_seq_cst);
+    cv_wakeup_.wait_until(lock, next_heartbeat, [this]() {
+      return disposed_.load() || !send_queue_.Empty();
+    });
+    writer_waiting_ = false;
   }
 
+  Disconnect(PresenterErrorCode::kConnection);
   AGENT_LOG_DEBUG("heartbeat thread ended");
 }
 
+void DefaultChannel::SendQueuedMessages() {
+  bool popped = false;
+  QueuedMessage message;
+  while (in_flight_.size() < kMaxInFlightMessages
+      && send_queue_.TryPop(message)) {
+    popped = true;
+    PresenterErrorCode error_code = PresenterErrorCode::kConnection;
+    if (open_) {
+      error_code = WriteBuffers(message.buffers, message.tlv_list);
+    }
+
+    if (error_code == PresenterErrorCode::kNone && message.expect_response) {
+      in_flight_.push_back(std::move(message.callback));
+      continue;
+    }
+
+    if (message.callback) {
+      unique_ptr<Message> no_response;
+      message.callback(error_code, no_response);
+    }
+  }
+
+  if (popped && space_waiters_ > 0) {
+    lock_guard<mutex> lock(mtx_);
+    cv_space_.notify_all();
+  }
+}
+
+void DefaultChannel::ReceiveResponse() {
+  unique_ptr<Message> response;
+  PresenterErrorCode error_code = PresenterErrorCode::kOther;
+  try {
+    error_code = conn_->ReceiveMessage(response);
+  } catch (std::exception &e) {  // protobuf may throw FatalException
+    AGENT_LOG_ERROR("Protobuf error: %s", e.what());
+  }
+
+  // a late response would be matched to the wrong request, the requests
+  // in flight are failed with the connection
+  if (error_code != PresenterErrorCode::kNone) {
+    AGENT_LOG_ERROR("Failed to receive response, %d",
+                    static_cast<int>(error_code));
+    Disconnect(error_code);
+    return;
+  }
+
+  ResponseCallback callback = std::move(in_flight_.front());
+  in_flight_.pop_front();
+  if (callback) {
+    callback(error_code, response);
+  }
+}
+
+PresenterErrorCode DefaultChannel::WriteBuffers(
+    const vector<SharedByteBuffer>& buffers, const vector<Tlv>& tlv_list) {
+  PresenterErrorCode error_code = conn_->SendEncodedMessage(buffers, tlv_list);
+  // a partly sent message breaks the stream, enable retry
+  if (error_code != PresenterErrorCode::kNone) {
+    Disconnect(error_code);
+  }
+
+  return error_code;
+}
+
+void DefaultChannel::Disconnect(PresenterErrorCode error_code) {
+  open_ = false;
+  deque<ResponseCallback> in_flight;
+  in_flight.swap(in_flight_);
+  for (auto it = in_flight.begin(); it != in_flight.end(); ++it) {
+    if (*it) {
+      unique_ptr<Message> no_response;
+      (*it)(error_code, no_response);
+    }
+  }
+}
+
+void DefaultChannel::FailQueuedMessages() {
+  QueuedMessage message;
+  while (send_queue_.TryPop(message)) {
+    if (message.callback) {
+      unique_ptr<Message> no_response;
+      message.callback(PresenterErrorCode::kConnection, no_response);
+    }
+  }
+}
+
 void DefaultChannel::SendHeartbeat() {
   // reopen channel if disconnected
   if (!open_) {
@@ -208,15 +349,129 @@ void DefaultChannel::SendHeartbeat() {
     }
   }
 
-  // construct a heartbeat message then send it
+  // construct a heartbeat message then send it, no response is expected
   proto::HeartbeatMessage heartbeat_msg;
-  SendMessage(heartbeat_msg);
+  PartialMessageWithTlvs heartbeat;
+  heartbeat.message = &heartbeat_msg;
+  vector<SharedByteBuffer> buffers;
+  if (Encode(heartbeat, true, buffers) == PresenterErrorCode::kNone) {
+    (void) WriteBuffers(buffers, heartbeat.tlv_list);
+  }
+}
+
+PresenterErrorCode DefaultChannel::Encode(const PartialMessageWithTlvs& message,
+                                          bool copy_tlvs,
+                                          vector<SharedByteBuffer>& buffers) {
+  if (message.message == nullptr) {
+    AGENT_LOG_ERROR("message is null");
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  // encode in caller's thread, the message can be released once returned
+  MessageCodec codec;
+  shared_ptr<const CompressionParam> compression = atomic_load(&compression_);
+  if (compression != nullptr) {
+    codec.SetCompression(*compression);
+  }
+
+  try {
+    if (copy_tlvs) {
+      if (!codec.EncodeMessage(message, buffers)) {
+        AGENT_LOG_ERROR("Failed to encode message");
+        return PresenterErrorCode::kCodec;
+      }
+
+      return PresenterErrorCode::kNone;
+    }
+
+    // the header only, the TLVs follow it in the stream
+    SharedByteBuffer buffer = codec.EncodeMessage(message);
+    if (buffer.IsEmpty()) {
+      AGENT_LOG_ERROR("Failed to encode message");
+      return PresenterErrorCode::kCodec;
+    }
+
+    buffers.push_back(buffer);
+  } catch (std::exception &e) {  // protobuf may throw FatalException
+    AGENT_LOG_ERROR("Protobuf error: %s", e.what());
+    return PresenterErrorCode::kCodec;
+  }
+
+  return PresenterErrorCode::kNone;
+}
+
+PresenterErrorCode DefaultChannel::SendAndWait(
+    const vector<SharedByteBuffer>& buffers, const vector<Tlv>& tlv_list,
+    bool expect_response, unique_ptr<Message>* response) {
+  if (!open_) {
+    AGENT_LOG_ERROR("Channel is not open, send message failed");
+    return PresenterErrorCode::kConnection;
+  }
+
+  // the writer thread would wait for itself
+  if (this_thread::get_id() == writer_id_.load()) {
+    AGENT_LOG_ERROR("Blocking send in a callback of the channel");
+    return PresenterErrorCode::kOther;
+  }
+
+  shared_ptr<SyncCall> call(new (nothrow) SyncCall());
+  if (call == nullptr) {
+    return PresenterErrorCode::kBadAlloc;
+  }
+
+  QueuedMessage message;
+  message.buffers = buffers;
+  message.tlv_list = tlv_list;
+  message.expect_response = expect_response;
+  message.callback = [call](PresenterErrorCode code,
+                            unique_ptr<Message>& resp) {
+    call->Complete(code, &resp);
+  };
+
+  // blocking callers wait for room in the queue rather than failing
+  chrono::steady_clock::time_point deadline = chrono::steady_clock::now()
+      + chrono::seconds(kWaitTimeoutInSec);
+  while (!send_queue_.TryPush(std::move(message))) {
+    if (!open_ || disposed_ || chrono::steady_clock::now() >= deadline) {
+      AGENT_LOG_ERROR("Failed to queue message, channel is busy or closed");
+      return PresenterErrorCode::kConnection;
+    }
+
+    ++space_waiters_;
+    {
+      unique_lock<mutex> lock(mtx_);
+      cv_space_.wait_for(lock, chrono::milliseconds(kSpaceWaitIntervalInMs));
+    }
+    --space_waiters_;
+  }
+
+  // pairs with the fence in KeepAlive()
+  atomic_thread_fence(memory_order_seq_cst);
+  if (writer_waiting_) {
+    lock_guard<mutex> lock(mtx_);
+    cv_wakeup_.notify_one();
+  }
+
+  while (!call->Wait(kWaitTimeoutInSec)) {
+    if (tlv_list.empty()) {
+      AGENT_LOG_ERROR("Timeout when sending message");
+      return PresenterErrorCode::kSocketTimeout;
+    }
+
+    AGENT_LOG_WARN("Still waiting for the TLVs to be sent");
+  }
+
+  if (response != nullptr) {
+    *response = std::move(call->response);
+  }
+
+  return call->error_code;
 }
 
 PresenterErrorCode DefaultChannel::SendMessage(const Message& message) {
   PartialMessageWithTlvs msg;
-  string msg_name = message.GetDescriptor()->full_name();
-  AGENT_LOG_DEBUG("To send message: %s", msg_name.c_str());
+  AGENT_LOG_DEBUG("To send message: %s",
+                  message.GetDescriptor()->full_name().c_str());
   msg.message = &message;
   return SendMessage(msg);
 }
@@ -229,77 +484,98 @@ PresenterErrorCode DefaultChannel::SendMessage(
     return PresenterErrorCode::kConnection;
   }
 
-  PresenterErrorCode errorCode = PresenterErrorCode::kOther;
-  try {
-	//PresenterErrorCode Connection::SendMessageϢ.conn_ڴͨOpenɹ󴴽,agentserver֮tcp socket
-    errorCode = conn_->SendMessage(message);
-    //connect error, set is_open to false, enable retry
-    if (errorCode == PresenterErrorCode::kConnection) {
-      open_ = false;
-    }
-  } catch (std::exception &e) {  // protobuf may throw FatalException
-    AGENT_LOG_ERROR("Protobuf error: %s", e.what());
-    open_ = false;
+  // the TLVs are sent from caller's memory, it waits until they are sent
+  vector<SharedByteBuffer> buffers;
+  PresenterErrorCode error_code = Encode(message, false, buffers);
+  if (error_code != PresenterErrorCode::kNone) {
+    return error_code;
   }
 
-  return errorCode;
+  return SendAndWait(buffers, message.tlv_list, false, nullptr);
 }
 
-PresenterErrorCode DefaultChannel::ReceiveMessage(
-    unique_ptr<Message>& message) {
-  AGENT_LOG_DEBUG("To receive message");
-  //ͨΪ״̬
+PresenterErrorCode DefaultChannel::SendMessageAsync(
+    const PartialMessageWithTlvs& message, const ResponseCallback& callback) {
   if (!open_) {
-    AGENT_LOG_ERROR("Channel is not open, receive message failed");
+    AGENT_LOG_ERROR("Channel is not open, send message failed");
     return PresenterErrorCode::kConnection;
   }
 
-  PresenterErrorCode error_code = PresenterErrorCode::kOther;
-  try {
-	//ConnectionReceiveMessageϢ
-    error_code = conn_->ReceiveMessage(message);
-    // connect error and codec error, set is_open to false, enable retry
-    if (error_code == PresenterErrorCode::kConnection
-        || error_code == PresenterErrorCode::kCodec) {
-      open_ = false;
-    }
+  // the caller may release the message once returned, copy the TLVs
+  vector<SharedByteBuffer> buffers;
+  PresenterErrorCode error_code = Encode(message, true, buffers);
+  if (error_code != PresenterErrorCode::kNone) {
+    return error_code;
+  }
 
-  } catch (std::exception &e) {  // protobuf may throw FatalException
-    AGENT_LOG_ERROR("Protobuf error: %s", e.what());
-    open_ = false;
+  return SendEncodedMessageAsync(buffers, callback);
+}
+
+PresenterErrorCode DefaultChannel::SendEncodedMessageAsync(
+    const vector<SharedByteBuffer>& buffers, const ResponseCallback& callback) {
+  if (!open_) {
+    AGENT_LOG_ERROR("Channel is not open, send message failed");
+    return PresenterErrorCode::kConnection;
   }
 
-  return error_code;
+  QueuedMessage message;
+  message.buffers = buffers;
+  message.callback = callback;
+  if (!send_queue_.TryPush(std::move(message))) {
+    AGENT_LOG_ERROR("Too many messages queued: %zu", kMaxQueuedMessages);
+    return PresenterErrorCode::kOther;
+  }
+
+  // pairs with the fence in KeepAlive()
+  atomic_thread_fence(memory_order_seq_cst);
+  if (writer_waiting_) {
+    lock_guard<mutex> lock(mtx_);
+    cv_wakeup_.notify_one();
+  }
+
+  return PresenterErrorCode::kNone;
+}
+
+PresenterErrorCode DefaultChannel::ReceiveMessage(
+    unique_ptr<Message>& message) {
+  AGENT_LOG_DEBUG("To receive message");
+  // nothing is sent, the writer thread reads the next message for it
+  vector<SharedByteBuffer> no_buffers;
+  return SendAndWait(no_buffers, vector<Tlv>(), true, &message);
 }
 
 PresenterErrorCode DefaultChannel::SendMessage(
     const google::protobuf::Message& message,
     std::unique_ptr<google::protobuf::Message> &response) {
-  string msg_name = message.GetDescriptor()->full_name();
-  AGENT_LOG_DEBUG("To send message: %s", msg_name.c_str());
-  PresenterErrorCode error_code = SendMessage(message);
-  if (error_code == PresenterErrorCode::kNone) {
-    error_code = ReceiveMessage(response);
-  }
-
-  return error_code;
+  AGENT_LOG_DEBUG("To send message: %s",
+                  message.GetDescriptor()->full_name().c_str());
+  PartialMessageWithTlvs msg;
+  msg.message = &message;
+  return SendMessage(msg, response);
 }
 
 PresenterErrorCode DefaultChannel::SendMessage(
     const PartialMessageWithTlvs& message,
     std::unique_ptr<google::protobuf::Message> &response) {
-  //ȡprotoļжģԭʼݵ.PartialMessageWithTlvsĴ:
-  //APP-->protoݸʽ-->PartialMessageWithTlvstlv.protoʽΪPartialMessageWithTlvsʱ,protoݵømessageԱ
-  string msg_name = message.message->GetDescriptor()->full_name();
-  AGENT_LOG_DEBUG("To send message: %s", msg_name.c_str());
-  //PartialMessageWithTlvsݸserverˣPresenterErrorCode DefaultChannel::SendMessage(const PartialMessageWithTlvs& message)
-  PresenterErrorCode error_code = SendMessage(message);
-  if (error_code == PresenterErrorCode::kNone) {
-	//ݷͳɹ,ȴserverӦ
-    error_code = ReceiveMessage(response);
+  if (!open_) {
+    AGENT_LOG_ERROR("Channel is not open, send message failed");
+    return PresenterErrorCode::kConnection;
   }
 
-  return error_code;
+  vector<SharedByteBuffer> buffers;
+  PresenterErrorCode error_code = Encode(message, false, buffers);
+  if (error_code != PresenterErrorCode::kNone) {
+    return error_code;
+  }
+
+  // the writer thread sends it and matches the response
+  return SendAndWait(buffers, message.tlv_list, true, &response);
+}
+
+PresenterErrorCode DefaultChannel::SendEncodedMessage(
+    const std::vector<SharedByteBuffer>& buffers,
+    std::unique_ptr<google::protobuf::Message> &response) {
+  return SendAndWait(buffers, vector<Tlv>(), true, &response);
 }
 
 const std::string& DefaultChannel::GetDescription() const {
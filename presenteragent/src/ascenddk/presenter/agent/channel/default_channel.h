@@ -37,19 +37,27 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "ascenddk/presenter/agent/connection/connection.h"
 #include "ascenddk/presenter/agent/channel.h"
+#include "ascenddk/presenter/agent/util/mpsc_queue.h"
 
 namespace ascend {
 namespace presenter {
 
 /**
- * Default channel implementation
+ * Default channel implementation. All messages are sent by the writer
+ * thread of the channel: callers encode their messages and queue them, the
+ * writer sends them back to back and matches the responses in FIFO order,
+ * so callers sharing a channel do not wait for each other's round trips.
+ * Callbacks of SendMessageAsync() run in the writer thread, they must not
+ * block, and must not call the blocking methods of the channel
  */
 class DefaultChannel : public Channel {
  public:
@@ -110,13 +118,48 @@ class DefaultChannel : public Channel {
       std::unique_ptr<google::protobuf::Message>& response) override;
 
   /**
-   * @brief recevice a response
+   * @brief recevice the next message not matched to a request, it is
+   *        queued like a request without sending anything
    * @param [out] response            response
    * @return PresenterErrorCode
    */
   virtual PresenterErrorCode ReceiveMessage(
       std::unique_ptr<google::protobuf::Message>& response) override;
 
+  /**
+   * @brief send a message encoded by MessageCodec and read the response
+   * @param [in] buffers              encoded buffers, in sending order
+   * @pararm [out] response           response
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode SendEncodedMessage(
+      const std::vector<SharedByteBuffer>& buffers,
+      std::unique_ptr<google::protobuf::Message>& response);
+
+  /**
+   * @brief encode the message in caller's thread and queue it, the writer
+   *        thread of the channel sends it and reads the response. Callers
+   *        only pay for the encoding and a lock-free enqueue
+   * @param [in] message              message
+   * @param [in] callback             invoked in the writer thread once,
+   *                                  only if kNone is returned
+   * @return PresenterErrorCode, kOther if the queue is full
+   */
+  virtual PresenterErrorCode SendMessageAsync(
+      const PartialMessageWithTlvs& message,
+      const ResponseCallback& callback) override;
+
+  /**
+   * @brief queue a message encoded by MessageCodec, the buffers are shared
+   *        rather than copied
+   * @param [in] buffers              encoded buffers, in sending order
+   * @param [in] callback             same as SendMessageAsync()
+   * @return PresenterErrorCode, kOther if the queue is full
+   */
+  PresenterErrorCode SendEncodedMessageAsync(
+      const std::vector<SharedByteBuffer>& buffers,
+      const ResponseCallback& callback);
+
   /**
    * @brief set InitChannelHandler
    * @param [in] handler              handler
@@ -160,19 +203,84 @@ class DefaultChannel : public Channel {
   void StartHeartbeatThread();
 
   /**
-   * @brief Task to keep the channel alive
+   * @brief Task of the writer thread, sends queued messages and keeps the
+   *        channel alive
    */
   void KeepAlive();
 
   /**
-   * @brief Send heartbeat message to server
+   * @brief Send queued messages back to back, writer thread only
+   */
+  void SendQueuedMessages();
+
+  /**
+   * @brief Receive a response and invoke the callback of the earliest
+   *        request waiting for it, writer thread only
+   */
+  void ReceiveResponse();
+
+  /**
+   * @brief Write encoded buffers to the connection, writer thread only
+   * @param [in] buffers              encoded buffers, in sending order
+   * @param [in] tlv_list             TLVs sent after the buffers
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode WriteBuffers(const std::vector<SharedByteBuffer>& buffers,
+                                  const std::vector<Tlv>& tlv_list);
+
+  /**
+   * @brief Mark the connection broken and fail the requests waiting for
+   *        responses, it is reopened by the next heartbeat, writer thread
+   *        only
+   * @param [in] error_code           error passed to the callbacks
+   */
+  void Disconnect(PresenterErrorCode error_code);
+
+  /**
+   * @brief Fail the queued messages, when the channel is destroyed
+   */
+  void FailQueuedMessages();
+
+  /**
+   * @brief Send heartbeat message to server, writer thread only
    */
   void SendHeartbeat();
 
+  /**
+   * @brief Encode a message with the compression accepted by the server
+   * @param [in] message              message
+   * @param [in] copy_tlvs            whether to copy the TLVs into buffers,
+   *                                  or to leave them to the caller
+   * @param [out] buffers             encoded buffers
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode Encode(const PartialMessageWithTlvs& message,
+                            bool copy_tlvs,
+                            std::vector<SharedByteBuffer>& buffers);
+
+  /**
+   * @brief Queue encoded buffers and wait for the writer thread to send
+   *        them, and to receive the response if expected
+   * @param [in] buffers              encoded buffers, in sending order
+   * @param [in] tlv_list             TLVs sent after the buffers, the
+   *                                  values are not copied
+   * @param [in] expect_response      whether to wait for a response
+   * @param [out] response            response, not used if NULL
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode SendAndWait(const std::vector<SharedByteBuffer>& buffers,
+                                 const std::vector<Tlv>& tlv_list,
+                                 bool expect_response,
+                                 std::unique_ptr<google::protobuf::Message>*
+                                     response);
+
  private:
   std::shared_ptr<SocketFactory> socket_factory_;
   std::shared_ptr<InitChannelHandler> init_channel_handler_;
   std::unique_ptr<Connection> conn_;
+  // compression accepted by the server, for messages encoded by callers.
+  // Never modified once published, replaced by atomic_store() on reconnect
+  std::shared_ptr<const CompressionParam> compression_;
 
   // indicating whether the socket is valid
   std::atomic_bool open_;
@@ -180,9 +288,35 @@ class DefaultChannel : public Channel {
   std::atomic_bool disposed_;
 
   std::mutex mtx_;
-  std::condition_variable cv_shutdown_;
+  // wakes up the writer thread, for shutdown or queued messages
+  std::condition_variable cv_wakeup_;
+  // wakes up blocking callers waiting for room in the queue
+  std::condition_variable cv_space_;
+  std::atomic<int> space_waiters_;
+  // the writer thread, it is also the heartbeat thread
   std::unique_ptr<std::thread> heartbeat_thread_;
 
+  // a message queued for the writer thread, the callback is invoked once
+  // it is sent, or once its response is received if expected. TLV values
+  // are borrowed from a blocking caller, which waits for the callback
+  struct QueuedMessage {
+    std::vector<SharedByteBuffer> buffers;
+    std::vector<Tlv> tlv_list;
+    bool expect_response = true;
+    ResponseCallback callback;
+  };
+
+  static const size_t kMaxQueuedMessages = 64;
+  BoundedMpscQueue<QueuedMessage, kMaxQueuedMessages> send_queue_;
+  // whether the writer thread is waiting on cv_wakeup_
+  std::atomic_bool writer_waiting_;
+  std::atomic<std::thread::id> writer_id_;
+
+  // callbacks of the requests sent and waiting for responses, in sending
+  // order, writer thread only
+  static const size_t kMaxInFlightMessages = 64;
+  std::deque<ResponseCallback> in_flight_;
+
   std::string description_;
 };
 
@@ -0,0 +1,237 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/channel/event_loop_channel.h"
+
+#include <chrono>
+
+#include "ascenddk/presenter/agent/channel/sync_call.h"
+#include "ascenddk/presenter/agent/util/logging.h"
+
+using namespace std;
+using namespace google::protobuf;
+
+namespace {
+
+// connection fails pending requests after its own timeouts, this is only
+// a guard in case the loop thread is gone
+const int kWaitTimeoutInSec = 10;
+
+// same as the socket timeout of RawSocketFactory
+const int kReceiveTimeoutInSec = 3;
+
+// unsolicited messages kept for ReceiveMessage()
+const size_t kMaxReceivedMessages = 64;
+
+}
+
+namespace ascend {
+namespace presenter {
+
+EventLoopChannel* EventLoopChannel::NewChannel(
+    shared_ptr<EventLoop> loop, const string& host_ip, uint16_t port,
+    shared_ptr<InitChannelHandler> handler) {
+  if (loop == nullptr) {
+    AGENT_LOG_ERROR("event loop is null");
+    return nullptr;
+  }
+
+  EventLoopChannel *channel = new (nothrow) EventLoopChannel(loop, handler);
+  if (channel == nullptr) {
+    return nullptr;
+  }
+
+  channel->conn_ = AsyncConnection::New(loop.get(), host_ip, port, handler);
+  if (channel->conn_ == nullptr) {
+    delete channel;
+    return nullptr;
+  }
+
+  channel->conn_->SetMessageListener(
+      [channel](unique_ptr<Message>& message) {
+        channel->OnMessage(message);
+      });
+  return channel;
+}
+
+EventLoopChannel::EventLoopChannel(shared_ptr<EventLoop> loop,
+                                   shared_ptr<InitChannelHandler> handler)
+    : loop_(loop),
+      init_channel_handler_(handler) {
+}
+
+EventLoopChannel::~EventLoopChannel() {
+  // no callback is invoked after shutdown
+  if (conn_ != nullptr) {
+    conn_->Shutdown();
+  }
+}
+
+shared_ptr<const InitChannelHandler> EventLoopChannel::GetInitChannelHandler() {
+  return init_channel_handler_;
+}
+
+PresenterErrorCode EventLoopChannel::Open() {
+  shared_ptr<SyncCall> call(new (nothrow) SyncCall());
+  if (call == nullptr) {
+    return PresenterErrorCode::kBadAlloc;
+  }
+
+  conn_->Open([call](PresenterErrorCode error_code) {
+    call->Complete(error_code, nullptr);
+  });
+
+  if (!call->Wait(kWaitTimeoutInSec)) {
+    AGENT_LOG_ERROR("Timeout when opening channel");
+    return PresenterErrorCode::kSocketTimeout;
+  }
+
+  return call->error_code;
+}
+
+PresenterErrorCode EventLoopChannel::SendAndWait(
+    const PartialMessageWithTlvs& message, bool expect_response,
+    unique_ptr<Message>* response) {
+  return WaitFor([this, &message, expect_response](
+      const ResponseCallback& callback) {
+    return conn_->Send(message, expect_response, callback);
+  }, response);
+}
+
+PresenterErrorCode EventLoopChannel::WaitFor(
+    const function<PresenterErrorCode(const ResponseCallback&)>& send,
+    unique_ptr<Message>* response) {
+  shared_ptr<SyncCall> call(new (nothrow) SyncCall());
+  if (call == nullptr) {
+    return PresenterErrorCode::kBadAlloc;
+  }
+
+  PresenterErrorCode error_code = send(
+      [call](PresenterErrorCode code, unique_ptr<Message>& resp) {
+        call->Complete(code, &resp);
+      });
+  if (error_code != PresenterErrorCode::kNone) {
+    return error_code;
+  }
+
+  if (!call->Wait(kWaitTimeoutInSec)) {
+    AGENT_LOG_ERROR("Timeout when sending message");
+    return PresenterErrorCode::kSocketTimeout;
+  }
+
+  if (response != nullptr) {
+    *response = std::move(call->response);
+  }
+
+  return call->error_code;
+}
+
+PresenterErrorCode EventLoopChannel::SendMessage(const Message& message) {
+  PartialMessageWithTlvs msg;
+  msg.message = &message;
+  return SendMessage(msg);
+}
+
+PresenterErrorCode EventLoopChannel::SendMessage(
+    const PartialMessageWithTlvs& message) {
+  return SendAndWait(message, false, nullptr);
+}
+
+PresenterErrorCode EventLoopChannel::SendMessage(
+    const Message& message, unique_ptr<Message>& response) {
+  PartialMessageWithTlvs msg;
+  msg.message = &message;
+  return SendMessage(msg, response);
+}
+
+PresenterErrorCode EventLoopChannel::SendMessage(
+    const PartialMessageWithTlvs& message, unique_ptr<Message>& response) {
+  return SendAndWait(message, true, &response);
+}
+
+PresenterErrorCode EventLoopChannel::SendMessageAsync(
+    const PartialMessageWithTlvs& message, const ResponseCallback& callback) {
+  return conn_->Send(message, true, callback);
+}
+
+PresenterErrorCode EventLoopChannel::SendEncodedMessage(
+    const vector<SharedByteBuffer>& buffers, unique_ptr<Message>& response) {
+  return WaitFor([this, &buffers](const ResponseCallback& callback) {
+    return conn_->SendEncoded(buffers, true, callback);
+  }, &response);
+}
+
+PresenterErrorCode EventLoopChannel::SendEncodedMessageAsync(
+    const vector<SharedByteBuffer>& buffers, const ResponseCallback& callback) {
+  return conn_->SendEncoded(buffers, true, callback);
+}
+
+PresenterErrorCode EventLoopChannel::ReceiveMessage(
+    unique_ptr<Message>& response) {
+  if (!conn_->IsOpen()) {
+    AGENT_LOG_ERROR("Channel is not open, receive message failed");
+    return PresenterErrorCode::kConnection;
+  }
+
+  unique_lock<mutex> lock(mtx_);
+  if (!cv_received_.wait_for(lock, chrono::seconds(kReceiveTimeoutInSec),
+                             [this]() {return !received_.empty();})) {
+    return PresenterErrorCode::kSocketTimeout;
+  }
+
+  response = std::move(received_.front());
+  received_.pop_front();
+  return PresenterErrorCode::kNone;
+}
+
+void EventLoopChannel::OnMessage(unique_ptr<Message>& message) {
+  lock_guard<mutex> lock(mtx_);
+  if (received_.size() >= kMaxReceivedMessages) {
+    AGENT_LOG_WARN("Too many unhandled messages, drop the oldest one");
+    received_.pop_front();
+  }
+
+  received_.push_back(std::move(message));
+  cv_received_.notify_one();
+}
+
+const std::string& EventLoopChannel::GetDescription() const {
+  return this->description_;
+}
+
+void EventLoopChannel::SetDescription(const std::string& desc) {
+  this->description_ = desc;
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
@@ -0,0 +1,216 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_CHANNEL_EVENT_LOOP_CHANNEL_H_
+#define ASCENDDK_PRESENTER_AGENT_CHANNEL_EVENT_LOOP_CHANNEL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ascenddk/presenter/agent/channel.h"
+#include "ascenddk/presenter/agent/runtime/async_connection.h"
+#include "ascenddk/presenter/agent/runtime/event_loop.h"
+#include "ascenddk/presenter/agent/util/byte_buffer.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Channel whose socket is owned by a shared EventLoop of the agent runtime.
+ * No thread is created per channel, heartbeat and reconnecting are done by
+ * the loop thread. Blocking methods wait for the loop thread to finish the
+ * I/O. Callbacks of SendMessageAsync() run in the loop thread, they must
+ * not block, and must not delete the channel
+ */
+class EventLoopChannel : public Channel {
+ public:
+
+  /**
+   * @brief create a channel
+   * @param [in] loop                   event loop serving the channel
+   * @param [in] host_ip                host IP of server
+   * @param [in] port                   port of server
+   * @param [in] handler                init handler
+   * @return pointer to channel
+   */
+  static EventLoopChannel* NewChannel(
+      std::shared_ptr<EventLoop> loop, const std::string& host_ip,
+      uint16_t port, std::shared_ptr<InitChannelHandler> handler);
+
+  virtual ~EventLoopChannel();
+
+  /**
+   * @brief Open channel
+   * @return PresenterErrorCode
+   */
+  virtual PresenterErrorCode Open() override;
+
+  /**
+   * @brief send message to server
+   * @param [in] message              message
+   * @return PresenterErrorCode
+   */
+  virtual PresenterErrorCode SendMessage(
+      const google::protobuf::Message& message) override;
+
+  /**
+   * @brief send message to server
+   * @param [in] message              message
+   * @return PresenterErrorCode
+   */
+  virtual PresenterErrorCode SendMessage(const PartialMessageWithTlvs& message)
+      override;
+
+  /**
+   * @brief send message to server and read the response
+   * @param [in] message              message
+   * @pararm [out] response           response
+   * @return PresenterErrorCode
+   */
+  virtual PresenterErrorCode SendMessage(
+      const google::protobuf::Message& message,
+      std::unique_ptr<google::protobuf::Message>& response) override;
+
+  /**
+   * @brief send message to server and read the response
+   * @param [in] message              message
+   * @pararm [out] response           response
+   * @return PresenterErrorCode
+   */
+  virtual PresenterErrorCode SendMessage(
+      const PartialMessageWithTlvs& message,
+      std::unique_ptr<google::protobuf::Message>& response) override;
+
+  /**
+   * @brief recevice a message which is not the response of any request
+   * @param [out] response            response
+   * @return PresenterErrorCode
+   */
+  virtual PresenterErrorCode ReceiveMessage(
+      std::unique_ptr<google::protobuf::Message>& response) override;
+
+  /**
+   * @brief send message to server and handle the response in loop thread
+   * @param [in] message              message
+   * @param [in] callback             callback
+   * @return PresenterErrorCode
+   */
+  virtual PresenterErrorCode SendMessageAsync(
+      const PartialMessageWithTlvs& message,
+      const ResponseCallback& callback) override;
+
+  /**
+   * @brief send a message encoded by MessageCodec and read the response
+   * @param [in] buffers              encoded buffers, in sending order
+   * @pararm [out] response           response
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode SendEncodedMessage(
+      const std::vector<SharedByteBuffer>& buffers,
+      std::unique_ptr<google::protobuf::Message>& response);
+
+  /**
+   * @brief send a message encoded by MessageCodec and handle the response
+   *        in loop thread, the buffers are shared with the caller
+   * @param [in] buffers              encoded buffers, in sending order
+   * @param [in] callback             callback
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode SendEncodedMessageAsync(
+      const std::vector<SharedByteBuffer>& buffers,
+      const ResponseCallback& callback);
+
+  /**
+   * @brief get InitChannelHandler
+   * @return InitChannelHandler
+   */
+  std::shared_ptr<const InitChannelHandler> GetInitChannelHandler();
+
+  /**
+   * @brief set description
+   * @param [in] desc              description
+   */
+  void SetDescription(const std::string& desc);
+
+  /**
+   * @brief Get the description of the channel, can be used for logging
+   * @return description
+   */
+  const std::string& GetDescription() const override;
+
+ private:
+  EventLoopChannel(std::shared_ptr<EventLoop> loop,
+                   std::shared_ptr<InitChannelHandler> handler);
+
+  /**
+   * @brief send message and wait until it is sent or responded
+   */
+  PresenterErrorCode SendAndWait(
+      const PartialMessageWithTlvs& message, bool expect_response,
+      std::unique_ptr<google::protobuf::Message>* response);
+
+  /**
+   * @brief submit a message by send and wait until the callback passed to
+   *        it is invoked
+   */
+  PresenterErrorCode WaitFor(
+      const std::function<PresenterErrorCode(const ResponseCallback&)>& send,
+      std::unique_ptr<google::protobuf::Message>* response);
+
+  /**
+   * @brief keep a message which is not the response of any request
+   */
+  void OnMessage(std::unique_ptr<google::protobuf::Message>& message);
+
+  // keep the loop alive as long as the connection
+  std::shared_ptr<EventLoop> loop_;
+  std::shared_ptr<InitChannelHandler> init_channel_handler_;
+  std::shared_ptr<AsyncConnection> conn_;
+
+  std::mutex mtx_;
+  std::condition_variable cv_received_;
+  std::deque<std::unique_ptr<google::protobuf::Message>> received_;
+
+  std::string description_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_CHANNEL_EVENT_LOOP_CHANNEL_H_ */
@@ -0,0 +1,91 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_CHANNEL_SYNC_CALL_H_
+#define ASCENDDK_PRESENTER_AGENT_CHANNEL_SYNC_CALL_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <google/protobuf/message.h>
+
+#include "ascenddk/presenter/agent/errors.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Result of a call completed by another thread, e.g. the loop thread or the
+ * writer thread of a channel. Shared by the caller and the callback, so the
+ * callback may complete it after the caller stopped waiting
+ */
+struct SyncCall {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool done = false;
+  PresenterErrorCode error_code = PresenterErrorCode::kOther;
+  std::unique_ptr<google::protobuf::Message> response;
+
+  /**
+   * @brief complete the call and wake up the caller
+   * @param [in] code           result of the call
+   * @param [in] resp           response, moved if not NULL
+   */
+  void Complete(PresenterErrorCode code,
+                std::unique_ptr<google::protobuf::Message>* resp) {
+    std::lock_guard<std::mutex> lock(mtx);
+    error_code = code;
+    if (resp != nullptr) {
+      response = std::move(*resp);
+    }
+    done = true;
+    cv.notify_one();
+  }
+
+  /**
+   * @brief wait for the call to complete
+   * @param [in] timeout_in_sec timeout
+   * @return true: completed, false: timeout
+   */
+  bool Wait(int timeout_in_sec) {
+    std::unique_lock<std::mutex> lock(mtx);
+    return cv.wait_for(lock, std::chrono::seconds(timeout_in_sec),
+                       [this]() {return done;});
+  }
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_CHANNEL_SYNC_CALL_H_ */
@@ -0,0 +1,160 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/codec/compression.h"
+
+#ifdef PRESENTER_AGENT_WITH_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef PRESENTER_AGENT_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include "ascenddk/presenter/agent/util/logging.h"
+
+namespace {
+
+#ifdef PRESENTER_AGENT_WITH_ZSTD
+// default level of zstd, a good balance of speed and ratio
+const int kZstdLevel = 3;
+
+/**
+ * zstd context of a thread, reused by the messages compressed by the thread
+ */
+class ZstdContext {
+ public:
+  ZstdContext() : ctx_(ZSTD_createCCtx()) {}
+  ~ZstdContext() {
+    ZSTD_freeCCtx(ctx_);
+  }
+
+  ZSTD_CCtx* Get() {
+    return ctx_;
+  }
+
+  // Disable copy constructor and assignment operator
+  ZstdContext(const ZstdContext&) = delete;
+  ZstdContext& operator=(const ZstdContext&) = delete;
+
+ private:
+  ZSTD_CCtx* ctx_;
+};
+
+thread_local ZstdContext t_zstd_context;
+#endif
+
+}
+
+namespace ascend {
+namespace presenter {
+namespace compression {
+
+bool IsSupported(CompressionType type) {
+  switch (type) {
+    case CompressionType::kNone:
+      return true;
+#ifdef PRESENTER_AGENT_WITH_LZ4
+    case CompressionType::kLz4:
+      return true;
+#endif
+#ifdef PRESENTER_AGENT_WITH_ZSTD
+    case CompressionType::kZstd:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+std::uint32_t CompressBound(CompressionType type, std::uint32_t size) {
+  switch (type) {
+#ifdef PRESENTER_AGENT_WITH_LZ4
+    case CompressionType::kLz4:
+      return static_cast<std::uint32_t>(
+          LZ4_compressBound(static_cast<int>(size)));
+#endif
+#ifdef PRESENTER_AGENT_WITH_ZSTD
+    case CompressionType::kZstd:
+      return static_cast<std::uint32_t>(ZSTD_compressBound(size));
+#endif
+    default:
+      return 0;
+  }
+}
+
+std::uint32_t Compress(CompressionType type, const char* src,
+                       std::uint32_t size, char* dst,
+                       std::uint32_t capacity) {
+  switch (type) {
+#ifdef PRESENTER_AGENT_WITH_LZ4
+    case CompressionType::kLz4: {
+      int ret = LZ4_compress_default(src, dst, static_cast<int>(size),
+                                     static_cast<int>(capacity));
+      if (ret <= 0) {
+        AGENT_LOG_ERROR("LZ4 compression failed, size = %u", size);
+        return 0;
+      }
+
+      return static_cast<std::uint32_t>(ret);
+    }
+#endif
+#ifdef PRESENTER_AGENT_WITH_ZSTD
+    case CompressionType::kZstd: {
+      ZSTD_CCtx* ctx = t_zstd_context.Get();
+      if (ctx == nullptr) {
+        AGENT_LOG_ERROR("ZSTD_createCCtx() failed");
+        return 0;
+      }
+
+      size_t ret = ZSTD_compressCCtx(ctx, dst, capacity, src, size,
+                                     kZstdLevel);
+      if (ZSTD_isError(ret)) {
+        AGENT_LOG_ERROR("zstd compression failed, size = %u, error = %s",
+                        size, ZSTD_getErrorName(ret));
+        return 0;
+      }
+
+      return static_cast<std::uint32_t>(ret);
+    }
+#endif
+    default:
+      AGENT_LOG_ERROR("Unsupported compression type: %d",
+                      static_cast<int>(type));
+      return 0;
+  }
+}
+
+} /* namespace compression */
+} /* namespace presenter */
+} /* namespace ascend */
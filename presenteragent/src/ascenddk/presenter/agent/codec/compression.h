@@ -0,0 +1,82 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_CODEC_COMPRESSION_H_
+#define ASCENDDK_PRESENTER_AGENT_CODEC_COMPRESSION_H_
+
+#include <cstdint>
+
+#include "ascenddk/presenter/agent/presenter_types.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Compression of message bodies. LZ4 and zstd are only available if the
+ * agent is built with lz4=1 or zstd=1
+ */
+namespace compression {
+
+/**
+ * @brief check whether the agent is built with the compression type
+ * @param [in] type           compression type
+ * @return true: supported, false: not supported
+ */
+bool IsSupported(CompressionType type);
+
+/**
+ * @brief get the max size of the compressed data
+ * @param [in] type           compression type, must be supported
+ * @param [in] size           size of the data
+ * @return max compressed size, 0 if the data is too large
+ */
+std::uint32_t CompressBound(CompressionType type, std::uint32_t size);
+
+/**
+ * @brief compress data
+ * @param [in] type           compression type, must be supported
+ * @param [in] src            data
+ * @param [in] size           size of data
+ * @param [out] dst           buffer of compressed data
+ * @param [in] capacity       size of dst, not less than CompressBound()
+ * @return size of the compressed data, 0 if compression failed
+ */
+std::uint32_t Compress(CompressionType type, const char* src,
+                       std::uint32_t size, char* dst, std::uint32_t capacity);
+
+} /* namespace compression */
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_CODEC_COMPRESSION_H_ */
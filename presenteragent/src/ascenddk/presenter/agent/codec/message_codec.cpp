@@ -33,10 +33,11 @@
 
 #include "ascenddk/presenter/agent/codec/message_codec.h"
 
+#include <cstdint>
 #include <string>
 #include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 
+#include "ascenddk/presenter/agent/codec/compression.h"
 #include "ascenddk/presenter/agent/util/logging.h"
 
 using namespace google::protobuf;
@@ -58,6 +59,9 @@ static const int kMaxVarint32Bytes = 5;
 // for calc tag
 const int kTagShift = 3;
 
+// compression type, original size and compressed size
+const int kCompressionHeaderSize = sizeof(uint8_t) + 2 * sizeof(uint32_t);
+
 // empty string
 const string kEmptyStr = "";
 }
@@ -76,12 +80,11 @@ static string ConvertToVarint32(uint32_t value) {
     return kEmptyStr;
   }
 
-  char buf[kMaxVarint32Bytes];
-  ArrayOutputStream arr(buf, kMaxVarint32Bytes);
-  CodedOutputStream os(&arr);
-  os.WriteVarint32(value);
-  // os.ByteCount() <= kMaxVarint32Bytes
-  return string(buf, os.ByteCount());
+  // written to the array directly, CodedOutputStream of newer protobuf
+  // keeps the bytes in its own buffer until it is destroyed
+  uint8_t buf[kMaxVarint32Bytes];
+  uint8_t *end = CodedOutputStream::WriteVarint32ToArray(value, buf);
+  return string(reinterpret_cast<char*>(buf), end - buf);
 }
 
 SharedByteBuffer MessageCodec::EncodeTagAndLength(const Tlv& tlv) {
@@ -105,6 +108,52 @@ SharedByteBuffer MessageCodec::EncodeTagAndLength(const Tlv& tlv) {
   return result;
 }
 
+SharedByteBuffer MessageCodec::EncodeTlv(const Tlv& tlv) {
+  string varlen = ConvertToVarint32(tlv.length);
+  if (varlen.empty() || tlv.value == nullptr) {
+    AGENT_LOG_ERROR("invalid TLV, length = %d", tlv.length);
+    return SharedByteBuffer();
+  }
+
+  uint32_t size = kTagSize + varlen.size() + tlv.length;
+  SharedByteBuffer result = SharedByteBuffer::Make(size);
+  if (result.IsEmpty()) {
+    return result;
+  }
+
+  ByteBufferWriter buffer(result.GetMutable(), size);
+  buffer.PutUInt8(MakeTag(tlv.tag));
+  buffer.PutString(varlen);
+  buffer.PutBytes(tlv.value, tlv.length);
+  if (buffer.GetBuffer().IsEmpty()) {
+    return SharedByteBuffer();
+  }
+
+  return result;
+}
+
+bool MessageCodec::EncodeMessage(const PartialMessageWithTlvs& message,
+                                 vector<SharedByteBuffer>& buffers) {
+  SharedByteBuffer header = EncodeMessage(message);
+  if (header.IsEmpty()) {
+    return false;
+  }
+
+  buffers.reserve(buffers.size() + message.tlv_list.size() + 1);
+  buffers.push_back(header);
+  for (auto it = message.tlv_list.begin(); it != message.tlv_list.end();
+      ++it) {
+    SharedByteBuffer tlv_buf = EncodeTlv(*it);
+    if (tlv_buf.IsEmpty()) {
+      return false;
+    }
+
+    buffers.push_back(tlv_buf);
+  }
+
+  return true;
+}
+
 SharedByteBuffer MessageCodec::EncodeMessage(
     const google::protobuf::Message& message) {
   PartialMessageWithTlvs msg;
@@ -140,6 +189,16 @@ SharedByteBuffer MessageCodec::EncodeMessage(
     }
   }
 
+  if (compression_.type != CompressionType::kNone
+      && msg_size >= compression_.threshold) {
+    // sent uncompressed if it does not help
+    SharedByteBuffer compressed = EncodeCompressedMessage(
+        message, name, total_size - encode_size);
+    if (!compressed.IsEmpty()) {
+      return compressed;
+    }
+  }
+
   SharedByteBuffer encode_buffer = SharedByteBuffer::Make(encode_size);
   if (encode_buffer.IsEmpty()) {
     return encode_buffer;
@@ -159,6 +218,71 @@ SharedByteBuffer MessageCodec::EncodeMessage(
   return encode_buffer;
 }
 
+SharedByteBuffer MessageCodec::EncodeCompressedMessage(
+    const Message& message, const string& name, uint32_t tlv_size) {
+  if (name.size() >= kCompressedFlag) {
+    return SharedByteBuffer();
+  }
+
+  size_t fields_size = message.ByteSizeLong();
+  if (fields_size > UINT32_MAX) {
+    return SharedByteBuffer();
+  }
+
+  uint32_t msg_size = static_cast<uint32_t>(fields_size);
+  SharedByteBuffer fields = SharedByteBuffer::Make(msg_size);
+  if (fields.IsEmpty()
+      || !message.SerializePartialToArray(fields.GetMutable(), msg_size)) {
+    return SharedByteBuffer();
+  }
+
+  uint32_t bound = compression::CompressBound(compression_.type, msg_size);
+  if (bound == 0) {
+    return SharedByteBuffer();
+  }
+
+  SharedByteBuffer compressed = SharedByteBuffer::Make(bound);
+  if (compressed.IsEmpty()) {
+    return compressed;
+  }
+
+  uint32_t compressed_size = compression::Compress(
+      compression_.type, fields.Get(), msg_size, compressed.GetMutable(),
+      bound);
+  if (compressed_size == 0 || compressed_size >= msg_size) {
+    return SharedByteBuffer();
+  }
+
+  uint32_t encode_size = kPacketLengthSize + kMessageNameLengthSize
+      + name.size() + kCompressionHeaderSize + compressed_size;
+  SharedByteBuffer encode_buffer = SharedByteBuffer::Make(encode_size);
+  if (encode_buffer.IsEmpty()) {
+    return encode_buffer;
+  }
+
+  ByteBufferWriter buffer(encode_buffer.GetMutable(), encode_size);
+  buffer.PutUInt32(encode_size + tlv_size);
+  buffer.PutUInt8(static_cast<uint8_t>(name.size()) | kCompressedFlag);
+  buffer.PutString(name);
+  buffer.PutUInt8(static_cast<uint8_t>(compression_.type));
+  buffer.PutUInt32(msg_size);
+  buffer.PutUInt32(compressed_size);
+  buffer.PutBytes(compressed.Get(), compressed_size);
+  if (buffer.GetBuffer().IsEmpty()) {
+    return SharedByteBuffer();
+  }
+
+  return encode_buffer;
+}
+
+void MessageCodec::SetCompression(const CompressionParam& param) {
+  compression_ = param;
+}
+
+const CompressionParam& MessageCodec::GetCompression() const {
+  return compression_;
+}
+
 // Generate message prototype by name for parsing
 static Message* NewMessageByName(const string& name) {
   const Descriptor* descriptor = DescriptorPool::generated_pool()
@@ -185,6 +309,11 @@ Message* MessageCodec::DecodeMessage(const char* data, int size) {
 
   // read message name length
   uint8_t msg_name_length = buffer.ReadUInt8();
+  if ((msg_name_length & kCompressedFlag) != 0) {
+    AGENT_LOG_ERROR("Compressed message is not supported");
+    return nullptr;
+  }
+
   if (buffer.RemainingBytes() < msg_name_length) {
     AGENT_LOG_ERROR(
         "Insufficient data for name field, expect %d, but remain %d",
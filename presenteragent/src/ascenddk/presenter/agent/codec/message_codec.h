@@ -35,9 +35,11 @@
 #define ASCENDDK_PRESENTER_AGENT_CODEC_MESSAGE_CODEC_H_
 
 #include <cstdint>
+#include <vector>
 #include <google/protobuf/message.h>
 
 #include "ascenddk/presenter/agent/channel.h"
+#include "ascenddk/presenter/agent/presenter_types.h"
 #include "ascenddk/presenter/agent/util/byte_buffer.h"
 
 namespace ascend {
@@ -58,12 +60,45 @@ namespace presenter {
  *    |-------------------------------------------------------------------
  *    |message body        |      Var.      |  Bytes. Encoded by protobuf |
  *    --------------------------------------------------------------------
+ *
+ * If the highest bit of message name len is set, the protobuf fields of the
+ * body are compressed, the TLVs following them are not
+ *    --------------------------------------------------------------------
+ *    |compression type    |       1        |    uint8, CompressionType   |
+ *    |-------------------------------------------------------------------
+ *    |original size       |       4        |    uint32                   |
+ *    |-------------------------------------------------------------------
+ *    |compressed size     |       4        |    uint32                   |
+ *    |-------------------------------------------------------------------
+ *    |compressed fields   |      Var.      |  Bytes                      |
+ *    |-------------------------------------------------------------------
+ *    |TLVs                |      Var.      |  Bytes. Encoded by protobuf |
+ *    --------------------------------------------------------------------
  */
 class MessageCodec {
  public:
   // size of channel message total length
   static const int kPacketLengthSize = sizeof(uint32_t);
 
+  // max size of a message, excluding the total length field
+  static const uint32_t kMaxPacketSize = 1024 * 1024 * 10; //10MB
+
+  // set in message name len if the message is compressed
+  static const uint8_t kCompressedFlag = 0x80;
+
+  /**
+   * @brief compress the protobuf fields of the messages encoded afterwards,
+   *        must be called before the codec is shared by threads
+   * @param [in] param                compression type and threshold
+   */
+  void SetCompression(const CompressionParam& param);
+
+  /**
+   * @brief get the compression of the messages
+   * @return compression type and threshold
+   */
+  const CompressionParam& GetCompression() const;
+
   /**
    * @brief Encode the message to a ByteBuffer
    * @param [in] message              message
@@ -85,6 +120,24 @@ class MessageCodec {
    */
   SharedByteBuffer EncodeTagAndLength(const Tlv& tlv);
 
+  /**
+   * @brief Encode the tag, length and value to a ByteBuffer, the value is
+   *        copied so the buffer remains valid after the Tlv is released
+   * @param [in] Tlv                  Tlv
+   * @return ByteBuffer. Empty if encode failed
+   */
+  SharedByteBuffer EncodeTlv(const Tlv& tlv);
+
+  /**
+   * @brief Encode the whole message, including all TLVs, to a list of
+   *        self-contained buffers which can be sent asynchronously
+   * @param [in] message              message
+   * @param [out] buffers             encoded buffers, in sending order
+   * @return true: success, false: encode failed
+   */
+  bool EncodeMessage(const PartialMessageWithTlvs& message,
+                     std::vector<SharedByteBuffer>& buffers);
+
   /**
    * @brief Decode the message from buffer
    * @param [in] data                 data buffer
@@ -93,6 +146,20 @@ class MessageCodec {
    */
   google::protobuf::Message* DecodeMessage(const char* data, int size);
 
+ private:
+  /**
+   * @brief Encode the message with its protobuf fields compressed
+   * @param [in] message              message
+   * @param [in] name                 name of the message
+   * @param [in] tlv_size             size of the encoded TLVs
+   * @return ByteBuffer. Empty if the fields do not get smaller, or
+   *         compression failed
+   */
+  SharedByteBuffer EncodeCompressedMessage(
+      const google::protobuf::Message& message, const std::string& name,
+      uint32_t tlv_size);
+
+  CompressionParam compression_;
 };
 
 } /* namespace presenter */
@@ -40,13 +40,8 @@
 #include "ascenddk/presenter/agent/net/raw_socket_factory.h"
 #include "ascenddk/presenter/agent/util/byte_buffer.h"
 #include "ascenddk/presenter/agent/util/logging.h"
-#include "ascenddk/presenter/agent/util/mem_utils.h"
 
 
-namespace {
-  const uint32_t kMaxPacketSize = 1024 * 1024 * 10; //10MB
-}
-
 namespace ascend {
 namespace presenter {
 
@@ -97,6 +92,11 @@ PresenterErrorCode Connection::SendTlvList(const std::vector<Tlv>& tlv_list) {
   return PresenterErrorCode::kNone;
 }
 
+void Connection::SetCompression(const CompressionParam& param) {
+  unique_lock<mutex> lock(mtx_);
+  codec_.SetCompression(param);
+}
+
 PresenterErrorCode Connection::SendMessage(
     const PartialMessageWithTlvs& proto_message) {
   if (proto_message.message == nullptr) {
@@ -126,6 +126,26 @@ PresenterErrorCode Connection::SendMessage(
   return SendTlvList(proto_message.tlv_list);
 }
 
+PresenterErrorCode Connection::SendEncodedMessage(
+    const vector<SharedByteBuffer>& buffers) {
+  return SendEncodedMessage(buffers, vector<Tlv>());
+}
+
+PresenterErrorCode Connection::SendEncodedMessage(
+    const vector<SharedByteBuffer>& buffers, const vector<Tlv>& tlv_list) {
+  // lock for sending, the buffers are already encoded
+  unique_lock<mutex> lock(mtx_);
+  for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+    PresenterErrorCode error_code = socket_->Send(it->Get(), it->Size());
+    if (error_code != PresenterErrorCode::kNone) {
+      AGENT_LOG_ERROR("Failed to send encoded message");
+      return error_code;
+    }
+  }
+
+  return SendTlvList(tlv_list);
+}
+
 PresenterErrorCode Connection::SendMessage(const Message& message) {
   PartialMessageWithTlvs msg;
   msg.message = &message;
@@ -155,21 +175,21 @@ PresenterErrorCode Connection::ReceiveMessage(
 
   // read the remaining data Ӧݳȥsizeof(uint32_t)ͷ
   uint32_t remaining_size = total_size - MessageCodec::kPacketLengthSize;
-  if (remaining_size == 0 || remaining_size > kMaxPacketSize) {
+  if (remaining_size == 0 || remaining_size > MessageCodec::kMaxPacketSize) {
     AGENT_LOG_ERROR("received malformed message, size field = %u", total_size);
     return PresenterErrorCode::kCodec;
   }
 
   int pack_size = static_cast<int>(remaining_size);
-  unique_ptr<char[]> unique_buf; // ensure release allocated buffer
+  SharedByteBuffer large_buf; // released when the message is decoded
   //ʣݳkBufferSize(1K),buf
   if (remaining_size > kBufferSize) {
-    buf = memutils::NewArray<char>(remaining_size);
-    if (buf == nullptr) {
+    large_buf = SharedByteBuffer::Make(remaining_size);
+    if (large_buf.IsEmpty()) {
       return PresenterErrorCode::kBadAlloc;
     }
 
-    unique_buf.reset(memutils::NewArray<char>(remaining_size));
+    buf = large_buf.GetMutable();
   }
 
   // packSize must be within [1, MAX_PACKET_SIZE],
@@ -188,8 +208,8 @@ PresenterErrorCode Connection::ReceiveMessage(
   }
   //ӦΪ
   message.reset(msg);
-  string name = message->GetDescriptor()->name();
-  AGENT_LOG_DEBUG("Message received, name = %s", name.c_str());
+  AGENT_LOG_DEBUG("Message received, name = %s",
+                  message->GetDescriptor()->name().c_str());
   return PresenterErrorCode::kNone;
 }
 
@@ -40,6 +40,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 #include <google/protobuf/message.h>
 
 #include "ascenddk/presenter/agent/codec/message_codec.h"
@@ -72,6 +73,25 @@ class Connection {
    */
   PresenterErrorCode SendMessage(const PartialMessageWithTlvs& message);
 
+  /**
+   * @brief Send a Message encoded by MessageCodec to presenter server
+   * @param [in] buffers        encoded buffers, in sending order
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode SendEncodedMessage(
+      const std::vector<SharedByteBuffer>& buffers);
+
+  /**
+   * @brief Send a Message encoded by MessageCodec, followed by TLVs which
+   *        are sent from caller's memory
+   * @param [in] buffers        encoded buffers without the TLVs
+   * @param [in] tlv_list       TLVs, in sending order
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode SendEncodedMessage(
+      const std::vector<SharedByteBuffer>& buffers,
+      const std::vector<Tlv>& tlv_list);
+
   /**
    * @brief Receive a message from presenter server
    * @param [out] message       response message
@@ -80,6 +100,12 @@ class Connection {
   PresenterErrorCode ReceiveMessage(
       std::unique_ptr<::google::protobuf::Message>& message);
 
+  /**
+   * @brief Set compression of the messages sent afterwards
+   * @param [in] param          compression accepted by the server
+   */
+  void SetCompression(const CompressionParam& param);
+
  private:
   PresenterErrorCode DoSendMessage(const ::google::protobuf::Message& message,
                                    const std::vector<Tlv>& tlv_list);
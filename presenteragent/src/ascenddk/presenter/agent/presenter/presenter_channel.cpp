@@ -33,28 +33,59 @@
 
 #include "ascenddk/presenter/agent/presenter_channel.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <sstream>
 
 #include "ascenddk/presenter/agent/channel/default_channel.h"
+#include "ascenddk/presenter/agent/channel/event_loop_channel.h"
+#include "ascenddk/presenter/agent/codec/message_codec.h"
 #include "ascenddk/presenter/agent/net/raw_socket_factory.h"
 #include "ascenddk/presenter/agent/presenter/presenter_channel_init_handler.h"
 #include "ascenddk/presenter/agent/presenter/presenter_message_helper.h"
+#include "ascenddk/presenter/agent/runtime/agent_runtime.h"
+#include "ascenddk/presenter/agent/util/consistent_hash.h"
 #include "ascenddk/presenter/agent/util/logging.h"
 
 using namespace std;
 using namespace google::protobuf;
 
+namespace {
+
+// images larger than this are sent in chunks, smaller ones in one message
+// which servers without chunk support understand
+const uint32_t kChunkedImageThreshold = 8 * 1024 * 1024;
+
+const uint32_t kImageChunkSize = 1024 * 1024;
+
+// same limit as the server, which reassembles the whole image
+const uint32_t kMaxChunkedImageSize = 128 * 1024 * 1024;
+
+std::atomic<uint32_t> g_next_frame_id(0);
+
+}
+
 namespace ascend {
 namespace presenter {
 //һͨ(Channel)ʵ. channel Ϊͨ,param ΪͨĲ.ֻChannelʵ,ûserversocket
-PresenterErrorCode CreateChannel(Channel *&channel,
-                                 const OpenChannelParam &param) {
-  std::shared_ptr<PresentChannelInitHandler> handler = make_shared<
-      PresentChannelInitHandler>(param);
-  //һDefaultChannel
-  DefaultChannel *ch = DefaultChannel::NewChannel(param.host_ip, param.port, handler);
-  if (ch == nullptr) {
+PresenterErrorCode CreateChannel(
+    Channel *&channel, const OpenChannelParam &param,
+    std::shared_ptr<PresentChannelInitHandler> handler) {
+  // served by the shared event loops if agent runtime is started
+  shared_ptr<EventLoop> loop = AgentRuntime::GetInstance().GetEventLoop();
+  DefaultChannel *ch = nullptr;
+  EventLoopChannel *loop_ch = nullptr;
+  if (loop != nullptr) {
+    loop_ch = EventLoopChannel::NewChannel(loop, param.host_ip, param.port,
+                                           handler);
+  } else {
+    //һDefaultChannel
+    ch = DefaultChannel::NewChannel(param.host_ip, param.port, handler);
+  }
+
+  if (ch == nullptr && loop_ch == nullptr) {
     AGENT_LOG_ERROR("Channel new() error");
     return PresenterErrorCode::kBadAlloc;
   }
@@ -67,13 +98,19 @@ PresenterErrorCode CreateChannel(Channel *&channel,
   ss << ", channel: " << param.channel_name;
   ss << ", content_type: " << static_cast<int>(param.content_type);
   ss << "}";
-  ch->SetDescription(ss.str());
-  channel = ch;
+  if (loop_ch != nullptr) {
+    loop_ch->SetDescription(ss.str());
+    channel = loop_ch;
+  } else {
+    ch->SetDescription(ss.str());
+    channel = ch;
+  }
   return PresenterErrorCode::kNone;
 }
 
-PresenterErrorCode OpenChannel(Channel *&channel,
-                               const OpenChannelParam &param) {
+// open a channel on the server given by host_ip and port of param
+static PresenterErrorCode OpenChannelOnServer(Channel *&channel,
+                                              const OpenChannelParam &param) {
 
   // If the channel is not NULL, we cannot know whether it is actually
   // point to something. We cannot be sure whether it is safe to simply
@@ -85,7 +122,9 @@ PresenterErrorCode OpenChannel(Channel *&channel,
 
   // allocate channel object
   //һChannelʵ
-  PresenterErrorCode error_code = CreateChannel(channel, param);
+  std::shared_ptr<PresentChannelInitHandler> handler = make_shared<
+      PresentChannelInitHandler>(param);
+  PresenterErrorCode error_code = CreateChannel(channel, param, handler);
   if (error_code != PresenterErrorCode::kNone) {
     return error_code;
   }
@@ -101,15 +140,12 @@ PresenterErrorCode OpenChannel(Channel *&channel,
   if (error_code != PresenterErrorCode::kNone) {
 	//Openʧ,ȡʧܴ,¼־,ͷchannelʵ,ʧ
     if (error_code == PresenterErrorCode::kAppDefinedError) {
-	  //һѴΪ˵PresentChannelInitHandlerGetErrorCode()ȡ.channelChannelͣҪǿתΪDefaultChannel;
-	  //DefaultChannelGetInitChannelHandler()صInitChannelHandler,ҪתΪPresentChannelInitHandlerܵGetErrorCode()
-      DefaultChannel *ch = dynamic_cast<DefaultChannel*>(channel);
-      error_code = dynamic_pointer_cast<const PresentChannelInitHandler>(
-          ch->GetInitChannelHandler())->GetErrorCode();
+      // the init handler knows the error returned by server
+      error_code = handler->GetErrorCode();
     }
 
     AGENT_LOG_ERROR("OpenChannel Failed, channel = %s, error_code = %d",
-                    channelDesc.c_str(), error_code);
+                    channelDesc.c_str(), static_cast<int>(error_code));
     delete channel;
     channel = nullptr;
     return error_code;
@@ -118,6 +154,99 @@ PresenterErrorCode OpenChannel(Channel *&channel,
   AGENT_LOG_INFO("Channel opened, channel = %s", channelDesc.c_str());
   return PresenterErrorCode::kNone;
 }
+
+PresenterErrorCode OpenChannel(Channel *&channel,
+                               const OpenChannelParam &param) {
+  if (param.endpoints.empty()) {
+    return OpenChannelOnServer(channel, param);
+  }
+
+  // place the channel by its name, so that it is always opened on the same
+  // server, unless that server is down
+  ConsistentHashRing ring;
+  for (const ServerEndpoint &endpoint : param.endpoints) {
+    ring.AddNode(endpoint.host_ip + ":" + to_string(endpoint.port));
+  }
+
+  PresenterErrorCode error_code = PresenterErrorCode::kConnection;
+  OpenChannelParam server_param = param;
+  for (size_t index : ring.GetNodes(param.channel_name)) {
+    server_param.host_ip = param.endpoints[index].host_ip;
+    server_param.port = param.endpoints[index].port;
+    error_code = OpenChannelOnServer(channel, server_param);
+
+    // only fail over if the server is unreachable, errors returned by
+    // the server would be the same on the others
+    if (error_code != PresenterErrorCode::kConnection
+        && error_code != PresenterErrorCode::kSocketTimeout) {
+      return error_code;
+    }
+
+    AGENT_LOG_WARN("Server %s:%u is unreachable, try the next one",
+                   server_param.host_ip.c_str(), server_param.port);
+  }
+
+  return error_code;
+}
+// sends a chunk of an image, only the last chunk is acked
+typedef function<PresenterErrorCode(const PartialMessageWithTlvs &message,
+                                    bool last)> SendChunkFunction;
+
+// split the data of image into chunks which point into the image, and send
+// them in order until one fails
+static PresenterErrorCode SendImageInChunks(
+    const proto::PresentImageRequest &req, const ImageFrame &image,
+    const SendChunkFunction &send_chunk) {
+  if (image.size > kMaxChunkedImageSize) {
+    AGENT_LOG_ERROR("Image is too large, size = %u, max = %u", image.size,
+                    kMaxChunkedImageSize);
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  uint32_t frame_id = g_next_frame_id.fetch_add(1, memory_order_relaxed);
+  uint32_t offset = 0;
+  for (uint32_t index = 0; ; ++index) {
+    uint32_t length = min(kImageChunkSize, image.size - offset);
+    bool last = offset + length == image.size;
+    proto::PresentImageChunk chunk;
+    chunk.set_frame_id(frame_id);
+    chunk.set_index(index);
+    chunk.set_last(last);
+    if (index == 0) {
+      chunk.set_total_size(image.size);
+      *chunk.mutable_image() = req;
+    }
+
+    Tlv tlv;
+    tlv.tag = proto::PresentImageChunk::kDataFieldNumber;
+    tlv.length = length;
+    tlv.value = reinterpret_cast<char *>(image.data) + offset;
+
+    PartialMessageWithTlvs message;
+    message.message = &chunk;
+    message.tlv_list.push_back(tlv);
+    PresenterErrorCode error_code = send_chunk(message, last);
+    if (error_code != PresenterErrorCode::kNone || last) {
+      return error_code;
+    }
+
+    offset += length;
+  }
+}
+
+// send a chunk which is not acked, the channel is free for other messages
+// until the next chunk is sent
+static PresenterErrorCode SendImageChunk(
+    Channel *channel, const PartialMessageWithTlvs &message) {
+  PresenterErrorCode error_code = channel->SendMessage(message);
+  if (error_code != PresenterErrorCode::kNone) {
+    AGENT_LOG_ERROR("Failed to present image chunk, error = %d",
+                    static_cast<int>(error_code));
+  }
+
+  return error_code;
+}
+
 //presenter agentpresenter serverݵĽӿ,channelǷݵͨ,imageǴ͵
 PresenterErrorCode PresentImage(Channel *channel, const ImageFrame &image) {
   if (channel == nullptr) {
@@ -132,6 +261,27 @@ PresenterErrorCode PresentImage(Channel *channel, const ImageFrame &image) {
     return PresenterErrorCode::kInvalidParam;
   }
 
+  if (image.size > kChunkedImageThreshold) {
+    return SendImageInChunks(req, image,
+        [channel](const PartialMessageWithTlvs &message, bool last) {
+          if (!last) {
+            return SendImageChunk(channel, message);
+          }
+
+          std::unique_ptr<Message> recv_message;
+          PresenterErrorCode error_code = channel->SendMessage(message,
+                                                               recv_message);
+          if (error_code != PresenterErrorCode::kNone) {
+            AGENT_LOG_ERROR("Failed to present image, error = %d",
+                            static_cast<int>(error_code));
+            return error_code;
+          }
+
+          return PresenterMessageHelper::CheckPresentImageResponse(
+              *recv_message);
+        });
+  }
+
   //ͼƬݴTLVʽTLVtag, lengthvalueд. Tagͱ(), lengthvalueĳ. Value
   Tlv tlv;
   tlv.tag = proto::PresentImageRequest::kDataFieldNumber;
@@ -146,13 +296,231 @@ PresenterErrorCode PresentImage(Channel *channel, const ImageFrame &image) {
   //ݷpresenter server,ȴͷserverĶԸݰĻӦ
   PresenterErrorCode error_code = channel->SendMessage(message, recv_message);
   if (error_code != PresenterErrorCode::kNone) {
-    AGENT_LOG_ERROR("Failed to present image, error = %d", error_code);
+    AGENT_LOG_ERROR("Failed to present image, error = %d",
+                    static_cast<int>(error_code));
     return error_code;
   }
   //serverصĻӦлȡ,ɶӦagentĴ,ôʾݷǷɹ
   return PresenterMessageHelper::CheckPresentImageResponse(*recv_message);
 }
 
+PresenterErrorCode PresentImages(Channel *channel,
+                                 const std::vector<ImageFrame> &images) {
+  if (channel == nullptr) {
+    AGENT_LOG_ERROR("channel is NULL");
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  proto::PresentImageBatchRequest req;
+  if (!PresenterMessageHelper::InitPresentImageBatchRequest(req, images)) {
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  // data of image i is sent as the i-th element of data_list, so the
+  // server pairs it with image_list[i] when parsing the whole message
+  PartialMessageWithTlvs message;
+  message.message = &req;
+  uint64_t total_size = req.ByteSizeLong();
+  for (const ImageFrame &image : images) {
+    Tlv tlv;
+    tlv.tag = proto::PresentImageBatchRequest::kDataListFieldNumber;
+    tlv.length = image.size;
+    tlv.value = reinterpret_cast<char *>(image.data);
+    message.tlv_list.push_back(tlv);
+    total_size += image.size;
+  }
+
+  if (total_size > MessageCodec::kMaxPacketSize) {
+    AGENT_LOG_ERROR("Image batch is too large, size = %lu",
+                    static_cast<unsigned long>(total_size));
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  std::unique_ptr<Message> recv_message;
+  PresenterErrorCode error_code = channel->SendMessage(message, recv_message);
+  if (error_code != PresenterErrorCode::kNone) {
+    AGENT_LOG_ERROR("Failed to present images, error = %d",
+                    static_cast<int>(error_code));
+    return error_code;
+  }
+
+  // the whole batch is acknowledged by one PresentImageResponse
+  return PresenterMessageHelper::CheckPresentImageResponse(*recv_message);
+}
+
+PresenterErrorCode PresentRois(Channel *channel, const RoiFrame &frame) {
+  if (channel == nullptr) {
+    AGENT_LOG_ERROR("channel is NULL");
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  proto::PresentRoiRequest req;
+  if (!PresenterMessageHelper::InitPresentRoiRequest(req, frame)) {
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  PartialMessageWithTlvs message;
+  message.message = &req;
+  uint64_t total_size = req.ByteSizeLong();
+  if (frame.size > 0) {
+    Tlv tlv;
+    tlv.tag = proto::PresentRoiRequest::kDataFieldNumber;
+    tlv.length = frame.size;
+    tlv.value = reinterpret_cast<char *>(frame.data);
+    message.tlv_list.push_back(tlv);
+    total_size += frame.size;
+  }
+
+  // data of crop i is sent as the i-th element of data_list
+  for (const RoiCrop &crop : frame.crops) {
+    Tlv tlv;
+    tlv.tag = proto::PresentRoiRequest::kDataListFieldNumber;
+    tlv.length = crop.size;
+    tlv.value = reinterpret_cast<char *>(crop.data);
+    message.tlv_list.push_back(tlv);
+    total_size += crop.size;
+  }
+
+  if (total_size > MessageCodec::kMaxPacketSize) {
+    AGENT_LOG_ERROR("Crops are too large, size = %lu",
+                    static_cast<unsigned long>(total_size));
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  std::unique_ptr<Message> recv_message;
+  PresenterErrorCode error_code = channel->SendMessage(message, recv_message);
+  if (error_code != PresenterErrorCode::kNone) {
+    AGENT_LOG_ERROR("Failed to present crops, error = %d",
+                    static_cast<int>(error_code));
+    return error_code;
+  }
+
+  return PresenterMessageHelper::CheckPresentImageResponse(*recv_message);
+}
+
+PresenterErrorCode PresentImage(ChannelGroup &group, const ImageFrame &image,
+                                std::vector<PresenterErrorCode> &results) {
+  const std::vector<Channel*> &channels = group.GetChannels();
+  proto::PresentImageRequest req;
+  if (!PresenterMessageHelper::InitPresentImageRequest(req, image)) {
+    results.assign(channels.size(), PresenterErrorCode::kInvalidParam);
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  results.clear();
+  std::vector<std::unique_ptr<Message>> responses;
+  // result of each member for the chunks which are not acked, a failed
+  // member is not sent the rest of them
+  std::vector<PresenterErrorCode> chunk_results(channels.size(),
+                                                PresenterErrorCode::kNone);
+  PresenterErrorCode error_code = PresenterErrorCode::kNone;
+  if (image.size > kChunkedImageThreshold) {
+    error_code = SendImageInChunks(req, image,
+        [&](const PartialMessageWithTlvs &message, bool last) {
+          if (last) {
+            return group.SendMessage(message, responses, results);
+          }
+
+          for (size_t i = 0; i < channels.size(); ++i) {
+            if (chunk_results[i] == PresenterErrorCode::kNone) {
+              chunk_results[i] = SendImageChunk(channels[i], message);
+            }
+          }
+
+          return PresenterErrorCode::kNone;
+        });
+    // no chunk is sent
+    if (results.size() != channels.size()) {
+      results.assign(channels.size(), error_code);
+      return error_code;
+    }
+  } else {
+    Tlv tlv;
+    tlv.tag = proto::PresentImageRequest::kDataFieldNumber;
+    tlv.length = image.size;
+    tlv.value = reinterpret_cast<char *>(image.data);
+
+    PartialMessageWithTlvs message;
+    message.message = &req;
+    message.tlv_list.push_back(tlv);
+    error_code = group.SendMessage(message, responses, results);
+  }
+
+  // each member checks the response of its own server
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (chunk_results[i] != PresenterErrorCode::kNone) {
+      results[i] = chunk_results[i];
+    } else if (results[i] == PresenterErrorCode::kNone) {
+      results[i] = PresenterMessageHelper::CheckPresentImageResponse(
+          *responses[i]);
+    }
+
+    if (results[i] != PresenterErrorCode::kNone
+        && error_code == PresenterErrorCode::kNone) {
+      error_code = results[i];
+    }
+  }
+
+  return error_code;
+}
+
+PresenterErrorCode PresentImageAsync(Channel *channel, const ImageFrame &image,
+                                     const PresentImageCallback &callback) {
+  if (channel == nullptr) {
+    AGENT_LOG_ERROR("channel is NULL");
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  proto::PresentImageRequest req;
+  if (!PresenterMessageHelper::InitPresentImageRequest(req, image)) {
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  auto send_async = [channel, callback](const PartialMessageWithTlvs &message) {
+    PresenterErrorCode error_code = channel->SendMessageAsync(
+        message,
+        [callback](PresenterErrorCode code, unique_ptr<Message>& response) {
+          if (code == PresenterErrorCode::kNone) {
+            code = PresenterMessageHelper::CheckPresentImageResponse(
+                *response);
+          } else {
+            AGENT_LOG_ERROR("Failed to present image, error = %d",
+                            static_cast<int>(code));
+          }
+
+          if (callback) {
+            callback(code);
+          }
+        });
+    if (error_code != PresenterErrorCode::kNone) {
+      AGENT_LOG_ERROR("Failed to present image, error = %d",
+                      static_cast<int>(error_code));
+    }
+
+    return error_code;
+  };
+
+  // the chunks before the last one are not acked, they are sent before
+  // returning, so only the last one is copied
+  if (image.size > kChunkedImageThreshold) {
+    return SendImageInChunks(req, image,
+        [channel, &send_async](const PartialMessageWithTlvs &message,
+                               bool last) {
+          return last ? send_async(message) : SendImageChunk(channel, message);
+        });
+  }
+
+  Tlv tlv;
+  tlv.tag = proto::PresentImageRequest::kDataFieldNumber;
+  tlv.length = image.size;
+  tlv.value = reinterpret_cast<char *>(image.data);
+
+  PartialMessageWithTlvs message;
+  message.message = &req;
+  message.tlv_list.push_back(tlv);
+  return send_async(message);
+}
+
 PresenterErrorCode SendMessage(
         Channel *channel, const google::protobuf::Message& message) {
     if (channel == nullptr) {
@@ -163,7 +531,8 @@ PresenterErrorCode SendMessage(
     unique_ptr<google::protobuf::Message> resp;
     PresenterErrorCode error_code = channel->SendMessage(message, resp);
     if (error_code != PresenterErrorCode::kNone) {
-        AGENT_LOG_ERROR("Failed to present image, error = %d", error_code);
+        AGENT_LOG_ERROR("Failed to present image, error = %d",
+                        static_cast<int>(error_code));
         return error_code;
     }
 
@@ -33,6 +33,7 @@
 
 #include "ascenddk/presenter/agent/presenter/presenter_channel_init_handler.h"
 
+#include "ascenddk/presenter/agent/codec/compression.h"
 #include "ascenddk/presenter/agent/presenter/presenter_message_helper.h"
 #include "ascenddk/presenter/agent/util/logging.h"
 
@@ -57,6 +58,14 @@ google::protobuf::Message* PresentChannelInitHandler::CreateInitRequest() {
       delete req;
       return nullptr;
     }
+
+    CompressionType type = param_.compression.type;
+    if (compression::IsSupported(type)) {
+      req->set_compression(static_cast<proto::CompressionType>(type));
+    } else {
+      AGENT_LOG_WARN("Compression %d is not built in, ignored",
+                     static_cast<int>(type));
+    }
   }
 
   return req;
@@ -65,14 +74,32 @@ google::protobuf::Message* PresentChannelInitHandler::CreateInitRequest() {
 bool PresentChannelInitHandler::CheckInitResponse(const Message& response) {
   error_code_ = PresenterMessageHelper::CheckOpenChannelResponse(response);
   if (error_code_ != PresenterErrorCode::kNone) {
-    AGENT_LOG_ERROR("OpenChannel failed, error = %d", error_code_);
+    AGENT_LOG_ERROR("OpenChannel failed, error = %d",
+                    static_cast<int>(error_code_));
+    return false;
+  }
+
+  // the response is checked to be an OpenChannelResponse
+  const proto::OpenChannelResponse& resp =
+      static_cast<const proto::OpenChannelResponse&>(response);
+  accepted_compression_ = static_cast<CompressionType>(resp.compression());
+  if (!compression::IsSupported(accepted_compression_)) {
+    accepted_compression_ = CompressionType::kNone;
   }
-  return error_code_ == PresenterErrorCode::kNone;
+
+  return true;
 }
 
 PresenterErrorCode PresentChannelInitHandler::GetErrorCode() const {
   return error_code_;
 }
 
+CompressionParam PresentChannelInitHandler::GetCompression() const {
+  CompressionParam param;
+  param.type = accepted_compression_;
+  param.threshold = param_.compression.threshold;
+  return param;
+}
+
 } /* namespace presenter */
 } /* namespace ascend */
@@ -73,9 +73,16 @@ class PresentChannelInitHandler : public InitChannelHandler {
    */
   PresenterErrorCode GetErrorCode() const;
 
+  /**
+   * @brief Get the compression accepted by the server
+   * @return CompressionParam
+   */
+  CompressionParam GetCompression() const override;
+
  private:
   OpenChannelParam param_;
   PresenterErrorCode error_code_ = PresenterErrorCode::kOther;
+  CompressionType accepted_compression_ = CompressionType::kNone;
 };
 
 } /* namespace presenter */
@@ -57,7 +57,8 @@ PresenterErrorCode PresenterMessageHelper::CreateOpenChannelRequest(
     } else if (content_type == ContentType::kVideo) {
         request.set_content_type(proto::kChannelContentTypeVideo);
     } else {
-        AGENT_LOG_ERROR("Unsupported content type: %d", content_type);
+        AGENT_LOG_ERROR("Unsupported content type: %d",
+                        static_cast<int>(content_type));
         return PresenterErrorCode::kInvalidParam;
     }
 
@@ -69,7 +70,8 @@ bool PresenterMessageHelper::InitPresentImageRequest(
     if (image.format == ImageFormat::kJpeg) {
         request.set_format(proto::kImageFormatJpeg);
     } else {  // other formats is not supported
-        AGENT_LOG_ERROR("Unsupported image format: %d", image.format);
+        AGENT_LOG_ERROR("Unsupported image format: %d",
+                        static_cast<int>(image.format));
         return false;
     }
 
@@ -103,6 +105,68 @@ bool PresenterMessageHelper::InitPresentImageRequest(
     return true;
 }
 
+bool PresenterMessageHelper::InitPresentImageBatchRequest(
+        proto::PresentImageBatchRequest& request,
+        const std::vector<ImageFrame>& images) {
+    if (images.empty()) {
+        AGENT_LOG_ERROR("Image list is empty");
+        return false;
+    }
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (!InitPresentImageRequest(*request.add_image_list(), images[i])) {
+            AGENT_LOG_ERROR("Invalid image in batch, index = %zu", i);
+            return false;
+        }
+    }
+
+    // like InitPresentImageRequest, data of the images is sent as TLVs
+    return true;
+}
+
+bool PresenterMessageHelper::InitPresentRoiRequest(
+        proto::PresentRoiRequest& request, const RoiFrame& frame) {
+    if (frame.format == ImageFormat::kJpeg) {
+        request.set_format(proto::kImageFormatJpeg);
+    } else {  // other formats is not supported
+        AGENT_LOG_ERROR("Unsupported image format: %d",
+                        static_cast<int>(frame.format));
+        return false;
+    }
+
+    // the low-res full frame is optional
+    if (frame.size > 0 && frame.data == nullptr) {
+        AGENT_LOG_ERROR("Frame data is NULL");
+        return false;
+    }
+
+    if (frame.crops.empty()) {
+        AGENT_LOG_ERROR("Crop list is empty");
+        return false;
+    }
+
+    request.set_width(frame.width);
+    request.set_height(frame.height);
+
+    for (size_t i = 0; i < frame.crops.size(); ++i) {
+        const RoiCrop& crop = frame.crops[i];
+        if (crop.data == nullptr || crop.size == 0) {
+            AGENT_LOG_ERROR("Invalid crop, index = %zu", i);
+            return false;
+        }
+
+        proto::Rectangle_Attr *rectangle_attr = request.add_rectangle_list();
+        rectangle_attr->mutable_left_top()->set_x(crop.region.lt.x);
+        rectangle_attr->mutable_left_top()->set_y(crop.region.lt.y);
+        rectangle_attr->mutable_right_bottom()->set_x(crop.region.rb.x);
+        rectangle_attr->mutable_right_bottom()->set_y(crop.region.rb.y);
+        rectangle_attr->set_label_text(crop.region.result_text);
+    }
+
+    // data of the frame and the crops is sent as TLVs
+    return true;
+}
+
 PresenterErrorCode PresenterMessageHelper::TranslateErrorCode(
         proto::OpenChannelErrorCode error_code) {
     switch (error_code) {
@@ -120,11 +184,10 @@ PresenterErrorCode PresenterMessageHelper::TranslateErrorCode(
 PresenterErrorCode PresenterMessageHelper::CheckOpenChannelResponse(
         const ::google::protobuf::Message& msg) {
 
-    string msg_name = msg.GetDescriptor()->full_name();
-    // check response
-    if (msg_name != proto::OpenChannelResponse::descriptor()->full_name()) {
+    // check response, descriptors are singletons
+    if (msg.GetDescriptor() != proto::OpenChannelResponse::descriptor()) {
         AGENT_LOG_ERROR("expecting OpenChannelResponse, but received %s",
-                     msg_name.c_str());
+                     msg.GetDescriptor()->full_name().c_str());
         return PresenterErrorCode::kOther;
     }
 
@@ -151,14 +214,13 @@ PresenterErrorCode PresenterMessageHelper::TranslateErrorCode(
 
 PresenterErrorCode PresenterMessageHelper::CheckPresentImageResponse(
         const ::google::protobuf::Message& msg) {
-    // check response
-    string msg_name = msg.GetDescriptor()->full_name();
+    // check response, descriptors are singletons
 
 	//УӦǷΪproto::PresentImageResponse
     // if the received message is not of the desired type
-    if (msg_name != proto::PresentImageResponse::descriptor()->full_name()) {
+    if (msg.GetDescriptor() != proto::PresentImageResponse::descriptor()) {
         AGENT_LOG_ERROR("expecting PresentImageResponse, but received %s",
-                     msg_name.c_str());
+                     msg.GetDescriptor()->full_name().c_str());
         return PresenterErrorCode::kOther;
     }
 
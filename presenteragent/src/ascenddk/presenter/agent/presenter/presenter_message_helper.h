@@ -35,6 +35,7 @@
 #define SRC_CHANNEL_PRESENTERMESSAGEHELPER_H_
 
 #include <memory>
+#include <vector>
 
 #include "ascenddk/presenter/agent/errors.h"
 #include "ascenddk/presenter/agent/presenter_types.h"
@@ -73,6 +74,26 @@ class PresenterMessageHelper {
   static bool InitPresentImageRequest(proto::PresentImageRequest& request,
                                       const ImageFrame& image);
 
+  /**
+   * @brief create PresentImageBatchRequest, data of the images is not set
+   * @param [out] request         request to set the properties
+   * @param [in] images           images, can not be empty
+   * @return true: success, false: failure
+   */
+  static bool InitPresentImageBatchRequest(
+      proto::PresentImageBatchRequest& request,
+      const std::vector<ImageFrame>& images);
+
+  /**
+   * @brief create PresentRoiRequest, data of the frame and the crops is
+   *        not set
+   * @param [out] request         request to set the properties
+   * @param [in] frame            frame, crops can not be empty
+   * @return true: success, false: failure
+   */
+  static bool InitPresentRoiRequest(proto::PresentRoiRequest& request,
+                                    const RoiFrame& frame);
+
   /**
    * @brief Check OpenChannelResponse
    * @param [in] msg              Open Channel Response
@@ -0,0 +1,207 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/recorder.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <google/protobuf/message.h>
+
+#include "ascenddk/presenter/agent/channel/default_channel.h"
+#include "ascenddk/presenter/agent/channel/event_loop_channel.h"
+#include "ascenddk/presenter/agent/codec/message_codec.h"
+#include "ascenddk/presenter/agent/presenter/presenter_message_helper.h"
+#include "ascenddk/presenter/agent/record/segment_log.h"
+#include "ascenddk/presenter/agent/util/logging.h"
+
+using namespace std;
+using namespace google::protobuf;
+
+namespace {
+
+int64_t NowInUs() {
+  return chrono::duration_cast<chrono::microseconds>(
+      chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}
+
+namespace ascend {
+namespace presenter {
+
+Recorder* Recorder::New(const RecorderParam &param) {
+  unique_ptr<SegmentLogWriter> writer(SegmentLogWriter::New(
+      param.dir, param.segment_size, param.max_segments));
+  if (writer == nullptr) {
+    return nullptr;
+  }
+
+  Recorder *recorder = new (nothrow) Recorder();
+  if (recorder == nullptr) {
+    return nullptr;
+  }
+
+  recorder->writer_ = std::move(writer);
+  return recorder;
+}
+
+Recorder::~Recorder() = default;
+
+PresenterErrorCode Recorder::RecordImage(const ImageFrame &image) {
+  proto::PresentImageRequest req;
+  if (!PresenterMessageHelper::InitPresentImageRequest(req, image)) {
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  Tlv tlv;
+  tlv.tag = proto::PresentImageRequest::kDataFieldNumber;
+  tlv.length = image.size;
+  tlv.value = reinterpret_cast<char *>(image.data);
+
+  PartialMessageWithTlvs message;
+  message.message = &req;
+  message.tlv_list.push_back(tlv);
+
+  // record what would be sent, replaying needs no encoding
+  MessageCodec codec;
+  vector<SharedByteBuffer> buffers;
+  try {
+    if (!codec.EncodeMessage(message, buffers)) {
+      AGENT_LOG_ERROR("Failed to encode image");
+      return PresenterErrorCode::kCodec;
+    }
+  } catch (std::exception &e) {  // protobuf may throw FatalException
+    AGENT_LOG_ERROR("Protobuf error: %s", e.what());
+    return PresenterErrorCode::kCodec;
+  }
+
+  return writer_->Append(buffers, NowInUs());
+}
+
+void Recorder::Seal() {
+  writer_->Seal();
+}
+
+// send the encoded message and read the response
+static PresenterErrorCode SendEncodedMessage(
+    Channel *channel, const vector<SharedByteBuffer>& buffers,
+    unique_ptr<Message>& response) {
+  EventLoopChannel *loop_channel = dynamic_cast<EventLoopChannel*>(channel);
+  if (loop_channel != nullptr) {
+    return loop_channel->SendEncodedMessage(buffers, response);
+  }
+
+  DefaultChannel *default_channel = dynamic_cast<DefaultChannel*>(channel);
+  if (default_channel != nullptr) {
+    return default_channel->SendEncodedMessage(buffers, response);
+  }
+
+  // unknown channel type can only send the message itself
+  const SharedByteBuffer& buffer = buffers.front();
+  MessageCodec codec;
+  unique_ptr<Message> message(codec.DecodeMessage(
+      buffer.Get() + MessageCodec::kPacketLengthSize,
+      buffer.Size() - MessageCodec::kPacketLengthSize));
+  if (message == nullptr) {
+    return PresenterErrorCode::kCodec;
+  }
+
+  return channel->SendMessage(*message, response);
+}
+
+PresenterErrorCode ReplayRecording(Channel *channel, const string &dir,
+                                   ReplayMode mode) {
+  if (channel == nullptr) {
+    AGENT_LOG_ERROR("channel is NULL");
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  PresenterErrorCode error_code = PresenterErrorCode::kNone;
+  uint32_t replayed = 0;
+  bool started = false;
+  int64_t first_timestamp_us = 0;
+  chrono::steady_clock::time_point start_time;
+  PresenterErrorCode read_ret = SegmentLogReader::Consume(dir,
+      [&](const char* data, uint32_t length, int64_t timestamp_us) {
+    // skipped, or replaying would stop at it every time
+    if (length <= MessageCodec::kPacketLengthSize) {
+      AGENT_LOG_ERROR("Invalid record skipped, length = %u", length);
+      return true;
+    }
+
+    if (!started) {
+      started = true;
+      first_timestamp_us = timestamp_us;
+      start_time = chrono::steady_clock::now();
+    } else if (mode == ReplayMode::kOriginalTiming
+        && timestamp_us > first_timestamp_us) {
+      this_thread::sleep_until(start_time + chrono::microseconds(
+          timestamp_us - first_timestamp_us));
+    }
+
+    // the mapping of the segment is released after reading
+    SharedByteBuffer buffer = SharedByteBuffer::Make(length);
+    if (buffer.IsEmpty()) {
+      error_code = PresenterErrorCode::kBadAlloc;
+      return false;
+    }
+
+    memcpy(buffer.GetMutable(), data, length);
+    vector<SharedByteBuffer> buffers(1, buffer);
+    unique_ptr<Message> response;
+    error_code = SendEncodedMessage(channel, buffers, response);
+    if (error_code == PresenterErrorCode::kNone) {
+      error_code = PresenterMessageHelper::CheckPresentImageResponse(
+          *response);
+    }
+
+    if (error_code != PresenterErrorCode::kNone) {
+      return false;
+    }
+
+    ++replayed;
+    return true;
+  });
+
+  AGENT_LOG_INFO("%u recorded images replayed from %s", replayed, dir.c_str());
+  if (read_ret != PresenterErrorCode::kNone) {
+    return read_ret;
+  }
+
+  return error_code;
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
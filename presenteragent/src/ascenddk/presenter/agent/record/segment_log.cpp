@@ -0,0 +1,491 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/record/segment_log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ascenddk/presenter/agent/util/logging.h"
+
+using namespace std;
+
+namespace {
+
+// "PSEG"
+const uint32_t kSegmentMagic = 0x47455350;
+const uint32_t kSegmentVersion = 1;
+
+const char kSegmentPrefix[] = "segment_";
+const char kSegmentSuffix[] = ".log";
+
+struct SegmentHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t record_count;
+  uint32_t data_end;
+  uint32_t sealed;
+  uint32_t replayed_count;
+};
+
+struct IndexEntry {
+  uint32_t offset;
+  uint32_t length;
+  int64_t timestamp_us;
+};
+
+// file permission of segments
+const mode_t kSegmentFileMode = 0640;
+
+// parse sequence from file name, false if not a segment
+bool ParseSequence(const char* name, uint32_t& sequence) {
+  size_t prefix_len = sizeof(kSegmentPrefix) - 1;
+  size_t suffix_len = sizeof(kSegmentSuffix) - 1;
+  size_t len = strlen(name);
+  if (len <= prefix_len + suffix_len
+      || strncmp(name, kSegmentPrefix, prefix_len) != 0
+      || strcmp(name + len - suffix_len, kSegmentSuffix) != 0) {
+    return false;
+  }
+
+  uint64_t value = 0;
+  for (size_t i = prefix_len; i < len - suffix_len; ++i) {
+    if (name[i] < '0' || name[i] > '9') {
+      return false;
+    }
+
+    value = value * 10 + (name[i] - '0');
+    if (value > UINT32_MAX) {
+      return false;
+    }
+  }
+
+  sequence = static_cast<uint32_t>(value);
+  return true;
+}
+
+IndexEntry* GetIndexEntry(char* base, uint32_t segment_size, uint32_t index) {
+  return reinterpret_cast<IndexEntry*>(
+      base + segment_size - sizeof(IndexEntry) * (index + 1));
+}
+
+// check the index entry of a record, false if the record is out of range
+bool IsValidEntry(const IndexEntry* entry, uint32_t size, uint32_t count) {
+  uint32_t index_begin = size - count * sizeof(IndexEntry);
+  return entry->offset >= sizeof(SegmentHeader) && entry->offset <= index_begin
+      && entry->length <= index_begin - entry->offset;
+}
+
+// map a segment and check its header, NULL if the segment is invalid
+char* MapSegment(const string& path, bool writable, uint32_t& size) {
+  int fd = open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+  if (fd < 0) {
+    // removed by the writer for the disk budget
+    AGENT_LOG_WARN("Failed to open segment %s, errno = %d", path.c_str(),
+                   errno);
+    return nullptr;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0
+      || st.st_size < static_cast<off_t>(
+          ascend::presenter::SegmentLogWriter::kMinSegmentSize)
+      || st.st_size > static_cast<off_t>(
+          ascend::presenter::SegmentLogWriter::kMaxSegmentSize)) {
+    AGENT_LOG_WARN("Invalid segment %s", path.c_str());
+    close(fd);
+    return nullptr;
+  }
+
+  size = static_cast<uint32_t>(st.st_size);
+  int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  void *base = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    AGENT_LOG_WARN("Failed to map segment %s, errno = %d", path.c_str(),
+                   errno);
+    return nullptr;
+  }
+
+  const SegmentHeader *header = static_cast<const SegmentHeader*>(base);
+  uint32_t count = __atomic_load_n(&header->record_count, __ATOMIC_ACQUIRE);
+  if (header->magic != kSegmentMagic || header->version != kSegmentVersion
+      || count > (size - sizeof(SegmentHeader)) / sizeof(IndexEntry)) {
+    AGENT_LOG_WARN("Invalid segment %s", path.c_str());
+    munmap(base, size);
+    return nullptr;
+  }
+
+  return static_cast<char*>(base);
+}
+
+}
+
+namespace ascend {
+namespace presenter {
+
+SegmentLogWriter* SegmentLogWriter::New(const string& dir,
+                                        uint32_t segment_size,
+                                        uint32_t max_segments) {
+  if (dir.empty() || max_segments == 0 || segment_size < kMinSegmentSize
+      || segment_size > kMaxSegmentSize) {
+    AGENT_LOG_ERROR("Invalid segment log param, segment_size = %u, "
+                    "max_segments = %u", segment_size, max_segments);
+    return nullptr;
+  }
+
+  SegmentLogWriter *writer = new (nothrow) SegmentLogWriter(dir, segment_size,
+                                                            max_segments);
+  if (writer == nullptr) {
+    return nullptr;
+  }
+
+  writer->LoadSegments();
+  return writer;
+}
+
+SegmentLogWriter::SegmentLogWriter(const string& dir, uint32_t segment_size,
+                                   uint32_t max_segments)
+    : dir_(dir),
+      segment_size_(segment_size),
+      max_segments_(max_segments),
+      next_sequence_(0),
+      fd_(-1),
+      base_(nullptr) {
+}
+
+SegmentLogWriter::~SegmentLogWriter() {
+  CloseSegment();
+}
+
+void SegmentLogWriter::LoadSegments() {
+  vector<uint32_t> sequences;
+  if (!SegmentLogReader::ListSegments(dir_, sequences)) {
+    return;
+  }
+
+  segments_.assign(sequences.begin(), sequences.end());
+  if (!segments_.empty()) {
+    next_sequence_ = segments_.back() + 1;
+  }
+
+  // the last segment of a crashed writer is not sealed, records are never
+  // appended to these segments again
+  uint32_t sealed = 1;
+  for (uint32_t sequence : sequences) {
+    string path = SegmentLogReader::GetSegmentPath(dir_, sequence);
+    int fd = open(path.c_str(), O_WRONLY);
+    if (fd < 0) {
+      continue;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(
+        sizeof(SegmentHeader))) {
+      ssize_t ret = pwrite(fd, &sealed, sizeof(sealed),
+                           offsetof(SegmentHeader, sealed));
+      if (ret != static_cast<ssize_t>(sizeof(sealed))) {
+        AGENT_LOG_WARN("Failed to seal segment %s, errno = %d", path.c_str(),
+                       errno);
+      }
+    }
+
+    close(fd);
+  }
+}
+
+void SegmentLogWriter::Seal() {
+  lock_guard<mutex> lock(mtx_);
+  CloseSegment();
+}
+
+void SegmentLogWriter::CloseSegment() {
+  if (base_ != nullptr) {
+    SegmentHeader *header = reinterpret_cast<SegmentHeader*>(base_);
+    __atomic_store_n(&header->sealed, 1, __ATOMIC_RELEASE);
+
+    // let the kernel write back the dirty pages in background
+    msync(base_, segment_size_, MS_ASYNC);
+    munmap(base_, segment_size_);
+    base_ = nullptr;
+  }
+
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+PresenterErrorCode SegmentLogWriter::Roll() {
+  CloseSegment();
+
+  // remove the oldest segments to keep the disk budget
+  while (segments_.size() >= max_segments_) {
+    string path = SegmentLogReader::GetSegmentPath(dir_, segments_.front());
+    if (unlink(path.c_str()) != 0 && errno != ENOENT) {
+      AGENT_LOG_ERROR("Failed to remove segment %s, errno = %d",
+                      path.c_str(), errno);
+      return PresenterErrorCode::kOther;
+    }
+
+    segments_.pop_front();
+  }
+
+  string path = SegmentLogReader::GetSegmentPath(dir_, next_sequence_);
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, kSegmentFileMode);
+  if (fd < 0) {
+    AGENT_LOG_ERROR("Failed to create segment %s, errno = %d", path.c_str(),
+                    errno);
+    return PresenterErrorCode::kOther;
+  }
+
+  // allocate the whole segment now, so that appending never fails for
+  // lack of disk space
+  int ret = posix_fallocate(fd, 0, segment_size_);
+  if (ret != 0) {
+    AGENT_LOG_ERROR("Failed to allocate segment %s, error = %d", path.c_str(),
+                    ret);
+    close(fd);
+    unlink(path.c_str());
+    return PresenterErrorCode::kOther;
+  }
+
+  void *base = mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    AGENT_LOG_ERROR("Failed to map segment %s, errno = %d", path.c_str(),
+                    errno);
+    close(fd);
+    unlink(path.c_str());
+    return PresenterErrorCode::kOther;
+  }
+
+  fd_ = fd;
+  base_ = static_cast<char*>(base);
+  SegmentHeader *header = reinterpret_cast<SegmentHeader*>(base_);
+  header->magic = kSegmentMagic;
+  header->version = kSegmentVersion;
+  header->record_count = 0;
+  header->data_end = sizeof(SegmentHeader);
+  header->sealed = 0;
+  header->replayed_count = 0;
+
+  segments_.push_back(next_sequence_);
+  ++next_sequence_;
+  return PresenterErrorCode::kNone;
+}
+
+PresenterErrorCode SegmentLogWriter::Append(
+    const vector<SharedByteBuffer>& buffers, int64_t timestamp_us) {
+  uint64_t length = 0;
+  for (const SharedByteBuffer& buffer : buffers) {
+    length += buffer.Size();
+  }
+
+  uint64_t max_length = segment_size_ - sizeof(SegmentHeader)
+      - sizeof(IndexEntry);
+  if (length == 0 || length > max_length) {
+    AGENT_LOG_ERROR("Record size %lu does not fit in a segment",
+                    static_cast<unsigned long>(length));
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  lock_guard<mutex> lock(mtx_);
+  SegmentHeader *header = reinterpret_cast<SegmentHeader*>(base_);
+  if (base_ == nullptr
+      || header->data_end + length
+          > segment_size_ - sizeof(IndexEntry) * (header->record_count + 1)) {
+    PresenterErrorCode error_code = Roll();
+    if (error_code != PresenterErrorCode::kNone) {
+      return error_code;
+    }
+
+    header = reinterpret_cast<SegmentHeader*>(base_);
+  }
+
+  uint32_t offset = header->data_end;
+  char *pos = base_ + offset;
+  for (const SharedByteBuffer& buffer : buffers) {
+    memcpy(pos, buffer.Get(), buffer.Size());
+    pos += buffer.Size();
+  }
+
+  IndexEntry *entry = GetIndexEntry(base_, segment_size_,
+                                    header->record_count);
+  entry->offset = offset;
+  entry->length = static_cast<uint32_t>(length);
+  entry->timestamp_us = timestamp_us;
+  header->data_end = offset + static_cast<uint32_t>(length);
+
+  // publish the record after its data and index entry
+  __atomic_store_n(&header->record_count, header->record_count + 1,
+                   __ATOMIC_RELEASE);
+  return PresenterErrorCode::kNone;
+}
+
+string SegmentLogReader::GetSegmentPath(const string& dir, uint32_t sequence) {
+  char name[sizeof(kSegmentPrefix) + sizeof(kSegmentSuffix) + 10];
+  snprintf(name, sizeof(name), "%s%010u%s", kSegmentPrefix, sequence,
+           kSegmentSuffix);
+  return dir + "/" + name;
+}
+
+bool SegmentLogReader::ListSegments(const string& dir,
+                                    vector<uint32_t>& sequences) {
+  DIR *d = opendir(dir.c_str());
+  if (d == nullptr) {
+    AGENT_LOG_ERROR("Failed to open directory %s, errno = %d", dir.c_str(),
+                    errno);
+    return false;
+  }
+
+  struct dirent *ent = nullptr;
+  while ((ent = readdir(d)) != nullptr) {
+    uint32_t sequence = 0;
+    if (ParseSequence(ent->d_name, sequence)) {
+      sequences.push_back(sequence);
+    }
+  }
+
+  closedir(d);
+  sort(sequences.begin(), sequences.end());
+  return true;
+}
+
+PresenterErrorCode SegmentLogReader::ReadAll(const string& dir,
+                                             const RecordVisitor& visitor) {
+  vector<uint32_t> sequences;
+  if (!ListSegments(dir, sequences)) {
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  for (uint32_t sequence : sequences) {
+    string path = GetSegmentPath(dir, sequence);
+    uint32_t size = 0;
+    char *data = MapSegment(path, false, size);
+    if (data == nullptr) {
+      continue;
+    }
+
+    const SegmentHeader *header = reinterpret_cast<const SegmentHeader*>(data);
+    uint32_t count = __atomic_load_n(&header->record_count, __ATOMIC_ACQUIRE);
+    bool go_on = true;
+    for (uint32_t i = 0; i < count && go_on; ++i) {
+      const IndexEntry *entry = GetIndexEntry(data, size, i);
+      if (!IsValidEntry(entry, size, count)) {
+        AGENT_LOG_WARN("Invalid record %u in segment %s", i, path.c_str());
+        break;
+      }
+
+      go_on = visitor(data + entry->offset, entry->length,
+                      entry->timestamp_us);
+    }
+
+    munmap(data, size);
+    if (!go_on) {
+      break;
+    }
+  }
+
+  return PresenterErrorCode::kNone;
+}
+
+PresenterErrorCode SegmentLogReader::Consume(const string& dir,
+                                             const RecordVisitor& visitor) {
+  vector<uint32_t> sequences;
+  if (!ListSegments(dir, sequences)) {
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  for (uint32_t sequence : sequences) {
+    string path = GetSegmentPath(dir, sequence);
+    uint32_t size = 0;
+    char *data = MapSegment(path, true, size);
+    if (data == nullptr) {
+      continue;
+    }
+
+    // the segment being written to, and the ones after it, are left to
+    // the next call
+    SegmentHeader *header = reinterpret_cast<SegmentHeader*>(data);
+    if (__atomic_load_n(&header->sealed, __ATOMIC_ACQUIRE) == 0) {
+      munmap(data, size);
+      break;
+    }
+
+    uint32_t count = header->record_count;
+    bool go_on = true;
+    while (header->replayed_count < count && go_on) {
+      const IndexEntry *entry = GetIndexEntry(data, size,
+                                              header->replayed_count);
+      if (!IsValidEntry(entry, size, count)) {
+        // the records after it can not be located either
+        AGENT_LOG_WARN("Invalid record %u in segment %s",
+                       header->replayed_count, path.c_str());
+        header->replayed_count = count;
+        break;
+      }
+
+      go_on = visitor(data + entry->offset, entry->length,
+                      entry->timestamp_us);
+      if (go_on) {
+        // the checkpoint, written back with the page by the kernel
+        ++header->replayed_count;
+      }
+    }
+
+    bool consumed = header->replayed_count >= count;
+    munmap(data, size);
+    if (consumed && unlink(path.c_str()) != 0 && errno != ENOENT) {
+      AGENT_LOG_WARN("Failed to remove segment %s, errno = %d", path.c_str(),
+                     errno);
+    }
+
+    if (!go_on) {
+      break;
+    }
+  }
+
+  return PresenterErrorCode::kNone;
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
@@ -0,0 +1,203 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_RECORD_SEGMENT_LOG_H_
+#define ASCENDDK_PRESENTER_AGENT_RECORD_SEGMENT_LOG_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ascenddk/presenter/agent/errors.h"
+#include "ascenddk/presenter/agent/util/byte_buffer.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * A log of records kept in preallocated, memory-mapped segment files named
+ * segment_<sequence>.log. Each segment has the following structure
+ *    --------------------------------------------------------------------
+ *    |Field Name          |  Size(bytes)   |    Type                     |
+ *    --------------------------------------------------------------------
+ *    |magic               |       4        |    uint32, "PSEG"           |
+ *    |-------------------------------------------------------------------
+ *    |version             |       4        |    uint32                   |
+ *    |-------------------------------------------------------------------
+ *    |record count        |       4        |    uint32                   |
+ *    |-------------------------------------------------------------------
+ *    |data end            |       4        |    uint32, offset           |
+ *    |-------------------------------------------------------------------
+ *    |sealed              |       4        |    uint32, 1: no more       |
+ *    |                    |                |    records are appended     |
+ *    |-------------------------------------------------------------------
+ *    |replayed count      |       4        |    uint32, records consumed |
+ *    |-------------------------------------------------------------------
+ *    |records             |      Var.      |    growing forward          |
+ *    |-------------------------------------------------------------------
+ *    |free space          |      Var.      |                             |
+ *    |-------------------------------------------------------------------
+ *    |index               |  16 * count    |    growing backward from    |
+ *    |                    |                |    the end of file          |
+ *    --------------------------------------------------------------------
+ * The i-th index entry is at (segment size - 16 * (i + 1)), it holds the
+ * offset(uint32), length(uint32) and timestamp in us(int64) of a record.
+ * Fields are in host byte order. Record count is updated last, so a
+ * record is either complete or invisible if the process crashes.
+ * A segment is sealed when the writer moves to the next one or is closed,
+ * segments left unsealed by a crashed writer are sealed by the next writer
+ * of the directory. Only sealed segments are consumed, the replayed count
+ * is the checkpoint of the consumer
+ */
+class SegmentLogWriter {
+ public:
+  // smallest and largest size of a segment
+  static const uint32_t kMinSegmentSize = 64 * 1024;
+  static const uint32_t kMaxSegmentSize = 1024 * 1024 * 1024;
+
+  /**
+   * @brief create a writer, segments already in the directory are kept
+   *        and count in the budget
+   * @param [in] dir                  directory of segments, must exist
+   * @param [in] segment_size         size of each segment
+   * @param [in] max_segments         max number of segments, the oldest
+   *                                  segment is removed when exceeded
+   * @return writer, NULL if any of the parameters is invalid
+   */
+  static SegmentLogWriter* New(const std::string& dir, uint32_t segment_size,
+                               uint32_t max_segments);
+
+  ~SegmentLogWriter();
+
+  /**
+   * @brief append a record, thread safe
+   * @param [in] buffers              data of the record, concatenated
+   * @param [in] timestamp_us         timestamp of the record
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode Append(const std::vector<SharedByteBuffer>& buffers,
+                            int64_t timestamp_us);
+
+  /**
+   * @brief seal current segment, the next record is appended to a new one,
+   *        thread safe
+   */
+  void Seal();
+
+ private:
+  SegmentLogWriter(const std::string& dir, uint32_t segment_size,
+                   uint32_t max_segments);
+
+  /**
+   * @brief find the segments left by previous writers, and seal them
+   */
+  void LoadSegments();
+
+  /**
+   * @brief close current segment and create the next one
+   */
+  PresenterErrorCode Roll();
+
+  void CloseSegment();
+
+  std::string dir_;
+  uint32_t segment_size_;
+  uint32_t max_segments_;
+
+  std::mutex mtx_;
+  // sequences of segments on disk, oldest first
+  std::deque<uint32_t> segments_;
+  uint32_t next_sequence_;
+
+  // current segment
+  int fd_;
+  char *base_;
+};
+
+/**
+ * Reads records of the segments in a directory, oldest first
+ */
+class SegmentLogReader {
+ public:
+  /**
+   * Invoked with each record, returns false to stop reading
+   */
+  typedef std::function<bool(const char* data, uint32_t length,
+                             int64_t timestamp_us)> RecordVisitor;
+
+  /**
+   * @brief read all records
+   * @param [in] dir                  directory of segments
+   * @param [in] visitor              invoked with each record
+   * @return PresenterErrorCode, kNone if all segments are read, or the
+   *         visitor stopped reading
+   */
+  static PresenterErrorCode ReadAll(const std::string& dir,
+                                    const RecordVisitor& visitor);
+
+  /**
+   * @brief read the records of sealed segments not consumed yet. A record
+   *        is consumed once the visitor returns true for it, and a segment
+   *        is removed once all of its records are consumed. The next call
+   *        starts from the record the visitor returned false for. Records
+   *        of a crashed consumer may be visited again
+   * @param [in] dir                  directory of segments
+   * @param [in] visitor              invoked with each record
+   * @return PresenterErrorCode, kNone if all sealed segments are read, or
+   *         the visitor stopped reading
+   */
+  static PresenterErrorCode Consume(const std::string& dir,
+                                    const RecordVisitor& visitor);
+
+  /**
+   * @brief list sequences of the segments in a directory, oldest first
+   * @param [in] dir                  directory of segments
+   * @param [out] sequences           sequences
+   * @return true: success, false: the directory can not be read
+   */
+  static bool ListSegments(const std::string& dir,
+                           std::vector<uint32_t>& sequences);
+
+  /**
+   * @brief get the path of a segment
+   */
+  static std::string GetSegmentPath(const std::string& dir, uint32_t sequence);
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_RECORD_SEGMENT_LOG_H_ */
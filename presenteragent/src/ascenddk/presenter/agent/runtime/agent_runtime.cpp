@@ -0,0 +1,115 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/agent_runtime.h"
+#include "ascenddk/presenter/agent/runtime/agent_runtime.h"
+
+#include "ascenddk/presenter/agent/util/logging.h"
+
+using namespace std;
+
+namespace {
+const int kMaxIoThreadNum = 16;
+}
+
+namespace ascend {
+namespace presenter {
+
+AgentRuntime& AgentRuntime::GetInstance() {
+  static AgentRuntime instance;
+  return instance;
+}
+
+AgentRuntime::AgentRuntime()
+    : next_loop_(0) {
+}
+
+PresenterErrorCode AgentRuntime::Start(int io_thread_num) {
+  if (io_thread_num <= 0 || io_thread_num > kMaxIoThreadNum) {
+    AGENT_LOG_ERROR("Invalid io_thread_num: %d, should be 1 ~ %d",
+                    io_thread_num, kMaxIoThreadNum);
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  lock_guard<mutex> lock(mtx_);
+  if (!loops_.empty()) {
+    AGENT_LOG_WARN("Agent runtime is already started");
+    return PresenterErrorCode::kNone;
+  }
+
+  vector<shared_ptr<EventLoop>> loops;
+  for (int i = 0; i < io_thread_num; ++i) {
+    shared_ptr<EventLoop> loop(EventLoop::New());
+    if (loop == nullptr) {
+      AGENT_LOG_ERROR("Failed to start event loop");
+      return PresenterErrorCode::kOther;
+    }
+
+    loops.push_back(loop);
+  }
+
+  loops_.swap(loops);
+  AGENT_LOG_INFO("Agent runtime started, io_thread_num = %d", io_thread_num);
+  return PresenterErrorCode::kNone;
+}
+
+void AgentRuntime::Stop() {
+  vector<shared_ptr<EventLoop>> loops;
+  {
+    lock_guard<mutex> lock(mtx_);
+    loops.swap(loops_);
+  }
+
+  // loops without channels are stopped here, outside the lock
+  loops.clear();
+}
+
+shared_ptr<EventLoop> AgentRuntime::GetEventLoop() {
+  lock_guard<mutex> lock(mtx_);
+  if (loops_.empty()) {
+    return nullptr;
+  }
+
+  return loops_[next_loop_++ % loops_.size()];
+}
+
+PresenterErrorCode StartAgentRuntime(int io_thread_num) {
+  return AgentRuntime::GetInstance().Start(io_thread_num);
+}
+
+void StopAgentRuntime() {
+  AgentRuntime::GetInstance().Stop();
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
@@ -0,0 +1,88 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_RUNTIME_AGENT_RUNTIME_H_
+#define ASCENDDK_PRESENTER_AGENT_RUNTIME_AGENT_RUNTIME_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ascenddk/presenter/agent/errors.h"
+#include "ascenddk/presenter/agent/runtime/event_loop.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Process wide event loops shared by all channels
+ */
+class AgentRuntime {
+ public:
+  static AgentRuntime& GetInstance();
+
+  /**
+   * @brief start event loops
+   * @param [in] io_thread_num      number of event loops
+   * @return PresenterErrorCode
+   */
+  PresenterErrorCode Start(int io_thread_num);
+
+  /**
+   * @brief release event loops, a loop stops once no channel uses it
+   */
+  void Stop();
+
+  /**
+   * @brief pick an event loop for a new channel, in round robin
+   * @return event loop, NULL if runtime is not started
+   */
+  std::shared_ptr<EventLoop> GetEventLoop();
+
+  // Disable copy constructor and assignment operator
+  AgentRuntime(const AgentRuntime&) = delete;
+  AgentRuntime& operator=(const AgentRuntime&) = delete;
+
+ private:
+  AgentRuntime();
+
+  std::mutex mtx_;
+  std::vector<std::shared_ptr<EventLoop>> loops_;
+  uint32_t next_loop_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_RUNTIME_AGENT_RUNTIME_H_ */
@@ -0,0 +1,690 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/runtime/async_connection.h"
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+
+#include "proto/presenter_message.pb.h"
+
+#include "ascenddk/presenter/agent/util/logging.h"
+#include "ascenddk/presenter/agent/util/socket_utils.h"
+
+using namespace std;
+using google::protobuf::Message;
+
+namespace {
+
+// same as the heartbeat interval of DefaultChannel
+const int64_t kHeartbeatIntervalInMs = 1500;
+
+// same as the socket timeout of RawSocketFactory
+const int64_t kConnectTimeoutInMs = 3000;
+const int64_t kResponseTimeoutInMs = 3000;
+
+// max time to wait for the loop thread to close the connection
+const int kShutdownTimeoutInSec = 5;
+
+// max buffers written in one sendmsg()
+const int kMaxIovCount = 64;
+
+// max messages queued for sending per connection
+const int kMaxQueuedMessages = 256;
+
+const int kInvalidSocket = -1;
+
+int64_t NowInMs() {
+  return chrono::duration_cast<chrono::milliseconds>(
+      chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+namespace ascend {
+namespace presenter {
+
+shared_ptr<AsyncConnection> AsyncConnection::New(
+    EventLoop* loop, const string& host_ip, uint16_t port,
+    shared_ptr<InitChannelHandler> handler) {
+  if (loop == nullptr) {
+    AGENT_LOG_ERROR("event loop is null");
+    return nullptr;
+  }
+
+  return shared_ptr<AsyncConnection>(
+      new (nothrow) AsyncConnection(loop, host_ip, port, handler));
+}
+
+AsyncConnection::AsyncConnection(EventLoop* loop, const string& host_ip,
+                                 uint16_t port,
+                                 shared_ptr<InitChannelHandler> handler)
+    : loop_(loop),
+      host_ip_(host_ip),
+      port_(port),
+      init_handler_(handler),
+      state_(State::kDisconnected),
+      socket_(kInvalidSocket),
+      want_write_(false),
+      auto_reconnect_(false),
+      connect_deadline_ms_(0),
+      reconnect_at_ms_(0),
+      last_heartbeat_ms_(0),
+      write_buf_index_(0),
+      write_buf_offset_(0),
+      header_read_(0),
+      body_read_(0),
+      open_(false),
+      queued_messages_(0) {
+}
+
+AsyncConnection::~AsyncConnection() {
+  // normally closed by Shutdown()
+  socketutils::CloseSocket(socket_);
+}
+
+void AsyncConnection::SetMessageListener(
+    const function<void(unique_ptr<Message>&)>& listener) {
+  listener_ = listener;
+}
+
+bool AsyncConnection::IsOpen() const {
+  return open_;
+}
+
+void AsyncConnection::Open(
+    const function<void(PresenterErrorCode)>& callback) {
+  shared_ptr<AsyncConnection> self = shared_from_this();
+  loop_->RunInLoop([self, callback]() {
+    if (self->state_ == State::kClosed) {
+      callback(PresenterErrorCode::kConnection);
+      return;
+    }
+
+    if (self->state_ == State::kOpen) {
+      callback(PresenterErrorCode::kNone);
+      return;
+    }
+
+    self->open_callbacks_.push_back(callback);
+    if (self->state_ == State::kDisconnected) {
+      self->StartConnect();
+    }
+  });
+}
+
+PresenterErrorCode AsyncConnection::Send(const PartialMessageWithTlvs& message,
+                                         bool expect_response,
+                                         const ResponseCallback& callback) {
+  if (message.message == nullptr) {
+    AGENT_LOG_ERROR("message is null");
+    return PresenterErrorCode::kInvalidParam;
+  }
+
+  // do not waste encoding on a broken connection
+  if (!open_) {
+    AGENT_LOG_ERROR("Channel is not open, send message failed");
+    return PresenterErrorCode::kConnection;
+  }
+
+  // encode in caller's thread, the loop thread only does I/O
+  vector<SharedByteBuffer> buffers;
+  try {
+    if (!codec_.EncodeMessage(message, buffers)) {
+      AGENT_LOG_ERROR("Failed to encode message");
+      return PresenterErrorCode::kCodec;
+    }
+  } catch (std::exception &e) {  // protobuf may throw FatalException
+    AGENT_LOG_ERROR("Protobuf error: %s", e.what());
+    return PresenterErrorCode::kCodec;
+  }
+
+  return SendEncoded(buffers, expect_response, callback);
+}
+
+PresenterErrorCode AsyncConnection::SendEncoded(
+    const vector<SharedByteBuffer>& buffers, bool expect_response,
+    const ResponseCallback& callback) {
+  if (!open_) {
+    AGENT_LOG_ERROR("Channel is not open, send message failed");
+    return PresenterErrorCode::kConnection;
+  }
+
+  if (queued_messages_ >= kMaxQueuedMessages) {
+    AGENT_LOG_ERROR("Too many messages queued: %d", queued_messages_.load());
+    return PresenterErrorCode::kOther;
+  }
+
+  shared_ptr<OutgoingMessage> msg(new (nothrow) OutgoingMessage());
+  if (msg == nullptr) {
+    return PresenterErrorCode::kBadAlloc;
+  }
+
+  // buffers are shared, not copied, they are never modified once encoded
+  msg->buffers = buffers;
+  msg->expect_response = expect_response;
+  msg->callback = callback;
+
+  ++queued_messages_;
+  shared_ptr<AsyncConnection> self = shared_from_this();
+  loop_->RunInLoop([self, msg]() {
+    // connection may be broken after the message is submitted
+    if (self->state_ != State::kOpen) {
+      --self->queued_messages_;
+      if (msg->callback) {
+        unique_ptr<Message> no_response;
+        msg->callback(PresenterErrorCode::kConnection, no_response);
+      }
+      return;
+    }
+
+    self->Enqueue(msg);
+  });
+
+  return PresenterErrorCode::kNone;
+}
+
+void AsyncConnection::Shutdown() {
+  if (loop_->IsInLoopThread()) {
+    AGENT_LOG_WARN("channel is closed in event loop thread");
+    state_ = State::kClosed;
+    loop_->RemoveTicker(this);
+    CloseWithError(PresenterErrorCode::kConnection);
+    return;
+  }
+
+  shared_ptr<promise<void>> done(new (nothrow) promise<void>());
+  if (done == nullptr) {
+    return;
+  }
+
+  shared_ptr<AsyncConnection> self = shared_from_this();
+  loop_->RunInLoop([self, done]() {
+    self->state_ = State::kClosed;
+    self->loop_->RemoveTicker(self.get());
+    self->CloseWithError(PresenterErrorCode::kConnection);
+    done->set_value();
+  });
+
+  future<void> result = done->get_future();
+  if (result.wait_for(chrono::seconds(kShutdownTimeoutInSec))
+      != future_status::ready) {
+    AGENT_LOG_ERROR("Timeout when closing connection to %s:%u",
+                    host_ip_.c_str(), port_);
+  }
+}
+
+void AsyncConnection::StartConnect() {
+  loop_->AddTicker(this);
+  connect_deadline_ms_ = NowInMs() + kConnectTimeoutInMs;
+
+  sockaddr_in addr;
+  if (!socketutils::SetSockAddr(host_ip_.c_str(), port_, addr)) {
+    AGENT_LOG_ERROR("Invalid address: %s:%d", host_ip_.c_str(), port_);
+    CloseWithError(PresenterErrorCode::kInvalidParam);
+    return;
+  }
+
+  socket_ = socketutils::CreateSocket();
+  if (socket_ == socketutils::kSocketError) {
+    AGENT_LOG_ERROR("socket() error: %s", strerror(errno));
+    socket_ = kInvalidSocket;
+    CloseWithError(PresenterErrorCode::kConnection);
+    return;
+  }
+
+  int ret = socketutils::ConnectNonBlocking(socket_, addr);
+  if (ret == socketutils::kSocketError) {
+    AGENT_LOG_ERROR("Failed to connect to server: %s:%u",
+                    host_ip_.c_str(), port_);
+    CloseWithError(PresenterErrorCode::kConnection);
+    return;
+  }
+
+  // wait for writable to know the result of connecting
+  if (!loop_->AddFd(socket_, EPOLLOUT, this)) {
+    CloseWithError(PresenterErrorCode::kConnection);
+    return;
+  }
+
+  state_ = State::kConnecting;
+  want_write_ = true;
+  if (ret != socketutils::kSocketInProgress) {
+    OnConnected();
+  }
+}
+
+void AsyncConnection::OnConnected() {
+  AGENT_LOG_INFO("Connected to server %s:%d, socket file descriptor = %d",
+                 host_ip_.c_str(), port_, socket_);
+  if (!loop_->ModifyFd(socket_, EPOLLIN, this)) {
+    CloseWithError(PresenterErrorCode::kConnection);
+    return;
+  }
+
+  want_write_ = false;
+  state_ = State::kInitializing;
+  connect_deadline_ms_ = NowInMs() + kResponseTimeoutInMs;
+  if (init_handler_ == nullptr) {
+    OnOpened();
+    return;
+  }
+
+  unique_ptr<Message> request(init_handler_->CreateInitRequest());
+  if (request == nullptr) {
+    AGENT_LOG_ERROR("App create init request failed");
+    CloseWithError(PresenterErrorCode::kAppDefinedError);
+    return;
+  }
+
+  shared_ptr<OutgoingMessage> msg(new (nothrow) OutgoingMessage());
+  if (msg == nullptr) {
+    CloseWithError(PresenterErrorCode::kBadAlloc);
+    return;
+  }
+
+  PartialMessageWithTlvs init_msg;
+  init_msg.message = request.get();
+  if (!codec_.EncodeMessage(init_msg, msg->buffers)) {
+    AGENT_LOG_ERROR("Failed to encode init request");
+    CloseWithError(PresenterErrorCode::kCodec);
+    return;
+  }
+
+  // the callback is invoked by this connection only, so this is valid
+  msg->expect_response = true;
+  msg->callback = [this](PresenterErrorCode error_code,
+                         unique_ptr<Message>& response) {
+    // on error, open callbacks are notified by CloseWithError()
+    if (error_code != PresenterErrorCode::kNone) {
+      return;
+    }
+
+    if (!init_handler_->CheckInitResponse(*response)) {
+      AGENT_LOG_ERROR("App check response failed");
+      CloseWithError(PresenterErrorCode::kAppDefinedError);
+      return;
+    }
+
+    codec_.SetCompression(init_handler_->GetCompression());
+    OnOpened();
+  };
+
+  ++queued_messages_;
+  Enqueue(msg);
+}
+
+void AsyncConnection::OnOpened() {
+  state_ = State::kOpen;
+  open_ = true;
+  auto_reconnect_ = true;
+  last_heartbeat_ms_ = NowInMs();
+  NotifyOpenResult(PresenterErrorCode::kNone);
+}
+
+void AsyncConnection::NotifyOpenResult(PresenterErrorCode error_code) {
+  vector<function<void(PresenterErrorCode)>> callbacks;
+  callbacks.swap(open_callbacks_);
+  for (auto it = callbacks.begin(); it != callbacks.end(); ++it) {
+    (*it)(error_code);
+  }
+}
+
+void AsyncConnection::Enqueue(const shared_ptr<OutgoingMessage>& message) {
+  write_queue_.push_back(message);
+
+  // if EPOLLOUT is subscribed, socket buffer is full, wait for the event
+  if (!want_write_ && !FlushWrites()) {
+    CloseWithError(PresenterErrorCode::kConnection);
+  }
+}
+
+bool AsyncConnection::FlushWrites() {
+  while (!write_queue_.empty()) {
+    // gather buffers of queued messages into one sendmsg()
+    iovec iov[kMaxIovCount];
+    int iov_cnt = 0;
+    for (auto it = write_queue_.begin();
+        it != write_queue_.end() && iov_cnt < kMaxIovCount; ++it) {
+      bool is_front = (it == write_queue_.begin());
+      const vector<SharedByteBuffer>& buffers = (*it)->buffers;
+      for (size_t i = is_front ? write_buf_index_ : 0;
+          i < buffers.size() && iov_cnt < kMaxIovCount; ++i) {
+        uint32_t offset =
+            (is_front && i == write_buf_index_) ? write_buf_offset_ : 0;
+        iov[iov_cnt].iov_base = buffers[i].GetMutable() + offset;
+        iov[iov_cnt].iov_len = buffers[i].Size() - offset;
+        ++iov_cnt;
+      }
+    }
+
+    int ret = socketutils::WriteSome(socket_, iov, iov_cnt);
+    if (ret == socketutils::kSocketInProgress) {
+      UpdateEvents(true);
+      return true;
+    }
+
+    if (ret < 0) {
+      return false;
+    }
+
+    // advance the write position, and complete written messages
+    size_t written = static_cast<size_t>(ret);
+    while (!write_queue_.empty()) {
+      shared_ptr<OutgoingMessage> msg = write_queue_.front();
+      while (write_buf_index_ < msg->buffers.size()) {
+        size_t remaining = msg->buffers[write_buf_index_].Size()
+            - write_buf_offset_;
+        if (written < remaining) {
+          write_buf_offset_ += written;
+          written = 0;
+          break;
+        }
+
+        written -= remaining;
+        ++write_buf_index_;
+        write_buf_offset_ = 0;
+      }
+
+      if (write_buf_index_ < msg->buffers.size()) {
+        break;
+      }
+
+      write_queue_.pop_front();
+      write_buf_index_ = 0;
+      --queued_messages_;
+      if (msg->expect_response) {
+        PendingResponse pending;
+        pending.callback = msg->callback;
+        pending.deadline_ms = NowInMs() + kResponseTimeoutInMs;
+        pending_responses_.push_back(pending);
+      } else if (msg->callback) {
+        unique_ptr<Message> no_response;
+        msg->callback(PresenterErrorCode::kNone, no_response);
+      }
+    }
+  }
+
+  UpdateEvents(false);
+  return true;
+}
+
+void AsyncConnection::UpdateEvents(bool want_write) {
+  if (socket_ == kInvalidSocket || want_write == want_write_) {
+    return;
+  }
+
+  uint32_t events = want_write ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+  if (loop_->ModifyFd(socket_, events, this)) {
+    want_write_ = want_write;
+  }
+}
+
+PresenterErrorCode AsyncConnection::HandleRead() {
+  while (socket_ != kInvalidSocket) {
+    // read 4 bytes header
+    if (header_read_ < MessageCodec::kPacketLengthSize) {
+      int ret = socketutils::ReadSome(
+          socket_, header_buf_ + header_read_,
+          MessageCodec::kPacketLengthSize - header_read_);
+      if (ret == socketutils::kSocketInProgress) {
+        return PresenterErrorCode::kNone;
+      }
+
+      if (ret < 0) {
+        return PresenterErrorCode::kConnection;
+      }
+
+      header_read_ += ret;
+      if (header_read_ < MessageCodec::kPacketLengthSize) {
+        continue;
+      }
+
+      uint32_t total_size = 0;
+      (void) memcpy(&total_size, header_buf_, sizeof(total_size));
+      total_size = ntohl(total_size);
+      uint32_t remaining_size = total_size - MessageCodec::kPacketLengthSize;
+      if (remaining_size == 0
+          || remaining_size > MessageCodec::kMaxPacketSize) {
+        AGENT_LOG_ERROR("received malformed message, size field = %u",
+                        total_size);
+        return PresenterErrorCode::kCodec;
+      }
+
+      body_buf_.resize(remaining_size);
+      body_read_ = 0;
+    }
+
+    int ret = socketutils::ReadSome(socket_, body_buf_.data() + body_read_,
+                                    body_buf_.size() - body_read_);
+    if (ret == socketutils::kSocketInProgress) {
+      return PresenterErrorCode::kNone;
+    }
+
+    if (ret < 0) {
+      return PresenterErrorCode::kConnection;
+    }
+
+    body_read_ += ret;
+    if (body_read_ < body_buf_.size()) {
+      continue;
+    }
+
+    // a whole message is received, start over for the next one
+    header_read_ = 0;
+    unique_ptr<Message> message;
+    try {
+      message.reset(codec_.DecodeMessage(body_buf_.data(), body_buf_.size()));
+    } catch (std::exception &e) {  // protobuf may throw FatalException
+      AGENT_LOG_ERROR("Protobuf error: %s", e.what());
+    }
+
+    if (message == nullptr) {
+      return PresenterErrorCode::kCodec;
+    }
+
+    Dispatch(message);
+  }
+
+  // closed while dispatching
+  return PresenterErrorCode::kNone;
+}
+
+void AsyncConnection::Dispatch(unique_ptr<Message>& message) {
+  if (!pending_responses_.empty()) {
+    ResponseCallback callback = pending_responses_.front().callback;
+    pending_responses_.pop_front();
+    if (callback) {
+      callback(PresenterErrorCode::kNone, message);
+    }
+    return;
+  }
+
+  if (listener_) {
+    listener_(message);
+    return;
+  }
+
+  AGENT_LOG_WARN("Unexpected message dropped: %s",
+                 message->GetDescriptor()->name().c_str());
+}
+
+void AsyncConnection::HandleEvents(uint32_t events) {
+  if (state_ == State::kConnecting) {
+    int error = socketutils::GetSocketError(socket_);
+    if (error != 0) {
+      AGENT_LOG_ERROR("Failed to connect to server: %s:%u, error: %s",
+                      host_ip_.c_str(), port_, strerror(error));
+      CloseWithError(PresenterErrorCode::kConnection);
+      return;
+    }
+
+    OnConnected();
+    return;
+  }
+
+  // read before handling hang up, so that the last response is not lost
+  if ((events & EPOLLIN) != 0) {
+    PresenterErrorCode error_code = HandleRead();
+    if (error_code != PresenterErrorCode::kNone) {
+      CloseWithError(error_code);
+      return;
+    }
+  }
+
+  if (socket_ == kInvalidSocket) {
+    return;
+  }
+
+  if ((events & (EPOLLERR | EPOLLHUP)) != 0) {
+    AGENT_LOG_ERROR("Connection to %s:%u is broken", host_ip_.c_str(), port_);
+    CloseWithError(PresenterErrorCode::kConnection);
+    return;
+  }
+
+  if ((events & EPOLLOUT) != 0 && !FlushWrites()) {
+    CloseWithError(PresenterErrorCode::kConnection);
+  }
+}
+
+void AsyncConnection::HandleTick() {
+  int64_t now = NowInMs();
+  switch (state_) {
+    case State::kDisconnected:
+      // reopen channel if disconnected
+      if (auto_reconnect_ && now >= reconnect_at_ms_) {
+        StartConnect();
+      }
+      break;
+
+    case State::kConnecting:
+    case State::kInitializing:
+      if (now >= connect_deadline_ms_) {
+        AGENT_LOG_ERROR("Timeout when opening connection to %s:%u",
+                        host_ip_.c_str(), port_);
+        CloseWithError(PresenterErrorCode::kConnection);
+      }
+      break;
+
+    case State::kOpen:
+      if (!pending_responses_.empty()
+          && now >= pending_responses_.front().deadline_ms) {
+        AGENT_LOG_ERROR("Read response timeout");
+        CloseWithError(PresenterErrorCode::kSocketTimeout);
+        break;
+      }
+
+      if (now - last_heartbeat_ms_ >= kHeartbeatIntervalInMs) {
+        last_heartbeat_ms_ = now;
+        SendHeartbeat();
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+void AsyncConnection::SendHeartbeat() {
+  shared_ptr<OutgoingMessage> msg(new (nothrow) OutgoingMessage());
+  if (msg == nullptr) {
+    return;
+  }
+
+  proto::HeartbeatMessage heartbeat_msg;
+  PartialMessageWithTlvs heartbeat;
+  heartbeat.message = &heartbeat_msg;
+  if (!codec_.EncodeMessage(heartbeat, msg->buffers)) {
+    return;
+  }
+
+  msg->expect_response = false;
+  ++queued_messages_;
+  Enqueue(msg);
+}
+
+void AsyncConnection::CloseWithError(PresenterErrorCode error_code) {
+  if (socket_ != kInvalidSocket) {
+    loop_->RemoveFd(socket_);
+    socketutils::CloseSocket(socket_);
+  }
+
+  if (state_ != State::kClosed) {
+    state_ = State::kDisconnected;
+  }
+
+  open_ = false;
+  want_write_ = false;
+  header_read_ = 0;
+  body_read_ = 0;
+  reconnect_at_ms_ = NowInMs() + kHeartbeatIntervalInMs;
+
+  // ticks are only needed to reconnect a connection once opened, the next
+  // Open() starts ticking again
+  if (!auto_reconnect_) {
+    loop_->RemoveTicker(this);
+  }
+
+  // the opening is failed
+  NotifyOpenResult(error_code);
+
+  // fail all messages, callbacks may queue new messages, which are failed
+  // since the connection is not open
+  deque<shared_ptr<OutgoingMessage>> write_queue;
+  write_queue.swap(write_queue_);
+  write_buf_index_ = 0;
+  write_buf_offset_ = 0;
+  deque<PendingResponse> pending_responses;
+  pending_responses.swap(pending_responses_);
+
+  unique_ptr<Message> no_response;
+  for (auto it = pending_responses.begin(); it != pending_responses.end();
+      ++it) {
+    if (it->callback) {
+      it->callback(error_code, no_response);
+    }
+  }
+
+  for (auto it = write_queue.begin(); it != write_queue.end(); ++it) {
+    --queued_messages_;
+    if ((*it)->callback) {
+      (*it)->callback(error_code, no_response);
+    }
+  }
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
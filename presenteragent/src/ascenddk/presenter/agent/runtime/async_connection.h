@@ -0,0 +1,250 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_RUNTIME_ASYNC_CONNECTION_H_
+#define ASCENDDK_PRESENTER_AGENT_RUNTIME_ASYNC_CONNECTION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <google/protobuf/message.h>
+
+#include "ascenddk/presenter/agent/channel.h"
+#include "ascenddk/presenter/agent/codec/message_codec.h"
+#include "ascenddk/presenter/agent/errors.h"
+#include "ascenddk/presenter/agent/runtime/event_loop.h"
+#include "ascenddk/presenter/agent/util/byte_buffer.h"
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Non-blocking connection between agent and server, driven by an EventLoop
+ *
+ * The connection is a state machine which runs in the loop thread:
+ *   kDisconnected -> kConnecting -> kInitializing -> kOpen
+ * any error moves it back to kDisconnected, and once it has been opened it
+ * reconnects automatically, the same way as DefaultChannel's heartbeat does.
+ * Messages are written with partial write support, responses are matched
+ * to requests in FIFO order
+ */
+class AsyncConnection : public EventHandler,
+    public std::enable_shared_from_this<AsyncConnection> {
+ public:
+  /**
+   * @brief create a connection, nothing is done until Open() is called
+   * @param [in] loop               event loop serving the connection
+   * @param [in] host_ip            host IP of server
+   * @param [in] port               port of server
+   * @param [in] handler            init handler, can be NULL
+   * @return connection, NULL if failed
+   */
+  static std::shared_ptr<AsyncConnection> New(
+      EventLoop* loop, const std::string& host_ip, uint16_t port,
+      std::shared_ptr<InitChannelHandler> handler);
+
+  virtual ~AsyncConnection();
+
+  /**
+   * @brief connect and initialize the connection, thread safe
+   * @param [in] callback           invoked once the connection is open
+   *                                or failed to open
+   */
+  void Open(const std::function<void(PresenterErrorCode)>& callback);
+
+  /**
+   * @brief encode the message in caller's thread and queue it for sending,
+   *        thread safe
+   * @param [in] message            message
+   * @param [in] expect_response    whether the server replies the message
+   * @param [in] callback           invoked when the response arrives, or
+   *                                when the message is sent if no response
+   *                                is expected, can be NULL
+   * @return PresenterErrorCode, the callback is invoked only if kNone
+   */
+  PresenterErrorCode Send(const PartialMessageWithTlvs& message,
+                          bool expect_response,
+                          const ResponseCallback& callback);
+
+  /**
+   * @brief queue a message encoded by MessageCodec for sending, the
+   *        buffers are shared rather than copied, thread safe
+   * @param [in] buffers            encoded buffers, in sending order
+   * @param [in] expect_response    whether the server replies the message
+   * @param [in] callback           same as Send()
+   * @return PresenterErrorCode, the callback is invoked only if kNone
+   */
+  PresenterErrorCode SendEncoded(const std::vector<SharedByteBuffer>& buffers,
+                                 bool expect_response,
+                                 const ResponseCallback& callback);
+
+  /**
+   * @brief set the listener of messages which are not a response of
+   *        any request, must be called before Open()
+   * @param [in] listener           listener
+   */
+  void SetMessageListener(
+      const std::function<void(std::unique_ptr<google::protobuf::Message>&)>&
+          listener);
+
+  /**
+   * @brief close the connection and fail all queued messages, block until
+   *        finished. No callback is invoked after Shutdown() returns
+   */
+  void Shutdown();
+
+  /**
+   * @brief whether the connection is open
+   * @return true: open
+   */
+  bool IsOpen() const;
+
+  /**
+   * @brief handle socket events, loop thread only
+   * @param [in] events             epoll events
+   */
+  virtual void HandleEvents(uint32_t events) override;
+
+  /**
+   * @brief handle timeouts, heartbeat and reconnecting, loop thread only
+   */
+  virtual void HandleTick() override;
+
+ private:
+  enum class State {
+    kDisconnected,
+    kConnecting,
+    kInitializing,
+    kOpen,
+    kClosed,
+  };
+
+  // a message waiting for sending
+  struct OutgoingMessage {
+    std::vector<SharedByteBuffer> buffers;
+    bool expect_response;
+    ResponseCallback callback;
+  };
+
+  // a sent message waiting for response
+  struct PendingResponse {
+    ResponseCallback callback;
+    int64_t deadline_ms;
+  };
+
+  AsyncConnection(EventLoop* loop, const std::string& host_ip, uint16_t port,
+                  std::shared_ptr<InitChannelHandler> handler);
+
+  void StartConnect();
+  void OnConnected();
+  void OnOpened();
+
+  /**
+   * @brief queue an encoded message, loop thread only
+   */
+  void Enqueue(const std::shared_ptr<OutgoingMessage>& message);
+
+  /**
+   * @brief write queued messages until socket buffer is full
+   * @return false if connection is broken
+   */
+  bool FlushWrites();
+
+  /**
+   * @brief read and dispatch messages until no data available
+   * @return PresenterErrorCode, kNone unless connection is broken
+   */
+  PresenterErrorCode HandleRead();
+
+  /**
+   * @brief dispatch a received message to the oldest pending response
+   */
+  void Dispatch(std::unique_ptr<google::protobuf::Message>& message);
+
+  void SendHeartbeat();
+
+  /**
+   * @brief subscribe or unsubscribe EPOLLOUT
+   */
+  void UpdateEvents(bool want_write);
+
+  /**
+   * @brief close socket and fail all queued and pending messages
+   * @param [in] error_code         error passed to callbacks
+   */
+  void CloseWithError(PresenterErrorCode error_code);
+
+  void NotifyOpenResult(PresenterErrorCode error_code);
+
+  EventLoop *loop_;
+  std::string host_ip_;
+  uint16_t port_;
+  std::shared_ptr<InitChannelHandler> init_handler_;
+  MessageCodec codec_;
+
+  // states below are accessed in loop thread only
+  State state_;
+  int socket_;
+  bool want_write_;
+  bool auto_reconnect_;
+  int64_t connect_deadline_ms_;
+  int64_t reconnect_at_ms_;
+  int64_t last_heartbeat_ms_;
+
+  std::deque<std::shared_ptr<OutgoingMessage>> write_queue_;
+  // position in front message of write_queue_
+  size_t write_buf_index_;
+  uint32_t write_buf_offset_;
+  std::deque<PendingResponse> pending_responses_;
+  std::vector<std::function<void(PresenterErrorCode)>> open_callbacks_;
+  std::function<void(std::unique_ptr<google::protobuf::Message>&)> listener_;
+
+  // read state
+  char header_buf_[MessageCodec::kPacketLengthSize];
+  uint32_t header_read_;
+  std::vector<char> body_buf_;
+  uint32_t body_read_;
+
+  // accessed by any thread
+  std::atomic_bool open_;
+  std::atomic_int queued_messages_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_RUNTIME_ASYNC_CONNECTION_H_ */
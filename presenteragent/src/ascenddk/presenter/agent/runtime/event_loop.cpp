@@ -0,0 +1,257 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/runtime/event_loop.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "ascenddk/presenter/agent/util/logging.h"
+
+using namespace std;
+
+namespace {
+
+// max events handled in one epoll_wait
+const int kMaxEvents = 64;
+
+// tick interval of connections
+const int64_t kTickIntervalInMs = 500;
+
+const int kInvalidFd = -1;
+
+// wait before calling epoll_wait() again if it failed
+const int64_t kErrorRetryIntervalInMs = 10;
+
+int64_t NowInMs() {
+  return chrono::duration_cast<chrono::milliseconds>(
+      chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+namespace ascend {
+namespace presenter {
+
+EventLoop* EventLoop::New() {
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd == kInvalidFd) {
+    AGENT_LOG_ERROR("epoll_create1() error: %s", strerror(errno));
+    return nullptr;
+  }
+
+  int wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeup_fd == kInvalidFd) {
+    AGENT_LOG_ERROR("eventfd() error: %s", strerror(errno));
+    (void) close(epoll_fd);
+    return nullptr;
+  }
+
+  EventLoop *loop = new (nothrow) EventLoop(epoll_fd, wakeup_fd);
+  if (loop == nullptr) {
+    (void) close(wakeup_fd);
+    (void) close(epoll_fd);
+    return nullptr;
+  }
+
+  // the wakeup fd is registered with a NULL handler
+  epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.ptr = nullptr;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &ev) != 0) {
+    AGENT_LOG_ERROR("epoll_ctl() error: %s", strerror(errno));
+    delete loop;
+    return nullptr;
+  }
+
+  loop->thread_.reset(new (nothrow) thread(bind(&EventLoop::Loop, loop)));
+  if (loop->thread_ == nullptr) {
+    delete loop;
+    return nullptr;
+  }
+
+  AGENT_LOG_INFO("event loop started");
+  return loop;
+}
+
+EventLoop::EventLoop(int epoll_fd, int wakeup_fd)
+    : epoll_fd_(epoll_fd),
+      wakeup_fd_(wakeup_fd),
+      quit_(false),
+      next_tick_ms_(0),
+      loop_thread_id_(thread::id()) {
+}
+
+EventLoop::~EventLoop() {
+  quit_ = true;
+  if (thread_ != nullptr) {
+    Wakeup();
+    thread_->join();
+  }
+
+  (void) close(wakeup_fd_);
+  (void) close(epoll_fd_);
+}
+
+bool EventLoop::IsInLoopThread() const {
+  return this_thread::get_id() == loop_thread_id_.load();
+}
+
+void EventLoop::RunInLoop(const function<void()>& task) {
+  {
+    unique_lock<mutex> lock(task_mtx_);
+    tasks_.push_back(task);
+  }
+
+  Wakeup();
+}
+
+void EventLoop::Wakeup() {
+  uint64_t one = 1;
+  ssize_t ret = write(wakeup_fd_, &one, sizeof(one));
+  if (ret != sizeof(one)) {
+    // EAGAIN means the counter is saturated, the loop will wake up anyway
+    AGENT_LOG_DEBUG("wakeup event loop failed: %s", strerror(errno));
+  }
+}
+
+bool EventLoop::AddFd(int fd, uint32_t events, EventHandler* handler) {
+  epoll_event ev;
+  ev.events = events;
+  ev.data.ptr = handler;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    AGENT_LOG_ERROR("epoll_ctl(ADD) error: %s", strerror(errno));
+    return false;
+  }
+
+  return true;
+}
+
+bool EventLoop::ModifyFd(int fd, uint32_t events, EventHandler* handler) {
+  epoll_event ev;
+  ev.events = events;
+  ev.data.ptr = handler;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) != 0) {
+    AGENT_LOG_ERROR("epoll_ctl(MOD) error: %s", strerror(errno));
+    return false;
+  }
+
+  return true;
+}
+
+void EventLoop::RemoveFd(int fd) {
+  // a closed fd is removed from epoll automatically, ignore the error
+  (void) epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void EventLoop::AddTicker(EventHandler* handler) {
+  tickers_.insert(handler);
+}
+
+void EventLoop::RemoveTicker(EventHandler* handler) {
+  tickers_.erase(handler);
+}
+
+void EventLoop::RunPendingTasks() {
+  // swap out the tasks, so tasks can be posted while running
+  vector<function<void()>> tasks;
+  {
+    unique_lock<mutex> lock(task_mtx_);
+    tasks.swap(tasks_);
+  }
+
+  for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+    (*it)();
+  }
+}
+
+void EventLoop::RunTickers() {
+  int64_t now = NowInMs();
+  if (now < next_tick_ms_) {
+    return;
+  }
+
+  next_tick_ms_ = now + kTickIntervalInMs;
+  // a handler may remove itself in HandleTick()
+  vector<EventHandler*> tickers(tickers_.begin(), tickers_.end());
+  for (auto it = tickers.begin(); it != tickers.end(); ++it) {
+    if (tickers_.count(*it) != 0) {
+      (*it)->HandleTick();
+    }
+  }
+}
+
+void EventLoop::Loop() {
+  loop_thread_id_ = this_thread::get_id();
+  epoll_event events[kMaxEvents];
+  next_tick_ms_ = NowInMs() + kTickIntervalInMs;
+  while (!quit_) {
+    int n = epoll_wait(epoll_fd_, events, kMaxEvents,
+                       static_cast<int>(kTickIntervalInMs));
+    if (n < 0) {
+      // keep running the tasks and tickers, they may be waited by other
+      // threads, and do not spin on a persistent error
+      if (errno != EINTR) {
+        AGENT_LOG_ERROR("epoll_wait() error: %s", strerror(errno));
+        this_thread::sleep_for(chrono::milliseconds(kErrorRetryIntervalInMs));
+      }
+      n = 0;
+    }
+
+    for (int i = 0; i < n; ++i) {
+      EventHandler *handler = static_cast<EventHandler*>(events[i].data.ptr);
+      if (handler == nullptr) {
+        // drain the wakeup counter
+        uint64_t count = 0;
+        (void) read(wakeup_fd_, &count, sizeof(count));
+        continue;
+      }
+
+      handler->HandleEvents(events[i].events);
+    }
+
+    RunPendingTasks();
+    RunTickers();
+  }
+
+  // run the remaining tasks, they may be waited by other threads
+  RunPendingTasks();
+  AGENT_LOG_DEBUG("event loop ended");
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
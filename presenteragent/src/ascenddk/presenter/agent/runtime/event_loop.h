@@ -0,0 +1,183 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_RUNTIME_EVENT_LOOP_H_
+#define ASCENDDK_PRESENTER_AGENT_RUNTIME_EVENT_LOOP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Receives the events of a file descriptor registered to an EventLoop,
+ * all methods are invoked in the loop thread
+ */
+class EventHandler {
+ public:
+  virtual ~EventHandler() = default;
+
+  /**
+   * @brief handle epoll events of the file descriptor
+   * @param [in] events         EPOLLIN, EPOLLOUT, EPOLLERR, ...
+   */
+  virtual void HandleEvents(uint32_t events) = 0;
+
+  /**
+   * @brief called periodically, used for timeouts and heartbeats
+   */
+  virtual void HandleTick() = 0;
+};
+
+/**
+ * An epoll based event loop which runs on its own thread. Connections
+ * owned by the loop are only touched in the loop thread, other threads
+ * talk to them through RunInLoop()
+ */
+class EventLoop {
+ public:
+  /**
+   * @brief create and start an event loop
+   * @return pointer to the loop, NULL if failed
+   */
+  static EventLoop* New();
+
+  /**
+   * @brief stop the loop and wait for the thread to exit, must not be
+   *        called in the loop thread
+   */
+  ~EventLoop();
+
+  // Disable copy constructor and assignment operator
+  EventLoop(const EventLoop&) = delete;
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  /**
+   * @brief run the task in the loop thread, tasks run in posting order
+   * @param [in] task           task
+   */
+  void RunInLoop(const std::function<void()>& task);
+
+  /**
+   * @brief check whether the caller is the loop thread
+   * @return true: in loop thread
+   */
+  bool IsInLoopThread() const;
+
+  /**
+   * @brief register a file descriptor, loop thread only
+   * @param [in] fd             file descriptor
+   * @param [in] events         interested epoll events
+   * @param [in] handler        event handler
+   * @return true: success, false: failure
+   */
+  bool AddFd(int fd, uint32_t events, EventHandler* handler);
+
+  /**
+   * @brief change interested events of a file descriptor, loop thread only
+   * @param [in] fd             file descriptor
+   * @param [in] events         interested epoll events
+   * @param [in] handler        event handler
+   * @return true: success, false: failure
+   */
+  bool ModifyFd(int fd, uint32_t events, EventHandler* handler);
+
+  /**
+   * @brief unregister a file descriptor, loop thread only
+   * @param [in] fd             file descriptor
+   */
+  void RemoveFd(int fd);
+
+  /**
+   * @brief receive HandleTick() periodically, loop thread only
+   * @param [in] handler        event handler
+   */
+  void AddTicker(EventHandler* handler);
+
+  /**
+   * @brief stop receiving HandleTick(), loop thread only
+   * @param [in] handler        event handler
+   */
+  void RemoveTicker(EventHandler* handler);
+
+ private:
+  EventLoop(int epoll_fd, int wakeup_fd);
+
+  /**
+   * @brief thread function
+   */
+  void Loop();
+
+  /**
+   * @brief wake up the loop thread from epoll_wait
+   */
+  void Wakeup();
+
+  /**
+   * @brief run all posted tasks
+   */
+  void RunPendingTasks();
+
+  /**
+   * @brief call HandleTick() of tickers if the tick interval elapsed
+   */
+  void RunTickers();
+
+  int epoll_fd_;
+  int wakeup_fd_;
+  std::atomic_bool quit_;
+
+  std::mutex task_mtx_;
+  std::vector<std::function<void()>> tasks_;
+
+  std::set<EventHandler*> tickers_;
+  int64_t next_tick_ms_;
+
+  std::unique_ptr<std::thread> thread_;
+
+  // set by the loop thread itself, thread_ may not be assigned yet when
+  // the loop starts running
+  std::atomic<std::thread::id> loop_thread_id_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_RUNTIME_EVENT_LOOP_H_ */
@@ -0,0 +1,388 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/util/buffer_pool.h"
+
+#include <new>
+
+#include "ascenddk/presenter/agent/util/logging.h"
+
+namespace {
+
+// size of the smallest class is 1 << kMinSizeShift
+const int kMinSizeShift = 8;
+
+// classes up to 1MB are cached by threads
+const int kMaxThreadCachedClass = 12;
+
+// bytes of a class a thread caches, and max number of blocks
+const std::uint32_t kThreadCacheBytesPerClass = 1024 * 1024;
+const int kMaxThreadCachedBlocks = 16;
+
+// allocations served by a thread cache are published every
+// kStatsFlushInterval allocations, to keep atomics off the fast path
+const std::uint32_t kStatsFlushInterval = 64;
+
+// limit of the global free lists
+const std::uint64_t kMaxGlobalCachedBytes = 64 * 1024 * 1024;
+
+static_assert(sizeof(ascend::presenter::BufferBlock) % 16 == 0,
+              "data of a block must be 16 bytes aligned");
+
+int SizeClassOf(std::uint32_t size) {
+  if (size <= (1U << kMinSizeShift)) {
+    return 0;
+  }
+
+  // ceil(log2(size)) - kMinSizeShift
+  return 32 - __builtin_clz(size - 1) - kMinSizeShift;
+}
+
+std::uint32_t ClassCapacity(int size_class) {
+  return 1U << (size_class + kMinSizeShift);
+}
+
+int ThreadCacheLimit(int size_class) {
+  if (size_class > kMaxThreadCachedClass) {
+    return 0;
+  }
+
+  int limit = kThreadCacheBytesPerClass / ClassCapacity(size_class);
+  return limit > kMaxThreadCachedBlocks ? kMaxThreadCachedBlocks : limit;
+}
+
+}
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Free blocks cached by a thread, returned to the global free lists when
+ * the thread exits
+ */
+class ThreadCache {
+ public:
+  ThreadCache() : heads_(), counts_(), allocations_(0), hits_(0) {}
+  ~ThreadCache();
+
+  /**
+   * @brief pop a block of the class, refill from the global free list in
+   *        batch if the cache is empty
+   * @param [in] pool           pool
+   * @param [in] size_class     size class
+   * @return block, NULL if neither the cache nor the global list has one
+   */
+  BufferBlock* Pop(BufferPool& pool, int size_class);
+
+  /**
+   * @brief push a block, flush half of the cache to the global free list if
+   *        the cache is full
+   * @param [in] pool           pool
+   * @param [in] block          block
+   */
+  void Push(BufferPool& pool, BufferBlock* block);
+
+ private:
+  /**
+   * @brief publish the counters of the thread to the pool
+   * @param [in] pool           pool
+   */
+  void FlushStats(BufferPool& pool);
+
+  BufferBlock* heads_[BufferPool::kNumSizeClasses];
+  int counts_[BufferPool::kNumSizeClasses];
+  std::uint32_t allocations_;
+  std::uint32_t hits_;
+};
+
+namespace {
+
+thread_local ThreadCache t_cache;
+
+// set once t_cache is destroyed, buffers released later by the thread, e.g.
+// by destructors of other thread locals, go to the global free lists
+thread_local bool t_cache_destroyed = false;
+
+}
+
+ThreadCache::~ThreadCache() {
+  BufferPool& pool = BufferPool::GetInstance();
+  for (int i = 0; i < BufferPool::kNumSizeClasses; ++i) {
+    if (heads_[i] != nullptr) {
+      pool.PushGlobal(i, heads_[i]);
+      heads_[i] = nullptr;
+      counts_[i] = 0;
+    }
+  }
+
+  FlushStats(pool);
+  t_cache_destroyed = true;
+}
+
+void ThreadCache::FlushStats(BufferPool& pool) {
+  pool.allocations_.fetch_add(allocations_, std::memory_order_relaxed);
+  pool.thread_cache_hits_.fetch_add(hits_, std::memory_order_relaxed);
+  allocations_ = 0;
+  hits_ = 0;
+}
+
+BufferBlock* ThreadCache::Pop(BufferPool& pool, int size_class) {
+  if (++allocations_ == kStatsFlushInterval) {
+    FlushStats(pool);
+  }
+
+  if (heads_[size_class] == nullptr) {
+    // classes not cached by threads are taken one by one
+    int batch = ThreadCacheLimit(size_class) / 2;
+    if (batch == 0) {
+      batch = 1;
+    }
+
+    heads_[size_class] = pool.PopGlobal(size_class, batch,
+                                        counts_[size_class]);
+    if (heads_[size_class] == nullptr) {
+      return nullptr;
+    }
+
+    pool.global_hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    ++hits_;
+  }
+
+  BufferBlock* block = heads_[size_class];
+  heads_[size_class] = block->next;
+  --counts_[size_class];
+  return block;
+}
+
+void ThreadCache::Push(BufferPool& pool, BufferBlock* block) {
+  int size_class = block->size_class;
+  int limit = ThreadCacheLimit(size_class);
+  block->next = heads_[size_class];
+  heads_[size_class] = block;
+  if (++counts_[size_class] <= limit) {
+    return;
+  }
+
+  // keep half of the blocks, the rest go to the global free list
+  int keep = limit / 2;
+  BufferBlock* last = nullptr;
+  BufferBlock* flushed = heads_[size_class];
+  for (int i = 0; i < keep; ++i) {
+    last = flushed;
+    flushed = flushed->next;
+  }
+
+  if (last == nullptr) {
+    heads_[size_class] = nullptr;
+  } else {
+    last->next = nullptr;
+  }
+
+  counts_[size_class] = keep;
+  pool.PushGlobal(size_class, flushed);
+}
+
+BufferPool& BufferPool::GetInstance() {
+  // never destroyed, buffers may be released by destructors of statics
+  static BufferPool* instance = new BufferPool();
+  return *instance;
+}
+
+BufferPool::BufferPool()
+    : global_cached_bytes_(0),
+      allocations_(0),
+      thread_cache_hits_(0),
+      global_hits_(0),
+      system_allocations_(0),
+      system_frees_(0),
+      bytes_reserved_(0) {
+}
+
+BufferBlock* BufferPool::Allocate(std::uint32_t size) {
+  if (size == 0) {
+    AGENT_LOG_ERROR("Allocate buffer with size = 0");
+    return nullptr;
+  }
+
+  int size_class = SizeClassOf(size);
+  BufferBlock* block = nullptr;
+  if (size_class >= kNumSizeClasses) {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    block = SystemAllocate(size, kUnpooled);
+  } else {
+    if (!t_cache_destroyed) {
+      block = t_cache.Pop(*this, size_class);
+    } else {
+      allocations_.fetch_add(1, std::memory_order_relaxed);
+      int popped = 0;
+      block = PopGlobal(size_class, 1, popped);
+      if (block != nullptr) {
+        global_hits_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    if (block == nullptr) {
+      block = SystemAllocate(ClassCapacity(size_class), size_class);
+    }
+  }
+
+  if (block == nullptr) {
+    return nullptr;
+  }
+
+  block->ref_count.store(1, std::memory_order_relaxed);
+  block->next = nullptr;
+  return block;
+}
+
+BufferBlock* BufferPool::Adopt(char* buf, std::uint32_t size) {
+  BufferBlock* block = new (std::nothrow) BufferBlock();
+  if (block == nullptr) {
+    AGENT_LOG_ERROR("BufferBlock new() failed");
+    return nullptr;
+  }
+
+  block->ref_count.store(1, std::memory_order_relaxed);
+  block->size_class = kAdopted;
+  block->capacity = size;
+  block->data = buf;
+  block->next = nullptr;
+  return block;
+}
+
+void BufferPool::Release(BufferBlock* block) {
+  if (block->ref_count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  if (block->size_class == kAdopted) {
+    delete[] block->data;
+    delete block;
+    return;
+  }
+
+  if (block->size_class == kUnpooled) {
+    SystemFree(block);
+  } else if (!t_cache_destroyed && ThreadCacheLimit(block->size_class) > 0) {
+    t_cache.Push(*this, block);
+  } else {
+    block->next = nullptr;
+    PushGlobal(block->size_class, block);
+  }
+}
+
+BufferPoolStats BufferPool::GetStats() const {
+  BufferPoolStats stats;
+  stats.allocations = allocations_.load(std::memory_order_relaxed);
+  stats.thread_cache_hits =
+      thread_cache_hits_.load(std::memory_order_relaxed);
+  stats.global_hits = global_hits_.load(std::memory_order_relaxed);
+  stats.system_allocations =
+      system_allocations_.load(std::memory_order_relaxed);
+  stats.system_frees = system_frees_.load(std::memory_order_relaxed);
+  stats.bytes_reserved = bytes_reserved_.load(std::memory_order_relaxed);
+  stats.bytes_cached = global_cached_bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+BufferBlock* BufferPool::PopGlobal(int size_class, int count, int& popped) {
+  FreeList& list = free_lists_[size_class];
+  std::lock_guard<std::mutex> lock(list.mtx);
+  BufferBlock* head = list.head;
+  BufferBlock* last = nullptr;
+  popped = 0;
+  while (popped < count && list.head != nullptr) {
+    last = list.head;
+    list.head = last->next;
+    ++popped;
+  }
+
+  if (last == nullptr) {
+    return nullptr;
+  }
+
+  last->next = nullptr;
+  global_cached_bytes_.fetch_sub(
+      static_cast<std::uint64_t>(popped) * ClassCapacity(size_class),
+      std::memory_order_relaxed);
+  return head;
+}
+
+void BufferPool::PushGlobal(int size_class, BufferBlock* head) {
+  std::uint32_t capacity = ClassCapacity(size_class);
+  FreeList& list = free_lists_[size_class];
+  while (head != nullptr) {
+    BufferBlock* block = head;
+    head = head->next;
+
+    // pool is full, free the block
+    if (global_cached_bytes_.fetch_add(capacity, std::memory_order_relaxed)
+        + capacity > kMaxGlobalCachedBytes) {
+      global_cached_bytes_.fetch_sub(capacity, std::memory_order_relaxed);
+      SystemFree(block);
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(list.mtx);
+    block->next = list.head;
+    list.head = block;
+  }
+}
+
+BufferBlock* BufferPool::SystemAllocate(std::uint32_t capacity,
+                                        std::uint32_t size_class) {
+  void* mem = ::operator new(sizeof(BufferBlock) + capacity, std::nothrow);
+  if (mem == nullptr) {
+    AGENT_LOG_ERROR("buffer new() failed, size = %u", capacity);
+    return nullptr;
+  }
+
+  BufferBlock* block = new (mem) BufferBlock();
+  block->size_class = size_class;
+  block->capacity = capacity;
+  block->data = static_cast<char*>(mem) + sizeof(BufferBlock);
+  system_allocations_.fetch_add(1, std::memory_order_relaxed);
+  bytes_reserved_.fetch_add(capacity, std::memory_order_relaxed);
+  return block;
+}
+
+void BufferPool::SystemFree(BufferBlock* block) {
+  system_frees_.fetch_add(1, std::memory_order_relaxed);
+  bytes_reserved_.fetch_sub(block->capacity, std::memory_order_relaxed);
+  block->~BufferBlock();
+  ::operator delete(block);
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
@@ -0,0 +1,215 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_UTIL_BUFFER_POOL_H_
+#define ASCENDDK_PRESENTER_AGENT_UTIL_BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Header of a buffer handed out by BufferPool, the data follows the header
+ * in the same allocation, so a SharedByteBuffer needs no control block
+ */
+struct BufferBlock {
+  std::atomic<std::uint32_t> ref_count;
+  std::uint32_t size_class;
+  std::uint32_t capacity;
+  std::uint32_t reserved;
+  char* data;
+
+  // next block in a free list
+  BufferBlock* next;
+};
+
+/**
+ * Counters of BufferPool
+ */
+struct BufferPoolStats {
+  // number of Allocate() calls
+  std::uint64_t allocations;
+
+  // allocations served by the cache of the calling thread
+  std::uint64_t thread_cache_hits;
+
+  // allocations served by the global free lists
+  std::uint64_t global_hits;
+
+  // blocks allocated from and freed to the system
+  std::uint64_t system_allocations;
+  std::uint64_t system_frees;
+
+  // capacity of all blocks allocated from the system and not freed
+  std::uint64_t bytes_reserved;
+
+  // capacity of the blocks in the global free lists, each thread caches
+  // up to 1MB per size class in addition
+  std::uint64_t bytes_cached;
+
+  /**
+   * @brief fraction of allocations served without the system allocator
+   * @return hit rate, 0 ~ 1
+   */
+  double HitRate() const {
+    return allocations == 0 ? 0 :
+        static_cast<double>(thread_cache_hits + global_hits) / allocations;
+  }
+};
+
+/**
+ * Size class buffer pool backing SharedByteBuffer.
+ *
+ * Sizes are rounded up to a power of 2, from 256B to 16MB. Each thread
+ * caches a few free blocks of the classes up to 1MB, and exchanges them in
+ * batches with the global free lists, so a buffer allocated by a producer
+ * and released by the sending thread returns to the pool without a system
+ * call. Blocks larger than 16MB are not pooled, and the global free lists
+ * hold at most 64MB, the rest is freed to the system.
+ */
+class BufferPool {
+ public:
+  static BufferPool& GetInstance();
+
+  /**
+   * @brief allocate a block, its ref count is 1
+   * @param [in] size           size of data, must be greater than 0
+   * @return block, NULL if size is 0 or out of memory
+   */
+  BufferBlock* Allocate(std::uint32_t size);
+
+  /**
+   * @brief adopt a buffer allocated by new[], it is delete[]-ed when the
+   *        ref count drops to 0
+   * @param [in] buf            buffer
+   * @param [in] size           size of buffer
+   * @return block, NULL if out of memory
+   */
+  BufferBlock* Adopt(char* buf, std::uint32_t size);
+
+  /**
+   * @brief increase the ref count of a block
+   * @param [in] block          block
+   */
+  static void AddRef(BufferBlock* block) {
+    block->ref_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief decrease the ref count of a block, and return it to the pool
+   *        when no one refers to it
+   * @param [in] block          block
+   */
+  void Release(BufferBlock* block);
+
+  /**
+   * @brief get a snapshot of the counters, allocations served by thread
+   *        caches are published in batches, so they may lag slightly
+   * @return stats
+   */
+  BufferPoolStats GetStats() const;
+
+  // Disable copy constructor and assignment operator
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  // number of size classes, 256B ~ 16MB
+  static const int kNumSizeClasses = 17;
+
+  // size_class of blocks not pooled
+  static const std::uint32_t kUnpooled = 0xFFFF;
+
+  // size_class of blocks adopted from new[]
+  static const std::uint32_t kAdopted = 0xFFFE;
+
+ private:
+  BufferPool();
+  ~BufferPool() = default;
+
+  friend class ThreadCache;
+
+  /**
+   * @brief pop up to count blocks from the global free list of a class
+   * @param [in] size_class     size class
+   * @param [in] count          max number of blocks
+   * @param [out] popped        number of blocks popped
+   * @return list of the popped blocks
+   */
+  BufferBlock* PopGlobal(int size_class, int count, int& popped);
+
+  /**
+   * @brief push a list of blocks to the global free list of a class, blocks
+   *        beyond the limit of the pool are freed
+   * @param [in] size_class     size class
+   * @param [in] head           list of blocks
+   */
+  void PushGlobal(int size_class, BufferBlock* head);
+
+  /**
+   * @brief allocate a block from the system
+   * @param [in] capacity       capacity of data
+   * @param [in] size_class     size class, or kUnpooled
+   * @return block, NULL if out of memory
+   */
+  BufferBlock* SystemAllocate(std::uint32_t capacity,
+                              std::uint32_t size_class);
+
+  /**
+   * @brief free a block to the system
+   * @param [in] block          block
+   */
+  void SystemFree(BufferBlock* block);
+
+  struct FreeList {
+    std::mutex mtx;
+    BufferBlock* head = nullptr;
+  };
+
+  FreeList free_lists_[kNumSizeClasses];
+  std::atomic<std::uint64_t> global_cached_bytes_;
+
+  std::atomic<std::uint64_t> allocations_;
+  std::atomic<std::uint64_t> thread_cache_hits_;
+  std::atomic<std::uint64_t> global_hits_;
+  std::atomic<std::uint64_t> system_allocations_;
+  std::atomic<std::uint64_t> system_frees_;
+  std::atomic<std::uint64_t> bytes_reserved_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_UTIL_BUFFER_POOL_H_ */
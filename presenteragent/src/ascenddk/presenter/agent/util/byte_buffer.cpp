@@ -35,10 +35,9 @@
 
 #include <netinet/in.h>
 
-#include "securec.h"
-
+#include "ascenddk/presenter/agent/util/buffer_pool.h"
 #include "ascenddk/presenter/agent/util/logging.h"
-#include "ascenddk/presenter/agent/util/mem_utils.h"
+#include "ascenddk/presenter/agent/util/securec_wrapper.h"
 
 using namespace google::protobuf;
 using namespace google::protobuf::io;
@@ -49,31 +48,82 @@ namespace ascend {
 namespace presenter {
 
 SharedByteBuffer SharedByteBuffer::Make(std::uint32_t size) {
-  char *buffer = memutils::NewArray<char>(size);
-  if (buffer == nullptr) {
-    AGENT_LOG_ERROR("buffer new() failed")
+  BufferBlock* block = BufferPool::GetInstance().Allocate(size);
+  if (block == nullptr) {
+    AGENT_LOG_ERROR("buffer new() failed");
     return SharedByteBuffer();
   }
 
-  return SharedByteBuffer(buffer, size);
+  return SharedByteBuffer(block, size);
 }
 
 SharedByteBuffer::SharedByteBuffer()
-    : buf_(nullptr),
+    : block_(nullptr),
       size_(0) {
 }
 
 SharedByteBuffer::SharedByteBuffer(char* buf, std::uint32_t size)
-    : buf_(buf, std::default_delete<char[]>()),
+    : block_(BufferPool::GetInstance().Adopt(buf, size)),
+      size_(block_ == nullptr ? 0 : size) {
+  if (block_ == nullptr) {
+    delete[] buf;
+  }
+}
+
+SharedByteBuffer::SharedByteBuffer(BufferBlock* block, std::uint32_t size)
+    : block_(block),
       size_(size) {
 }
 
+SharedByteBuffer::~SharedByteBuffer() {
+  if (block_ != nullptr) {
+    BufferPool::GetInstance().Release(block_);
+  }
+}
+
+SharedByteBuffer::SharedByteBuffer(const SharedByteBuffer& other)
+    : block_(other.block_),
+      size_(other.size_) {
+  if (block_ != nullptr) {
+    BufferPool::AddRef(block_);
+  }
+}
+
+SharedByteBuffer::SharedByteBuffer(SharedByteBuffer&& other) noexcept
+    : block_(other.block_),
+      size_(other.size_) {
+  other.block_ = nullptr;
+  other.size_ = 0;
+}
+
+SharedByteBuffer& SharedByteBuffer::operator=(const SharedByteBuffer& other) {
+  SharedByteBuffer copy(other);
+  *this = std::move(copy);
+  return *this;
+}
+
+SharedByteBuffer& SharedByteBuffer::operator=(
+    SharedByteBuffer&& other) noexcept {
+  if (this != &other) {
+    if (block_ != nullptr) {
+      BufferPool::GetInstance().Release(block_);
+    }
+
+    block_ = other.block_;
+    size_ = other.size_;
+    other.block_ = nullptr;
+    other.size_ = 0;
+  }
+
+  return *this;
+}
+
 const char* SharedByteBuffer::Get() const {
-  return buf_.get();
+  return block_ == nullptr ? nullptr : block_->data;
 }
 
 char* SharedByteBuffer::GetMutable() const {
-  return buf_.get();
+  return block_ == nullptr ? nullptr : block_->data;
 }
 
 uint32_t SharedByteBuffer::Size() const {
@@ -148,8 +198,9 @@ void ByteBufferWriter::PutBytes(const void *data, size_t size) {
     return;
   }
 
-  AGENT_LOG_ERROR("memcpy_s() error: %d, buffer remains: %d, and requiring: %u",
-                  ret, remaining_bytes, size);
+  AGENT_LOG_ERROR(
+      "memcpy_s() error: %d, buffer remains: %td, and requiring: %zu",
+      ret, remaining_bytes, size);
   // memcpy failed, any following write will be meaningless,
   // So set wPtr after end, to set the buffer to a faulty state
   w_ptr_ += remaining_bytes + 1;
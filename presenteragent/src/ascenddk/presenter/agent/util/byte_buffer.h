@@ -43,12 +43,24 @@
 namespace ascend {
 namespace presenter {
 
+struct BufferBlock;
+
+/**
+ * a reference counted byte array, the memory is taken from BufferPool and
+ * the ref count lives in the same block, so copies share the data without a
+ * separate control block
+ */
 class SharedByteBuffer {
  public:
+  /**
+   * @brief allocate a buffer from the pool
+   * @param [in] size     size of buffer
+   * @return buffer, empty if size is 0 or out of memory
+   */
   static SharedByteBuffer Make(std::uint32_t size);
 
   /**
-   * @brief constructor
+   * @brief constructor, take the ownership of a buffer allocated by new[]
    * @param [in] buf      buffer
    * @param [in] size     size of buffer
    */
@@ -58,7 +70,12 @@ class SharedByteBuffer {
    * @brief constructor
    */
   SharedByteBuffer();
-  ~SharedByteBuffer() = default;
+  ~SharedByteBuffer();
+
+  SharedByteBuffer(const SharedByteBuffer& other);
+  SharedByteBuffer(SharedByteBuffer&& other) noexcept;
+  SharedByteBuffer& operator=(const SharedByteBuffer& other);
+  SharedByteBuffer& operator=(SharedByteBuffer&& other) noexcept;
 
   /**
    * @brief Get buffer
@@ -85,7 +102,9 @@ class SharedByteBuffer {
   bool IsEmpty() const;
 
  private:
-  std::shared_ptr<char> buf_;
+  SharedByteBuffer(BufferBlock* block, std::uint32_t size);
+
+  BufferBlock* block_;
   std::uint32_t size_;
 };
 
@@ -177,13 +196,6 @@ class ByteBufferWriter {
    */
   bool PutMessage(const ::google::protobuf::Message& msg);
 
-  /**
-   * @brief Finish writing and wrap the data to ByteBuffer
-   * @return ByteBuffer
-   */
-  ByteBuffer GetBuffer();
-
- private:
   /**
    * @brief put bytes to buffer
    * @param [in] data        buffer of data
@@ -191,6 +203,13 @@ class ByteBufferWriter {
    */
   void PutBytes(const void* data, size_t size);
 
+  /**
+   * @brief Finish writing and wrap the data to ByteBuffer
+   * @return ByteBuffer
+   */
+  ByteBuffer GetBuffer();
+
+ private:
   char *buf_;
   char *w_ptr_;
   const char* const end_;
@@ -0,0 +1,105 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/util/consistent_hash.h"
+
+using namespace std;
+
+namespace {
+
+// FNV-1a parameters
+const uint32_t kFnvOffsetBasis = 2166136261u;
+const uint32_t kFnvPrime = 16777619u;
+
+}
+
+namespace ascend {
+namespace presenter {
+
+ConsistentHashRing::ConsistentHashRing(int virtual_node_num)
+    : virtual_node_num_(virtual_node_num > 0 ? virtual_node_num : 1),
+      node_num_(0) {
+}
+
+uint32_t ConsistentHashRing::Hash(const string& data) {
+  uint32_t hash = kFnvOffsetBasis;
+  for (size_t i = 0; i < data.size(); ++i) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= kFnvPrime;
+  }
+
+  // FNV-1a keeps similar keys close, finalize as murmur3 to spread them
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+void ConsistentHashRing::AddNode(const string& node) {
+  for (int i = 0; i < virtual_node_num_; ++i) {
+    // on collision, the virtual node added first wins
+    ring_.emplace(Hash(node + "#" + to_string(i)), node_num_);
+  }
+
+  ++node_num_;
+}
+
+vector<size_t> ConsistentHashRing::GetNodes(const string& key) const {
+  vector<size_t> nodes;
+  if (ring_.empty()) {
+    return nodes;
+  }
+
+  vector<bool> added(node_num_, false);
+  auto it = ring_.lower_bound(Hash(key));
+  // walk the ring clockwise once
+  for (size_t i = 0; i < ring_.size() && nodes.size() < node_num_; ++i) {
+    if (it == ring_.end()) {
+      it = ring_.begin();
+    }
+
+    if (!added[it->second]) {
+      added[it->second] = true;
+      nodes.push_back(it->second);
+    }
+
+    ++it;
+  }
+
+  return nodes;
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
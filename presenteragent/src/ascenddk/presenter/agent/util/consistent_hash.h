@@ -0,0 +1,94 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_UTIL_CONSISTENT_HASH_H_
+#define ASCENDDK_PRESENTER_AGENT_UTIL_CONSISTENT_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Consistent hash ring. Keys are mapped to nodes so that adding or removing
+ * a node only moves the keys owned by that node. Each node is put on the
+ * ring several times as virtual nodes to balance the keys
+ */
+class ConsistentHashRing {
+ public:
+  // virtual nodes of each node
+  static const int kDefaultVirtualNodeNum = 160;
+
+  /**
+   * @brief constructor
+   * @param [in] virtual_node_num     virtual nodes of each node, at least 1
+   */
+  explicit ConsistentHashRing(int virtual_node_num = kDefaultVirtualNodeNum);
+  ~ConsistentHashRing() = default;
+
+  /**
+   * @brief add a node, its index is the number of nodes added before
+   * @param [in] node                 name of the node, should be unique
+   */
+  void AddNode(const std::string& node);
+
+  /**
+   * @brief get the nodes to place the key on, in preference order: the
+   *        owner of the key first, then the following nodes clockwise
+   * @param [in] key                  key
+   * @return indexes of all nodes, each appears once
+   */
+  std::vector<size_t> GetNodes(const std::string& key) const;
+
+  /**
+   * @brief stable hash of a string, same in all processes and platforms
+   * @param [in] data                 data
+   * @return hash value
+   */
+  static uint32_t Hash(const std::string& data);
+
+ private:
+  int virtual_node_num_;
+  size_t node_num_;
+  // hash of virtual node -> index of node
+  std::map<uint32_t, size_t> ring_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_UTIL_CONSISTENT_HASH_H_ */
@@ -0,0 +1,100 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/util/host_log.h"
+
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+
+// max length of a line, longer lines are truncated
+const int kMaxLineSize = 1024;
+
+const char kLevelChars[] = { 'D', 'I', 'W', 'E' };
+
+}
+
+namespace ascend {
+namespace presenter {
+
+void HostLog(int level, const char *fmt, ...) {
+  static thread_local char line[kMaxLineSize];
+  static thread_local long tid = syscall(SYS_gettid);
+
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  struct tm local_time;
+  localtime_r(&now.tv_sec, &local_time);
+
+  char level_char = '?';
+  if (level >= 0 && level < static_cast<int>(sizeof(kLevelChars))) {
+    level_char = kLevelChars[level];
+  }
+
+  int size = snprintf(line, kMaxLineSize,
+                      "%04d-%02d-%02d %02d:%02d:%02d.%06ld %c %ld ",
+                      local_time.tm_year + 1900, local_time.tm_mon + 1,
+                      local_time.tm_mday, local_time.tm_hour,
+                      local_time.tm_min, local_time.tm_sec,
+                      now.tv_nsec / 1000, level_char, tid);
+  if (size < 0 || size >= kMaxLineSize) {
+    return;
+  }
+
+  va_list args;
+  va_start(args, fmt);
+  int msg_size = vsnprintf(line + size, kMaxLineSize - size, fmt, args);
+  va_end(args);
+  if (msg_size < 0) {
+    return;
+  }
+
+  size += msg_size;
+  if (size >= kMaxLineSize) {
+    // truncated, keep the line ending
+    size = kMaxLineSize - 1;
+    line[size - 1] = '\n';
+  }
+
+  // logging must not fail the caller, error of write is ignored
+  ssize_t ret = write(STDERR_FILENO, line, size);
+  (void) ret;
+}
+
+} /* namespace presenter */
+} /* namespace ascend */
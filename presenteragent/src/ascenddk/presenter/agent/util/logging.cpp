@@ -0,0 +1,93 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/presenter/agent/util/logging.h"
+
+#include <time.h>
+
+#include <cstdlib>
+
+namespace {
+
+const char* const kLogLevelEnv = "PRESENTER_AGENT_LOG_LEVEL";
+
+int InitLevel() {
+  const char *env = getenv(kLogLevelEnv);
+  if (env == nullptr) {
+    return AGENT_LOG_LEVEL_INFO;
+  }
+
+  return atoi(env);
+}
+
+int64_t NowInMs() {
+  // coarse clock is enough, and much cheaper
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+}
+
+}
+
+namespace ascend {
+namespace presenter {
+namespace logging {
+
+std::atomic<int> g_level(InitLevel());
+
+void SetLevel(int level) {
+  g_level.store(level, std::memory_order_relaxed);
+}
+
+bool RateLimiter::Allow(uint32_t& suppressed) {
+  int64_t now = NowInMs();
+  int64_t window_start = window_start_ms_.load(std::memory_order_relaxed);
+  // only the thread winning the exchange starts the new window
+  if (now - window_start >= kIntervalMs
+      && window_start_ms_.compare_exchange_strong(
+          window_start, now, std::memory_order_relaxed)) {
+    count_.store(0, std::memory_order_relaxed);
+  }
+
+  if (count_.fetch_add(1, std::memory_order_relaxed) < kBurst) {
+    suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+  suppressed_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+} /* namespace logging */
+} /* namespace presenter */
+} /* namespace ascend */
@@ -30,31 +30,153 @@
  * POSSIBILITY OF SUCH DAMAGE.
  * ============================================================================
  */
-
 #ifndef ASCENDDK_PRESENTER_AGENT_UTIL_LOGGING_H_
 #define ASCENDDK_PRESENTER_AGENT_UTIL_LOGGING_H_
 
-#include "hiaiengine/log.h"
 #include "cerrno"
 
+#include <atomic>
+#include <cstdint>
+
+// log levels
+#define AGENT_LOG_LEVEL_DEBUG 0
+#define AGENT_LOG_LEVEL_INFO 1
+#define AGENT_LOG_LEVEL_WARN 2
+#define AGENT_LOG_LEVEL_ERROR 3
+
+// logs below this level are compiled out, their arguments are not evaluated
+#ifndef AGENT_LOG_MIN_LEVEL
+#define AGENT_LOG_MIN_LEVEL AGENT_LOG_LEVEL_DEBUG
+#endif
+
+// A logging backend defines AGENT_LOG_WRITE_<LEVEL>(fmt, ...) for each
+// level. Besides the DDK and host backends, a custom backend header can be
+// given by -DAGENT_LOG_BACKEND_HEADER=\"header.h\"
+#if defined(AGENT_LOG_BACKEND_HEADER)
+#include AGENT_LOG_BACKEND_HEADER
+#elif defined(PRESENTER_AGENT_HOST)
+#include "ascenddk/presenter/agent/util/host_log.h"
+
+#define AGENT_LOG_WRITE_DEBUG(fmt, ...) \
+  ascend::presenter::HostLog(AGENT_LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#define AGENT_LOG_WRITE_INFO(fmt, ...) \
+  ascend::presenter::HostLog(AGENT_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define AGENT_LOG_WRITE_WARN(fmt, ...) \
+  ascend::presenter::HostLog(AGENT_LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define AGENT_LOG_WRITE_ERROR(fmt, ...) \
+  ascend::presenter::HostLog(AGENT_LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#include "hiaiengine/log.h"
+
+#define AGENT_LOG_WRITE_DEBUG(fmt, ...) \
+  HIAI_ENGINE_LOG(HIAI_DEBUG_INFO_CODE, fmt, ##__VA_ARGS__)
+#define AGENT_LOG_WRITE_INFO(fmt, ...) \
+  HIAI_ENGINE_LOG(fmt, ##__VA_ARGS__)
+#define AGENT_LOG_WRITE_WARN(fmt, ...) \
+  HIAI_ENGINE_LOG(HIAI_GRAPH_WARNING_CODE, fmt, ##__VA_ARGS__)
+#define AGENT_LOG_WRITE_ERROR(fmt, ...) \
+  HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT, fmt, ##__VA_ARGS__)
+#endif
+
+namespace ascend {
+namespace presenter {
+namespace logging {
+
+// runtime level, initialized by env PRESENTER_AGENT_LOG_LEVEL, INFO if not set
+extern std::atomic<int> g_level;
+
+/**
+ * @brief get the runtime log level
+ * @return AGENT_LOG_LEVEL_XXX
+ */
+inline int GetLevel() {
+  return g_level.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief set the runtime log level, logs below it are not formatted
+ * @param [in] level            AGENT_LOG_LEVEL_XXX
+ */
+void SetLevel(int level);
+
+/**
+ * Limits the logs of a call site to kBurst per second, the state is kept
+ * in atomics so that it can be a static of the call site
+ */
+class RateLimiter {
+ public:
+  // max logs per interval
+  static const uint32_t kBurst = 10;
+
+  // interval in milliseconds
+  static const int64_t kIntervalMs = 1000;
+
+  constexpr RateLimiter()
+      : window_start_ms_(0),
+        count_(0),
+        suppressed_(0) {
+  }
+
+  /**
+   * @brief check whether a log is allowed
+   * @param [out] suppressed      number of logs suppressed since the last
+   *                              allowed one
+   * @return true: allowed, false: suppressed
+   */
+  bool Allow(uint32_t& suppressed);
+
+ private:
+  std::atomic<int64_t> window_start_ms_;
+  std::atomic<uint32_t> count_;
+  std::atomic<uint32_t> suppressed_;
+};
+
+} /* namespace logging */
+} /* namespace presenter */
+} /* namespace ascend */
+
+// whether logs of the level are written, arguments of a log are evaluated
+// only if it is on. The first condition is a constant, the log is removed
+// by compiler if it is below AGENT_LOG_MIN_LEVEL
+#define AGENT_LOG_IS_ON(level)                                           \
+  (AGENT_LOG_LEVEL_##level >= AGENT_LOG_MIN_LEVEL                        \
+      && AGENT_LOG_LEVEL_##level >= ascend::presenter::logging::GetLevel())
+
+#define AGENT_LOG(level, fmt, ...)                                       \
+  do {                                                                   \
+    if (AGENT_LOG_IS_ON(level)) {                                        \
+      AGENT_LOG_WRITE_##level("[%s:%d] " fmt "\n", __FILE__, __LINE__,   \
+                              ##__VA_ARGS__);                            \
+    }                                                                    \
+  } while (0)
+
+// rate limited per call site, for errors repeating in a reconnect storm
+#define AGENT_LOG_LIMITED(level, fmt, ...)                               \
+  do {                                                                   \
+    static ascend::presenter::logging::RateLimiter agent_log_limiter;    \
+    uint32_t agent_log_suppressed = 0;                                   \
+    if (AGENT_LOG_IS_ON(level)                                           \
+        && agent_log_limiter.Allow(agent_log_suppressed)) {              \
+      if (agent_log_suppressed > 0) {                                    \
+        AGENT_LOG_WRITE_##level("[%s:%d] %u similar logs suppressed\n",  \
+                                __FILE__, __LINE__,                      \
+                                agent_log_suppressed);                   \
+      }                                                                  \
+      AGENT_LOG_WRITE_##level("[%s:%d] " fmt "\n", __FILE__, __LINE__,   \
+                              ##__VA_ARGS__);                            \
+    }                                                                    \
+  } while (0)
 
 // debug level logging
-#define AGENT_LOG_DEBUG(fmt, ...)                                      \
-  HIAI_ENGINE_LOG(HIAI_DEBUG_INFO_CODE, "[%s:%d] " fmt "\n", __FILE__, \
-                  __LINE__, ##__VA_ARGS__);
+#define AGENT_LOG_DEBUG(fmt, ...) AGENT_LOG(DEBUG, fmt, ##__VA_ARGS__)
 
 // info level logging
-#define AGENT_LOG_INFO(fmt, ...) \
-  HIAI_ENGINE_LOG("[%s:%d] " fmt "\n", __FILE__, __LINE__, ##__VA_ARGS__);
+#define AGENT_LOG_INFO(fmt, ...) AGENT_LOG(INFO, fmt, ##__VA_ARGS__)
 
 // warn level logging
-#define AGENT_LOG_WARN(fmt, ...)                                          \
-  HIAI_ENGINE_LOG(HIAI_GRAPH_WARNING_CODE, "[%s:%d] " fmt "\n", __FILE__, \
-                  __LINE__, ##__VA_ARGS__);
-
-// error level logging
-#define AGENT_LOG_ERROR(fmt, ...)                                      \
-  HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT, "[%s:%d] " fmt "\n", \
-                  __FILE__, __LINE__, ##__VA_ARGS__);
+#define AGENT_LOG_WARN(fmt, ...) AGENT_LOG(WARN, fmt, ##__VA_ARGS__)
+
+// error level logging, rate limited per call site
+#define AGENT_LOG_ERROR(fmt, ...) AGENT_LOG_LIMITED(ERROR, fmt, ##__VA_ARGS__)
 
 #endif /* ASCENDDK_PRESENTER_AGENT_UTIL_LOGGING_H_ */
@@ -0,0 +1,150 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_UTIL_MPSC_QUEUE_H_
+#define ASCENDDK_PRESENTER_AGENT_UTIL_MPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace ascend {
+namespace presenter {
+
+/**
+ * Bounded lock-free queue with multiple producers and a single consumer.
+ *
+ * Each cell carries a sequence number telling whether it is free for the
+ * producer at a position or filled for the consumer, so producers only
+ * contend on a CAS of the enqueue position and never wait for each other.
+ */
+template<typename T, size_t kCapacity>
+class BoundedMpscQueue {
+ public:
+  BoundedMpscQueue()
+      : enqueue_pos_(0),
+        dequeue_pos_(0) {
+    static_assert(kCapacity >= 2 && (kCapacity & (kCapacity - 1)) == 0,
+                  "capacity must be a power of 2");
+    for (size_t i = 0; i < kCapacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Disable copy constructor and assignment operator
+  BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+  BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+  /**
+   * @brief push a value, thread safe
+   * @param [in] value          value, moved into the queue if pushed
+   * @return true: success, false: queue is full
+   */
+  bool TryPush(T&& value) {
+    Cell *cell = nullptr;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells_[pos & kMask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        // the cell is free, claim the position
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // the cell of the previous round is not consumed yet
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief pop a value, consumer thread only
+   * @param [out] value         value
+   * @return true: success, false: queue is empty
+   */
+  bool TryPop(T& value) {
+    Cell &cell = cells_[dequeue_pos_ & kMask];
+    size_t seq = cell.sequence.load(std::memory_order_acquire);
+    if (seq != dequeue_pos_ + 1) {
+      return false;
+    }
+
+    value = std::move(cell.value);
+    // release what the moved-from value may still hold
+    cell.value = T();
+    cell.sequence.store(dequeue_pos_ + kCapacity, std::memory_order_release);
+    ++dequeue_pos_;
+    return true;
+  }
+
+  /**
+   * @brief check whether there is a value to pop, consumer thread only
+   * @return true: empty
+   */
+  bool Empty() const {
+    const Cell &cell = cells_[dequeue_pos_ & kMask];
+    return cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1;
+  }
+
+ private:
+  static const size_t kMask = kCapacity - 1;
+
+  // avoid false sharing between producers and the consumer
+  static const size_t kCacheLineSize = 64;
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  Cell cells_[kCapacity];
+  char pad0_[kCacheLineSize];
+  std::atomic<size_t> enqueue_pos_;
+  char pad1_[kCacheLineSize];
+  size_t dequeue_pos_;
+};
+
+} /* namespace presenter */
+} /* namespace ascend */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_UTIL_MPSC_QUEUE_H_ */
@@ -0,0 +1,104 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_PRESENTER_AGENT_UTIL_SECUREC_WRAPPER_H_
+#define ASCENDDK_PRESENTER_AGENT_UTIL_SECUREC_WRAPPER_H_
+
+#ifndef PRESENTER_AGENT_HOST
+
+#include "securec.h"
+
+#else
+
+// securec is shipped with DDK only, host build uses the portable subset
+// below, with the same semantic as securec
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#ifndef EOK
+#define EOK 0
+#endif
+
+typedef int errno_t;
+
+/**
+ * @brief copy count bytes from src to dest
+ * @param [in] dest             destination buffer
+ * @param [in] dest_max         size of destination buffer
+ * @param [in] src              source buffer
+ * @param [in] count            bytes to copy
+ * @return EOK: success, EINVAL: invalid parameter, ERANGE: count exceeds
+ *         dest_max, dest is cleared
+ */
+inline errno_t memcpy_s(void *dest, size_t dest_max, const void *src,
+                        size_t count) {
+  if (dest == nullptr || src == nullptr) {
+    return EINVAL;
+  }
+
+  if (count > dest_max) {
+    memset(dest, 0, dest_max);
+    return ERANGE;
+  }
+
+  memcpy(dest, src, count);
+  return EOK;
+}
+
+/**
+ * @brief set count bytes of dest to c
+ * @param [in] dest             destination buffer
+ * @param [in] dest_max         size of destination buffer
+ * @param [in] c                value to set
+ * @param [in] count            bytes to set
+ * @return EOK: success, EINVAL: invalid parameter, ERANGE: count exceeds
+ *         dest_max, only dest_max bytes are set
+ */
+inline errno_t memset_s(void *dest, size_t dest_max, int c, size_t count) {
+  if (dest == nullptr) {
+    return EINVAL;
+  }
+
+  if (count > dest_max) {
+    memset(dest, c, dest_max);
+    return ERANGE;
+  }
+
+  memset(dest, c, count);
+  return EOK;
+}
+
+#endif /* PRESENTER_AGENT_HOST */
+
+#endif /* ASCENDDK_PRESENTER_AGENT_UTIL_SECUREC_WRAPPER_H_ */
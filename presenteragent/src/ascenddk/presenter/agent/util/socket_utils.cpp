@@ -41,9 +41,8 @@
 #include <signal.h>
 #include <unistd.h>
 
-#include "securec.h"
-
 #include "ascenddk/presenter/agent/util/logging.h"
+#include "ascenddk/presenter/agent/util/securec_wrapper.h"
 
 namespace {
 
@@ -89,7 +88,7 @@ bool SetSockAddr(const char *host_ip, uint16_t port, sockaddr_in &addr) {
   }
 
   // convert host and port to sockaddr
-  error_t ret = memset_s(&addr, sizeof(addr), 0, sizeof(addr));
+  errno_t ret = memset_s(&addr, sizeof(addr), 0, sizeof(addr));
   if (ret != EOK) {
     AGENT_LOG_ERROR("memset_s() error: %d", ret);
     return false;
@@ -182,6 +181,89 @@ int Connect(int socket, const sockaddr_in& addr) {
   return kSocketSuccess;
 }
 
+int ConnectNonBlocking(int socket, const sockaddr_in& addr) {
+  // Ignore SIGPIPE signals
+  signal(SIGPIPE, SIG_IGN);
+
+  SetNonBlocking(socket, true);
+  int ret = ::connect(socket, (sockaddr*) &addr, sizeof(addr));
+  if (ret == kSocketSuccess) {
+    return kSocketSuccess;
+  }
+
+  if (errno == EINPROGRESS) {
+    return kSocketInProgress;
+  }
+
+  AGENT_LOG_ERROR("connect() error: %s", strerror(errno));
+  return kSocketError;
+}
+
+int GetSocketError(int socket) {
+  int so_error = kSocketSuccess;
+  socklen_t len = sizeof(so_error);
+  if (getsockopt(socket, SOL_SOCKET, SO_ERROR, &so_error, &len) != 0) {
+    return errno;
+  }
+
+  return so_error;
+}
+
+int ReadSome(int socket, char *buffer, int size) {
+  while (true) {
+    int ret = ::recv(socket, buffer, size, kSocketFlagNone);
+    if (ret > 0) {
+      return ret;
+    }
+
+    if (ret == kSocketClosed) {
+      AGENT_LOG_INFO("socket closed by peer");
+      return kSocketError;
+    }
+
+    if (errno == EINTR) {
+      continue;
+    }
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return kSocketInProgress;
+    }
+
+    AGENT_LOG_ERROR("recv() error. error = %s", strerror(errno));
+    return kSocketError;
+  }
+}
+
+int WriteSome(int socket, const struct iovec *iov, int iov_cnt) {
+  msghdr msg;
+  errno_t ret = memset_s(&msg, sizeof(msg), 0, sizeof(msg));
+  if (ret != EOK) {
+    AGENT_LOG_ERROR("memset_s() error: %d", ret);
+    return kSocketError;
+  }
+
+  msg.msg_iov = const_cast<struct iovec*>(iov);
+  msg.msg_iovlen = iov_cnt;
+  while (true) {
+    // MSG_NOSIGNAL: a broken connection is reported by return value
+    int sent = ::sendmsg(socket, &msg, MSG_NOSIGNAL);
+    if (sent >= 0) {
+      return sent;
+    }
+
+    if (errno == EINTR) {
+      continue;
+    }
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return kSocketInProgress;
+    }
+
+    AGENT_LOG_ERROR("sendmsg() error. errno = %s", strerror(errno));
+    return kSocketError;
+  }
+}
+
 int ReadN(int socket, char *buffer, int size) {
   int received_cnt = 0;
   // keep reading until nReceived == size
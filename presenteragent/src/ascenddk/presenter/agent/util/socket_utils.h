@@ -37,6 +37,7 @@
 #include <string>
 #include <cstdint>
 #include <netinet/in.h>
+#include <sys/uio.h>
 
 namespace ascend {
 namespace presenter {
@@ -49,6 +50,16 @@ const int kSocketError = -1;
 // indicating socket timeout
 const int kSocketTimeout = -11;
 
+// indicating a non-blocking operation can not be completed immediately
+const int kSocketInProgress = -115;
+
+/**
+ * @brief set or unset O_NONBLOCK of a socket
+ * @param [in] socket               file descriptor of the socket
+ * @param [in] nonblocking          true: non-blocking, false: blocking
+ */
+void SetNonBlocking(int socket, bool nonblocking);
+
 /**
  * @brief SetSockAddr
  * @param [in] host_ip              host IP
@@ -85,6 +96,42 @@ int CreateSocket();
  */
 int Connect(int socket, const sockaddr_in &addr);
 
+/**
+ * @brief Start connecting a non-blocking socket FD to peer at ADDR
+ * @param [in] socket               file descriptor of the socket
+ * @param [in] addr                 peer address
+ * @return 0 if connected, kSocketInProgress if the socket should be polled
+ *         for writing, -1 for errors.
+ */
+int ConnectNonBlocking(int socket, const sockaddr_in &addr);
+
+/**
+ * @brief Get and clear the pending error of a socket
+ * @param [in] socket               file descriptor of the socket
+ * @return 0 if no error, otherwise the errno value
+ */
+int GetSocketError(int socket);
+
+/**
+ * @brief Read at most SIZE bytes into BUF, never blocks
+ * @param [in] socket               file descriptor of the socket
+ * @param [out] buffer              buffer to write data to
+ * @param [in] size                 size of buffer
+ * @return the number read, kSocketInProgress if no data available,
+ *         or -1 for errors and peer closing.
+ */
+int ReadSome(int socket, char *buffer, int size);
+
+/**
+ * @brief Write as many bytes as possible of the IOV array, never blocks
+ * @param [in] socket               file descriptor of the socket
+ * @param [in] iov                  array of buffers
+ * @param [in] iov_cnt              count of buffers
+ * @return the number wrote, kSocketInProgress if socket buffer is full,
+ *         or -1 for errors.
+ */
+int WriteSome(int socket, const struct iovec *iov, int iov_cnt);
+
 /**
  * @brief  Read N bytes into BUF from socket FD.
  * @param [in] socket               file descriptor of the socket
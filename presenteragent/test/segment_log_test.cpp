@@ -0,0 +1,321 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "ascenddk/presenter/agent/record/segment_log.h"
+
+using namespace std;
+using namespace ascend::presenter;
+
+namespace {
+
+const uint32_t kSegmentSize = SegmentLogWriter::kMinSegmentSize;
+const uint32_t kRecordSize = 10 * 1024;
+
+// offsets of the segment header fields, and size of an index entry
+const off_t kRecordCountOffset = 8;
+const off_t kSealedOffset = 16;
+const uint32_t kIndexEntrySize = 16;
+
+struct Record {
+  string data;
+  int64_t timestamp_us;
+};
+
+// data of the i-th record, records of the same size are told apart
+string RecordData(int i, uint32_t size) {
+  string data(size, static_cast<char>('a' + i % 26));
+  snprintf(&data[0], size, "%d", i);
+  return data;
+}
+
+class SegmentLogTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    char dir[] = "/tmp/segment_log_test_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    dir_ = dir;
+  }
+
+  void TearDown() override {
+    vector<uint32_t> sequences;
+    SegmentLogReader::ListSegments(dir_, sequences);
+    for (uint32_t sequence : sequences) {
+      unlink(SegmentLogReader::GetSegmentPath(dir_, sequence).c_str());
+    }
+    rmdir(dir_.c_str());
+  }
+
+  void Append(SegmentLogWriter* writer, int i, uint32_t size = kRecordSize) {
+    string data = RecordData(i, size);
+    SharedByteBuffer buffer = SharedByteBuffer::Make(size);
+    memcpy(buffer.GetMutable(), data.data(), size);
+    vector<SharedByteBuffer> buffers(1, buffer);
+    ASSERT_EQ(writer->Append(buffers, i), PresenterErrorCode::kNone);
+  }
+
+  vector<Record> ReadAll() {
+    vector<Record> records;
+    EXPECT_EQ(SegmentLogReader::ReadAll(dir_, Collect(records)),
+              PresenterErrorCode::kNone);
+    return records;
+  }
+
+  // consume at most max_count records
+  vector<Record> Consume(size_t max_count = SIZE_MAX) {
+    vector<Record> records;
+    SegmentLogReader::RecordVisitor collect = Collect(records);
+    EXPECT_EQ(SegmentLogReader::Consume(dir_,
+        [&](const char* data, uint32_t length, int64_t timestamp_us) {
+      return records.size() < max_count && collect(data, length, timestamp_us);
+    }), PresenterErrorCode::kNone);
+    return records;
+  }
+
+  size_t SegmentCount() {
+    vector<uint32_t> sequences;
+    SegmentLogReader::ListSegments(dir_, sequences);
+    return sequences.size();
+  }
+
+  // overwrite bytes of a segment at an offset from its beginning
+  void Overwrite(uint32_t sequence, off_t offset, uint32_t value) {
+    string path = SegmentLogReader::GetSegmentPath(dir_, sequence);
+    int fd = open(path.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pwrite(fd, &value, sizeof(value), offset),
+              static_cast<ssize_t>(sizeof(value)));
+    close(fd);
+  }
+
+  static SegmentLogReader::RecordVisitor Collect(vector<Record>& records) {
+    return [&records](const char* data, uint32_t length,
+                      int64_t timestamp_us) {
+      records.push_back(Record{string(data, length), timestamp_us});
+      return true;
+    };
+  }
+
+  static void ExpectRecords(const vector<Record>& records, int first,
+                            int count, uint32_t size = kRecordSize) {
+    ASSERT_EQ(records.size(), static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+      EXPECT_EQ(records[i].data, RecordData(first + i, size));
+      EXPECT_EQ(records[i].timestamp_us, first + i);
+    }
+  }
+
+  string dir_;
+};
+
+}
+
+TEST_F(SegmentLogTest, InvalidParam) {
+  EXPECT_EQ(SegmentLogWriter::New("", kSegmentSize, 1), nullptr);
+  EXPECT_EQ(SegmentLogWriter::New(dir_, kSegmentSize, 0), nullptr);
+  EXPECT_EQ(SegmentLogWriter::New(dir_, kSegmentSize - 1, 1), nullptr);
+
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 1));
+  ASSERT_NE(writer, nullptr);
+  vector<SharedByteBuffer> buffers(1, SharedByteBuffer::Make(kSegmentSize));
+  EXPECT_EQ(writer->Append(buffers, 0), PresenterErrorCode::kInvalidParam);
+  EXPECT_EQ(SegmentCount(), 0u);
+}
+
+TEST_F(SegmentLogTest, RoundTrip) {
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 4));
+  ASSERT_NE(writer, nullptr);
+  for (int i = 0; i < 3; ++i) {
+    Append(writer.get(), i, 100 + i);
+  }
+
+  // readable while being written to
+  vector<Record> records = ReadAll();
+  ASSERT_EQ(records.size(), 3u);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(records[i].data, RecordData(i, 100 + i));
+    EXPECT_EQ(records[i].timestamp_us, i);
+  }
+  EXPECT_EQ(SegmentCount(), 1u);
+}
+
+TEST_F(SegmentLogTest, Rolling) {
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 100));
+  ASSERT_NE(writer, nullptr);
+  const int kCount = 20;
+  for (int i = 0; i < kCount; ++i) {
+    Append(writer.get(), i);
+  }
+
+  // 6 records of 10KB fit in a 64KB segment
+  EXPECT_EQ(SegmentCount(), 4u);
+  ExpectRecords(ReadAll(), 0, kCount);
+
+  // a new writer appends to a new segment after the existing ones
+  writer.reset(SegmentLogWriter::New(dir_, kSegmentSize, 100));
+  ASSERT_NE(writer, nullptr);
+  Append(writer.get(), kCount);
+  EXPECT_EQ(SegmentCount(), 5u);
+  ExpectRecords(ReadAll(), 0, kCount + 1);
+}
+
+TEST_F(SegmentLogTest, DiskBudget) {
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 3));
+  ASSERT_NE(writer, nullptr);
+  const int kCount = 50;
+  for (int i = 0; i < kCount; ++i) {
+    Append(writer.get(), i);
+    ASSERT_LE(SegmentCount(), 3u);
+  }
+
+  // the oldest segments are removed, the records left are the latest ones
+  // of 3 segments: 6 + 6 + 2
+  ExpectRecords(ReadAll(), kCount - 14, 14);
+}
+
+TEST_F(SegmentLogTest, CorruptIndex) {
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 100));
+  ASSERT_NE(writer, nullptr);
+  for (int i = 0; i < 12; ++i) {
+    Append(writer.get(), i);
+  }
+  writer.reset();
+
+  // the offset of the 3rd record of the 1st segment points past the index
+  Overwrite(0, kSegmentSize - 3 * kIndexEntrySize, kSegmentSize);
+
+  // the rest of the corrupt segment is skipped, the next one is read
+  vector<Record> records = ReadAll();
+  ASSERT_EQ(records.size(), 8u);
+  ExpectRecords(vector<Record>(records.begin(), records.begin() + 2), 0, 2);
+  ExpectRecords(vector<Record>(records.begin() + 2, records.end()), 6, 6);
+
+  // consuming skips them too, and removes the corrupt segment
+  records = Consume();
+  ASSERT_EQ(records.size(), 8u);
+  ExpectRecords(vector<Record>(records.begin(), records.begin() + 2), 0, 2);
+  ExpectRecords(vector<Record>(records.begin() + 2, records.end()), 6, 6);
+  EXPECT_EQ(SegmentCount(), 0u);
+}
+
+TEST_F(SegmentLogTest, CorruptHeader) {
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 100));
+  ASSERT_NE(writer, nullptr);
+  for (int i = 0; i < 12; ++i) {
+    Append(writer.get(), i);
+  }
+  writer.reset();
+
+  // magic of the 1st segment, record count of the 2nd
+  Overwrite(0, 0, 0);
+  Overwrite(1, kRecordCountOffset, kSegmentSize);
+  EXPECT_EQ(ReadAll().size(), 0u);
+  EXPECT_EQ(Consume().size(), 0u);
+}
+
+TEST_F(SegmentLogTest, ConsumeSealedOnly) {
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 100));
+  ASSERT_NE(writer, nullptr);
+  for (int i = 0; i < 8; ++i) {
+    Append(writer.get(), i);
+  }
+
+  // the 2nd segment is being written to
+  ExpectRecords(Consume(), 0, 6);
+  EXPECT_EQ(SegmentCount(), 1u);
+  EXPECT_EQ(Consume().size(), 0u);
+
+  // appending goes on with a new segment after sealing
+  writer->Seal();
+  Append(writer.get(), 8);
+  ExpectRecords(Consume(), 6, 2);
+  EXPECT_EQ(SegmentCount(), 1u);
+
+  writer.reset();
+  ExpectRecords(Consume(), 8, 1);
+  EXPECT_EQ(SegmentCount(), 0u);
+}
+
+TEST_F(SegmentLogTest, ConsumeCheckpoint) {
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 100));
+  ASSERT_NE(writer, nullptr);
+  for (int i = 0; i < 12; ++i) {
+    Append(writer.get(), i);
+  }
+  writer.reset();
+
+  // stopped in the middle of a segment, it is kept
+  ExpectRecords(Consume(4), 0, 4);
+  EXPECT_EQ(SegmentCount(), 2u);
+
+  // resumed from the first record not consumed
+  ExpectRecords(Consume(3), 4, 3);
+  EXPECT_EQ(SegmentCount(), 1u);
+  ExpectRecords(Consume(), 7, 5);
+  EXPECT_EQ(SegmentCount(), 0u);
+}
+
+TEST_F(SegmentLogTest, UnsealedSegmentOfCrashedWriter) {
+  unique_ptr<SegmentLogWriter> writer(
+      SegmentLogWriter::New(dir_, kSegmentSize, 100));
+  ASSERT_NE(writer, nullptr);
+  for (int i = 0; i < 3; ++i) {
+    Append(writer.get(), i);
+  }
+  writer.reset();
+
+  // as if the writer crashed before sealing the segment
+  Overwrite(0, kSealedOffset, 0);
+  EXPECT_EQ(Consume().size(), 0u);
+
+  // sealed by the next writer
+  writer.reset(SegmentLogWriter::New(dir_, kSegmentSize, 100));
+  ASSERT_NE(writer, nullptr);
+  ExpectRecords(Consume(), 0, 3);
+}
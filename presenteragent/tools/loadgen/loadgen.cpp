@@ -0,0 +1,495 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+/**
+ * Load generator for presenter server. Opens N channels and replays a
+ * directory of JPEG images, or a capture recorded by Recorder, at a fixed
+ * rate per channel, through the same Connection and MessageCodec used by
+ * the agent.
+ *
+ * Usage:
+ *   presenter_loadgen -s <host_ip> -p <port> (-j <jpeg_dir> | -r <rec_dir>)
+ *                     [-n channels] [-f fps] [-t seconds] [-c name_prefix]
+ *
+ * A frame is acked when PresentImageResponse is received. Server induced
+ * backpressure shows up as time blocked in send (the server is not reading
+ * fast enough) and as skipped send slots (ack came later than the next
+ * slot, so the channel can not reach the requested fps).
+ */
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <google/protobuf/message.h>
+
+#include "ascenddk/presenter/agent/codec/message_codec.h"
+#include "ascenddk/presenter/agent/connection/connection.h"
+#include "ascenddk/presenter/agent/net/raw_socket_factory.h"
+#include "ascenddk/presenter/agent/presenter/presenter_message_helper.h"
+#include "ascenddk/presenter/agent/record/segment_log.h"
+#include "ascenddk/presenter/agent/util/buffer_pool.h"
+
+using namespace std;
+using namespace ascend::presenter;
+using google::protobuf::Message;
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+struct LoadParam {
+  string host_ip = "127.0.0.1";
+  uint16_t port = 7002;
+  string jpeg_dir;
+  string record_dir;
+  string name_prefix = "loadgen";
+  int channel_num = 1;
+  // 0: send the next frame as soon as the previous one is acked
+  double fps = 25;
+  int duration_s = 10;
+};
+
+// a frame to replay, either a JPEG image or a recorded encoded message
+struct SourceFrame {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  string data;
+  SharedByteBuffer encoded;
+};
+
+struct ChannelStats {
+  PresenterErrorCode open_error = PresenterErrorCode::kNone;
+  uint64_t sent = 0;
+  uint64_t acked = 0;
+  uint64_t failed = 0;
+  uint64_t skipped_slots = 0;
+  uint64_t bytes = 0;
+  int64_t send_blocked_us = 0;
+  vector<int64_t> ack_latency_us;
+};
+
+atomic<bool> g_stop(false);
+
+int64_t ElapsedUs(Clock::time_point from, Clock::time_point to) {
+  return chrono::duration_cast<chrono::microseconds>(to - from).count();
+}
+
+// read width and height from the SOF segment of a JPEG image
+bool ParseJpegSize(const string& data, uint32_t& width, uint32_t& height) {
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+  size_t size = data.size();
+  if (size < 4 || p[0] != 0xFF || p[1] != 0xD8) {
+    return false;
+  }
+
+  size_t pos = 2;
+  while (pos + 4 <= size) {
+    if (p[pos] != 0xFF) {
+      return false;
+    }
+
+    unsigned char marker = p[pos + 1];
+    size_t seg_len = (p[pos + 2] << 8) | p[pos + 3];
+    // SOF0 - SOF15, except DHT(C4), JPG(C8) and DAC(CC)
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4
+        && marker != 0xC8 && marker != 0xCC) {
+      if (pos + 9 > size) {
+        return false;
+      }
+      height = (p[pos + 5] << 8) | p[pos + 6];
+      width = (p[pos + 7] << 8) | p[pos + 8];
+      return width > 0 && height > 0;
+    }
+
+    pos += 2 + seg_len;
+  }
+
+  return false;
+}
+
+bool LoadJpegDir(const string& dir, vector<SourceFrame>& frames) {
+  DIR* dp = opendir(dir.c_str());
+  if (dp == nullptr) {
+    fprintf(stderr, "Failed to open dir %s\n", dir.c_str());
+    return false;
+  }
+
+  vector<string> names;
+  struct dirent* entry = nullptr;
+  while ((entry = readdir(dp)) != nullptr) {
+    string name = entry->d_name;
+    string::size_type dot = name.rfind('.');
+    if (dot == string::npos) {
+      continue;
+    }
+
+    string ext = name.substr(dot + 1);
+    transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext == "jpg" || ext == "jpeg") {
+      names.push_back(name);
+    }
+  }
+  closedir(dp);
+
+  // replay in a stable order
+  sort(names.begin(), names.end());
+  for (const string& name : names) {
+    string path = dir + "/" + name;
+    ifstream file(path, ios::binary);
+    SourceFrame frame;
+    frame.data.assign(istreambuf_iterator<char>(file),
+                      istreambuf_iterator<char>());
+    if (!ParseJpegSize(frame.data, frame.width, frame.height)) {
+      fprintf(stderr, "Skip %s, not a valid JPEG image\n", path.c_str());
+      continue;
+    }
+    frames.push_back(std::move(frame));
+  }
+
+  return !frames.empty();
+}
+
+bool LoadRecording(const string& dir, vector<SourceFrame>& frames) {
+  PresenterErrorCode ret = SegmentLogReader::ReadAll(dir,
+      [&](const char* data, uint32_t length, int64_t timestamp_us) {
+    // the mapping of the segment is released after reading
+    SourceFrame frame;
+    frame.encoded = SharedByteBuffer::Make(length);
+    if (frame.encoded.IsEmpty()) {
+      return false;
+    }
+    memcpy(frame.encoded.GetMutable(), data, length);
+    frames.push_back(frame);
+    return true;
+  });
+
+  if (ret != PresenterErrorCode::kNone) {
+    fprintf(stderr, "Failed to read recording %s, error = %d\n", dir.c_str(),
+            static_cast<int>(ret));
+    return false;
+  }
+
+  return !frames.empty();
+}
+
+PresenterErrorCode OpenLoadChannel(Connection& conn, const string& name) {
+  proto::OpenChannelRequest req;
+  PresenterErrorCode ret = PresenterMessageHelper::CreateOpenChannelRequest(
+      req, name, ContentType::kVideo);
+  if (ret != PresenterErrorCode::kNone) {
+    return ret;
+  }
+
+  ret = conn.SendMessage(req);
+  if (ret != PresenterErrorCode::kNone) {
+    return ret;
+  }
+
+  unique_ptr<Message> resp;
+  ret = conn.ReceiveMessage(resp);
+  if (ret != PresenterErrorCode::kNone) {
+    return ret;
+  }
+
+  return PresenterMessageHelper::CheckOpenChannelResponse(*resp);
+}
+
+// encode the frame the way PresentImage does
+bool EncodeFrame(MessageCodec& codec, const SourceFrame& frame,
+                 vector<SharedByteBuffer>& buffers) {
+  if (!frame.encoded.IsEmpty()) {
+    buffers.assign(1, frame.encoded);
+    return true;
+  }
+
+  ImageFrame image;
+  image.format = ImageFormat::kJpeg;
+  image.width = frame.width;
+  image.height = frame.height;
+  image.size = frame.data.size();
+  image.data = reinterpret_cast<unsigned char*>(
+      const_cast<char*>(frame.data.data()));
+
+  proto::PresentImageRequest req;
+  if (!PresenterMessageHelper::InitPresentImageRequest(req, image)) {
+    return false;
+  }
+
+  Tlv tlv;
+  tlv.tag = proto::PresentImageRequest::kDataFieldNumber;
+  tlv.length = image.size;
+  tlv.value = reinterpret_cast<char*>(image.data);
+
+  PartialMessageWithTlvs message;
+  message.message = &req;
+  message.tlv_list.push_back(tlv);
+  buffers.clear();
+  return codec.EncodeMessage(message, buffers);
+}
+
+void RunChannel(const LoadParam& param, int index,
+                const vector<SourceFrame>& frames, ChannelStats& stats) {
+  RawSocketFactory factory(param.host_ip, param.port);
+  unique_ptr<Connection> conn;
+  Socket* sock = factory.Create();
+  if (sock != nullptr) {
+    conn.reset(Connection::New(sock));
+  }
+  if (conn == nullptr) {
+    stats.open_error = sock == nullptr ? factory.GetErrorCode()
+                                       : PresenterErrorCode::kBadAlloc;
+    return;
+  }
+
+  string name = param.name_prefix + "_" + to_string(index);
+  stats.open_error = OpenLoadChannel(*conn, name);
+  if (stats.open_error != PresenterErrorCode::kNone) {
+    return;
+  }
+
+  MessageCodec codec;
+  vector<SharedByteBuffer> buffers;
+  Clock::duration interval = Clock::duration::zero();
+  if (param.fps > 0) {
+    interval = chrono::duration_cast<Clock::duration>(
+        chrono::duration<double>(1.0 / param.fps));
+  }
+
+  // spread the channels over one interval, so they do not send in bursts
+  Clock::time_point next_slot = Clock::now()
+      + interval * index / param.channel_num;
+  size_t frame_index = index % frames.size();
+  while (!g_stop.load(memory_order_relaxed)) {
+    this_thread::sleep_until(next_slot);
+
+    const SourceFrame& frame = frames[frame_index];
+    frame_index = (frame_index + 1) % frames.size();
+    Clock::time_point start = Clock::now();
+    if (!EncodeFrame(codec, frame, buffers)) {
+      ++stats.failed;
+      break;
+    }
+
+    PresenterErrorCode ret = conn->SendEncodedMessage(buffers);
+    Clock::time_point sent = Clock::now();
+    ++stats.sent;
+    stats.send_blocked_us += ElapsedUs(start, sent);
+    for (const SharedByteBuffer& buffer : buffers) {
+      stats.bytes += buffer.Size();
+    }
+
+    unique_ptr<Message> resp;
+    if (ret == PresenterErrorCode::kNone) {
+      ret = conn->ReceiveMessage(resp);
+    }
+    if (ret == PresenterErrorCode::kNone) {
+      ret = PresenterMessageHelper::CheckPresentImageResponse(*resp);
+    }
+
+    Clock::time_point acked = Clock::now();
+    if (ret != PresenterErrorCode::kNone) {
+      ++stats.failed;
+      // the connection is broken, the server closes the channel
+      if (ret == PresenterErrorCode::kConnection
+          || ret == PresenterErrorCode::kSocketTimeout) {
+        break;
+      }
+      continue;
+    }
+
+    ++stats.acked;
+    stats.ack_latency_us.push_back(ElapsedUs(start, acked));
+
+    // do not catch up with a burst, count the missed slots instead
+    next_slot += interval;
+    while (interval > Clock::duration::zero() && next_slot < acked) {
+      next_slot += interval;
+      ++stats.skipped_slots;
+    }
+  }
+}
+
+double Percentile(const vector<int64_t>& sorted, double percent) {
+  if (sorted.empty()) {
+    return 0;
+  }
+
+  size_t rank = static_cast<size_t>(percent / 100 * (sorted.size() - 1) + 0.5);
+  return sorted[rank] / 1000.0;
+}
+
+void Report(const LoadParam& param, const vector<ChannelStats>& stats,
+            double elapsed_s) {
+  ChannelStats total;
+  int opened = 0;
+  for (size_t i = 0; i < stats.size(); ++i) {
+    const ChannelStats& s = stats[i];
+    if (s.open_error != PresenterErrorCode::kNone) {
+      fprintf(stderr, "Channel %s_%zu failed to open, error = %d\n",
+              param.name_prefix.c_str(), i, static_cast<int>(s.open_error));
+      continue;
+    }
+
+    ++opened;
+    total.sent += s.sent;
+    total.acked += s.acked;
+    total.failed += s.failed;
+    total.skipped_slots += s.skipped_slots;
+    total.bytes += s.bytes;
+    total.send_blocked_us += s.send_blocked_us;
+    total.ack_latency_us.insert(total.ack_latency_us.end(),
+                                s.ack_latency_us.begin(),
+                                s.ack_latency_us.end());
+  }
+
+  vector<int64_t>& latency = total.ack_latency_us;
+  sort(latency.begin(), latency.end());
+  printf("channels        : %d opened / %d\n", opened, param.channel_num);
+  printf("duration        : %.2f s\n", elapsed_s);
+  printf("frames          : %llu sent, %llu acked, %llu failed\n",
+         static_cast<unsigned long long>(total.sent),
+         static_cast<unsigned long long>(total.acked),
+         static_cast<unsigned long long>(total.failed));
+  printf("throughput      : %.1f fps, %.2f MB/s (target %.1f fps)\n",
+         total.acked / elapsed_s, total.bytes / elapsed_s / 1024 / 1024,
+         param.fps * opened);
+  printf("ack latency(ms) : p50 %.2f, p90 %.2f, p99 %.2f, max %.2f\n",
+         Percentile(latency, 50), Percentile(latency, 90),
+         Percentile(latency, 99), Percentile(latency, 100));
+  double blocked = opened > 0 ? total.send_blocked_us / 1e6 / opened : 0;
+  printf("backpressure    : %.1f%% of time blocked in send, "
+         "%llu send slots skipped\n", blocked / elapsed_s * 100,
+         static_cast<unsigned long long>(total.skipped_slots));
+  BufferPoolStats pool = BufferPool::GetInstance().GetStats();
+  printf("buffer pool     : %.1f%% hit of %llu allocations, "
+         "%llu system allocations, %.2f MB reserved, %.2f MB cached\n",
+         pool.HitRate() * 100,
+         static_cast<unsigned long long>(pool.allocations),
+         static_cast<unsigned long long>(pool.system_allocations),
+         pool.bytes_reserved / 1024.0 / 1024,
+         pool.bytes_cached / 1024.0 / 1024);
+}
+
+void Usage(const char* prog) {
+  fprintf(stderr,
+          "Usage: %s -s host_ip -p port (-j jpeg_dir | -r record_dir)\n"
+          "          [-n channels] [-f fps, 0 for unlimited] [-t seconds]\n"
+          "          [-c channel_name_prefix]\n", prog);
+}
+
+bool ParseArgs(int argc, char* argv[], LoadParam& param) {
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "s:p:j:r:n:f:t:c:")) != -1) {
+    switch (opt) {
+      case 's':
+        param.host_ip = optarg;
+        break;
+      case 'p':
+        param.port = static_cast<uint16_t>(atoi(optarg));
+        break;
+      case 'j':
+        param.jpeg_dir = optarg;
+        break;
+      case 'r':
+        param.record_dir = optarg;
+        break;
+      case 'n':
+        param.channel_num = atoi(optarg);
+        break;
+      case 'f':
+        param.fps = atof(optarg);
+        break;
+      case 't':
+        param.duration_s = atoi(optarg);
+        break;
+      case 'c':
+        param.name_prefix = optarg;
+        break;
+      default:
+        return false;
+    }
+  }
+
+  return param.jpeg_dir.empty() != param.record_dir.empty()
+      && param.channel_num > 0 && param.fps >= 0 && param.duration_s > 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  LoadParam param;
+  if (!ParseArgs(argc, argv, param)) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  vector<SourceFrame> frames;
+  bool loaded = param.jpeg_dir.empty() ?
+      LoadRecording(param.record_dir, frames) :
+      LoadJpegDir(param.jpeg_dir, frames);
+  if (!loaded) {
+    fprintf(stderr, "No frame to replay\n");
+    return 1;
+  }
+
+  printf("replaying %zu frames on %d channels to %s:%u\n", frames.size(),
+         param.channel_num, param.host_ip.c_str(), param.port);
+
+  vector<ChannelStats> stats(param.channel_num);
+  vector<thread> threads;
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < param.channel_num; ++i) {
+    threads.emplace_back(RunChannel, cref(param), i, cref(frames),
+                         ref(stats[i]));
+  }
+
+  this_thread::sleep_for(chrono::seconds(param.duration_s));
+  g_stop = true;
+  for (thread& t : threads) {
+    t.join();
+  }
+
+  Report(param, stats, ElapsedUs(start, Clock::now()) / 1e6);
+  return 0;
+}
@@ -35,8 +35,10 @@
 import time
 import logging
 import threading
+import collections
 from threading import get_ident
 from common.channel_manager import ChannelManager
+from common.channel_metrics import ChannelMetrics
 
 # thread event timeout, The unit is second.
 WEB_EVENT_TIMEOUT = 2
@@ -46,6 +48,19 @@ IMAGE_EVENT_TIMEOUT = 10
 # heart beat timeout, The unit is second.
 HEARTBEAT_TIMEOUT = 100
 
+# policies of a full frame ring
+# drop the oldest frame in the ring, the browser sees the latest frames
+RING_POLICY_DROP_OLDEST = "drop-oldest"
+# drop the received frame
+RING_POLICY_DROP_NEWEST = "drop-newest"
+# wait until the video thread takes a frame, the agent is throttled
+RING_POLICY_BLOCK = "block"
+RING_POLICIES = (RING_POLICY_DROP_OLDEST, RING_POLICY_DROP_NEWEST,
+                 RING_POLICY_BLOCK)
+
+# default number of frames a video channel buffers
+FRAME_RING_SIZE = 4
+
 class ThreadEvent():
     """An Event-like class that signals all active clients when a new frame is
     available.
@@ -88,41 +103,133 @@ class ThreadEvent():
         """Invoked from each client's thread after a frame was processed."""
         self.events[get_ident()][0].clear()
 
+class FrameRing():
+    """bounded queue of the frames of a video channel, from the ingest
+    thread to the video thread"""
+    def __init__(self, size, policy):
+        """
+        Args:
+            size: max number of frames queued
+            policy: RING_POLICY_*, what to do if the ring is full
+        """
+        self.frames = collections.deque()
+        self.size = size
+        self.policy = policy
+        self.closed = False
+        # number of frames dropped because the ring is full
+        self.dropped = 0
+        self.cond = threading.Condition()
+
+    def put(self, frame):
+        """
+        Queue a frame, only RING_POLICY_BLOCK waits if the ring is full
+        Returns:
+            False if the frame is dropped or the ring is closed
+        """
+        with self.cond:
+            if len(self.frames) >= self.size:
+                if self.policy == RING_POLICY_DROP_NEWEST:
+                    self.dropped += 1
+                    return False
+                if self.policy == RING_POLICY_DROP_OLDEST:
+                    self.frames.popleft()
+                    self.dropped += 1
+                else:
+                    while len(self.frames) >= self.size and not self.closed:
+                        self.cond.wait()
+
+            if self.closed:
+                return False
+
+            self.frames.append(frame)
+            self.cond.notify_all()
+            return True
+
+    def get(self, timeout):
+        """
+        Take the oldest frame
+        Returns:
+            None if no frame comes in timeout seconds, or the ring is closed
+        """
+        with self.cond:
+            if not self.frames and not self.closed:
+                self.cond.wait(timeout)
+            if self.closed or not self.frames:
+                return None
+
+            frame = self.frames.popleft()
+            self.cond.notify_all()
+            return frame
+
+    def close(self):
+        """wake up the threads waiting on the ring, no more frames queued"""
+        with self.cond:
+            self.closed = True
+            self.frames.clear()
+            self.cond.notify_all()
+
+
 class ChannelHandler():
     """A set of channel handlers, process data received from channel"""
+    # size and policy of the frame ring of a video channel
+    frame_ring_size = FRAME_RING_SIZE
+    frame_ring_policy = RING_POLICY_DROP_OLDEST
+    # called as frame_listener(channel_name, frame_info) by the video thread
+    # of every channel when a frame is handed to the browsers
+    frame_listener = None
+
     def __init__(self, channel_name, media_type):
         self.channel_name = channel_name
         self.media_type = media_type
         self.img_data = None
-        self._frame = None
         self.thread = None
-        self._frame = None
+        # last frame handed to the browsers: (data, fps, width, height,
+        # rectangle_list, crop_list)
+        self._frame_info = (None, None, None, None, None, None)
         # last time the channel receive data.
         self.heartbeat = time.time()
         self.web_event = ThreadEvent(timeout=WEB_EVENT_TIMEOUT)
-        self.image_event = ThreadEvent(timeout=IMAGE_EVENT_TIMEOUT)
         self.lock = threading.Lock()
         self.channel_manager = ChannelManager([])
         self.rectangle_list = None
+        # crops of the detected objects, only set by save_rois
+        self.crop_list = None
+        self.metrics = ChannelMetrics()
 
         if media_type == "video":
             self.thread_name = "videothread-{}".format(self.channel_name)
             self.heartbeat = time.time()
             self.close_thread_switch = False
-            self.fps = 0
-            self.image_number = 0
-            self.time_list = []
+            self.frame_ring = FrameRing(self.frame_ring_size,
+                                        self.frame_ring_policy)
             self._create_thread()
 
+    @classmethod
+    def set_frame_ring(cls, size, policy):
+        """set size and policy of the frame ring of the video channels"""
+        cls.frame_ring_size = size
+        cls.frame_ring_policy = policy
+
+    @classmethod
+    def set_frame_listener(cls, listener):
+        """set the listener pushing the frames of all channels"""
+        cls.frame_listener = listener
+
     def close_thread(self):
         """close thread if object has created"""
         if self.thread is None:
             return
 
         self.set_thread_switch()
-        self.image_event.set()
+        self.frame_ring.close()
         logging.info("%s set _close_thread_switch True", self.thread_name)
 
+    def close(self):
+        """the channel is released, stop the thread and wake up the web
+        clients waiting for frames"""
+        self.close_thread()
+        self.web_event.set()
+
     def set_heartbeat(self):
         """record heartbeat"""
         self.heartbeat = time.time()
@@ -131,36 +238,70 @@ class ChannelHandler():
         """record heartbeat"""
         self.close_thread_switch = True
 
-    def save_image(self, data, width, height, rectangle_list):
+    def save_image(self, data, width, height, rectangle_list, crop_list=None):
         """save image receive from socket"""
+        size = len(data)
+        if crop_list is not None:
+            size += sum(len(crop) for crop in crop_list)
+        self._save_frames([(data, width, height, rectangle_list, crop_list)],
+                          size)
+
+    def _save_frames(self, frames, size):
+        """Internal func, save frames received together
+        Args:
+            frames: list of (data, width, height, rectangle_list, crop_list),
+                    in display order
+            size: bytes of all the frames
+        """
+        data, width, height, rectangle_list, crop_list = frames[-1]
         self.width = width
         self.height = height
         self.rectangle_list = rectangle_list
 
-        # compute fps if type is video
         if self.media_type == "video":
-            self.rectangle_list = rectangle_list
-            while self.img_data:
-                time.sleep(0.01)
-
-            self.time_list.append(self.heartbeat)
-            self.image_number += 1
-            while self.time_list[0] + 1 < time.time():
-                self.time_list.pop(0)
-                self.image_number -= 1
-                if self.image_number == 0:
-                    break
-
-            self.fps = len(self.time_list)
-            self.img_data = data
-            self.image_event.set()
+            self.crop_list = crop_list
+            fps = self.metrics.add_frames(size, len(frames))
+            # every frame goes to the ring, its policy decides which ones
+            # are dropped if the video thread falls behind
+            dropped = self.frame_ring.dropped
+            for data, width, height, rectangle_list, crop_list in frames:
+                self.frame_ring.put((data, fps, width, height,
+                                     rectangle_list, crop_list))
+            if self.frame_ring.dropped != dropped:
+                self.metrics.add_drops(self.frame_ring.dropped - dropped)
         else:
+            # an image channel shows the newest image only
             self.img_data = data
             self.channel_manager.save_channel_image(self.channel_name,
                                                     self.img_data, self.rectangle_list)
+            self.metrics.add_frames(size, len(frames))
 
         self.heartbeat = time.time()
 
+    def save_images(self, images):
+        """
+        save a batch of images receive from socket in one pass
+        Args:
+            images: list of (data, width, height, rectangle_list),
+                    in display order
+        """
+        self._save_frames([image + (None,) for image in images],
+                          sum(len(image[0]) for image in images))
+
+    def save_rois(self, data, width, height, rectangle_list, crop_list):
+        """
+        save crops of the detected objects receive from socket, only
+        supported by video channel
+        Args:
+            data: low-res full frame, empty if not sent. The browser keeps
+                  the last one and draws the crops on it
+            width: width of the full frame
+            height: height of the full frame
+            rectangle_list: regions of the crops in the full frame
+            crop_list: crop_list[i] is the image of rectangle_list[i]
+        """
+        self.save_image(data, width, height, rectangle_list, crop_list)
+
 
     def get_media_type(self):
         """get media_type, support image or video"""
@@ -187,18 +328,17 @@ class ChannelHandler():
         # True: _web_event return because set()
         # False: _web_event return because timeout
         if ret:
-            return (self._frame, self.fps, self.width, self.height, self.rectangle_list)
+            return self._frame_info
 
-        return (None, None, None, None, None)
+        return (None, None, None, None, None, None)
 
     def frames(self):
         """a generator generates image"""
         while True:
-            self.image_event.wait()
-            self.image_event.clear()
-            if self.img_data:
-                yield self.img_data
-                self.img_data = None
+            # a crop only frame has empty data
+            frame = self.frame_ring.get(IMAGE_EVENT_TIMEOUT)
+            if frame is not None:
+                yield frame
 
             # if set _close_thread_switch, return immediately
             if self.close_thread_switch:
@@ -208,21 +348,23 @@ class ChannelHandler():
             # stop the thread and close socket
             if time.time() - self.heartbeat > HEARTBEAT_TIMEOUT:
                 self.set_thread_switch()
-                self.img_data = None
                 yield None
 
     def _video_thread(self):
         """background thread to process video"""
         logging.info('create %s...', (self.thread_name))
         for frame in self.frames():
-            if frame:
+            if frame is not None:
                 # send signal to clients
-                self._frame = frame
+                self._frame_info = frame
                 self.web_event.set()
+                if self.frame_listener is not None:
+                    self.frame_listener(self.channel_name, frame)
 
             # exit thread
             if self.close_thread_switch:
                 self.channel_manager.clean_channel_resource_by_name(
                     self.channel_name)
-                logging.info('Stop thread:%s.', (self.thread_name))
+                logging.info('Stop thread:%s, %d frames dropped.',
+                             self.thread_name, self.frame_ring.dropped)
                 break
@@ -34,8 +34,8 @@
 import logging
 import threading
 
-# max support 10 channels
-MAX_CHANNEL_NUM = 10
+# default max number of channels, set by max_channel_num in config.conf
+MAX_CHANNEL_NUM = 1024
 
 # when a channel have receive data,
 # the active status will last 3 seconds
@@ -60,11 +60,13 @@ class ChannelFd():
 class Channel():
     """record user register channels
         self.image: if channel type is image, save the image here
+        self.lock: protect image and rectangle_list
     """
     def __init__(self, channel_name):
         self.channel_name = channel_name
         self.image = None
         self.rectangle_list = None
+        self.lock = threading.Lock()
 
 class ChannelManager():
     """manage all the api about channel
@@ -75,12 +77,17 @@ class ChannelManager():
     _channel_fds: a dict
         key: socket fileno
         value: a ChannelFd() object.
-    _channel_list: a list, member is a Channel() object."""
+    _channels: a dict, in register order
+        key: channel name
+        value: a Channel() object.
+        channel_lock only protects the dict, a Channel() object has
+        its own lock."""
 
     __instance = None
     channel_resources = {}
     channel_fds = {}
-    channel_list = []
+    channels = {}
+    max_channel_num = MAX_CHANNEL_NUM
     channel_resource_lock = threading.Lock()
     channel_fds_lock = threading.Lock()
     channel_lock = threading.Lock()
@@ -132,9 +139,7 @@ class ChannelManager():
     def _clean_channel_resource(self, channel_name):
         """Internal func, clean channel resource by channel name"""
         if self.channel_resources.get(channel_name):
-            self.channel_resources[channel_name].handler.close_thread()
-            self.channel_resources[channel_name].handler.web_event.set()
-            self.channel_resources[channel_name].handler.image_event.set()
+            self.channel_resources[channel_name].handler.close()
             del self.channel_resources[channel_name]
             logging.info("clean channel: %s's resource", channel_name)
 
@@ -188,31 +193,42 @@ class ChannelManager():
                 return self.channel_resources[channel_name].handler
             return None
 
+    @classmethod
+    def set_max_channel_num(cls, max_channel_num):
+        """set max number of the channels registered"""
+        cls.max_channel_num = max_channel_num
+
+    def _get_channel(self, channel_name):
+        """Internal func, get the Channel() object, None if not exist"""
+        with self.channel_lock:
+            return self.channels.get(channel_name)
+
     def list_channels(self):
         """
         return all the channel name and the status
         status is indicating active state or not
         """
         with self.channel_lock:
-            return [{'status': self.is_channel_busy(i.channel_name),
-                     'name': i.channel_name} for i in self.channel_list]
+            channel_names = list(self.channels)
+        with self.channel_resource_lock:
+            return [{'status': channel_name in self.channel_resources,
+                     'name': channel_name} for channel_name in channel_names]
 
     def register_one_channel(self, channel_name):
         """
         register a channel path, user create a channel via browser
         """
         with self.channel_lock:
-            if len(self.channel_list) >= MAX_CHANNEL_NUM:
-                logging.info("register channel: %s fail, \
-                             exceed max number 10.", channel_name)
+            if channel_name in self.channels:
+                logging.info("register channel: %s fail, already exist.",
+                             channel_name)
+                return self.err_code_repeat_channel
+            if len(self.channels) >= self.max_channel_num:
+                logging.info("register channel: %s fail, exceed max number "
+                             "%d.", channel_name, self.max_channel_num)
                 return self.err_code_too_many_channel
-            for i in range(len(self.channel_list)):
-                if self.channel_list[i].channel_name == channel_name:
-                    logging.info("register channel: %s fail, \
-                                 already exist.", channel_name)
-                    return self.err_code_repeat_channel
 
-            self.channel_list.append(Channel(channel_name=channel_name))
+            self.channels[channel_name] = Channel(channel_name=channel_name)
             logging.info("register channel: %s", channel_name)
             return self.err_code_ok
 
@@ -221,12 +237,10 @@ class ChannelManager():
         unregister a channel path, user delete a channel via browser
         """
         with self.channel_lock:
-            for i in range(len(self.channel_list)):
-                if self.channel_list[i].channel_name == channel_name:
-                    self.clean_channel_resource_by_name(channel_name)
-                    logging.info("unregister channel: %s", channel_name)
-                    del self.channel_list[i]
-                    break
+            if channel_name in self.channels:
+                self.clean_channel_resource_by_name(channel_name)
+                logging.info("unregister channel: %s", channel_name)
+                del self.channels[channel_name]
 
     def is_channel_exist(self, channel_name):
         """
@@ -235,10 +249,7 @@ class ChannelManager():
         False: not exist
         """
         with self.channel_lock:
-            for i in range(len(self.channel_list)):
-                if self.channel_list[i].channel_name == channel_name:
-                    return True
-            return False
+            return channel_name in self.channels
 
     def save_channel_image(self, channel_name, image_data, rectangle_list):
         """
@@ -246,12 +257,11 @@ class ChannelManager():
         server will permanent hold an image for it.
         this func save a image in memory
         """
-        with self.channel_lock:
-            for i in range(len(self.channel_list)):
-                if self.channel_list[i].channel_name == channel_name:
-                    self.channel_list[i].image = image_data
-                    self.channel_list[i].rectangle_list = rectangle_list
-                    break
+        channel = self._get_channel(channel_name)
+        if channel is not None:
+            with channel.lock:
+                channel.image = image_data
+                channel.rectangle_list = rectangle_list
 
     def get_channel_image(self, channel_name):
         """
@@ -259,33 +269,33 @@ class ChannelManager():
         server will permanent hold an image for it.
         this func get the image
         """
-        with self.channel_lock:
-            for i in range(len(self.channel_list)):
-                if self.channel_list[i].channel_name == channel_name:
-                    return self.channel_list[i].image
-
-            # channel not exist
+        channel = self._get_channel(channel_name)
+        # channel not exist
+        if channel is None:
             return None
 
+        with channel.lock:
+            return channel.image
+
     def get_channel_image_with_rectangle(self, channel_name):
         """
         A new method for display server,
         return the image and rectangle list
         """
-        with self.channel_lock:
-            for i in range(len(self.channel_list)):
-                if self.channel_list[i].channel_name == channel_name:
-                    return (self.channel_list[i].image, self.channel_list[i].rectangle_list)
+        channel = self._get_channel(channel_name)
+        if channel is None:
             return (None, None)
 
+        with channel.lock:
+            return (channel.image, channel.rectangle_list)
+
     def clean_channel_image(self, channel_name):
         """
         when a channel bounding to image type,
         server will permanent hold an image for it.
         this func clean the image
         """
-        with self.channel_lock:
-            for i in range(len(self.channel_list)):
-                if self.channel_list[i].channel_name == channel_name:
-                    self.channel_list[i].image = None
-                    break
+        channel = self._get_channel(channel_name)
+        if channel is not None:
+            with channel.lock:
+                channel.image = None
@@ -0,0 +1,166 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+"""presenter channel metrics module"""
+
+import time
+import threading
+
+# number of one second buckets, as long as the longest window
+METRICS_BUCKETS = 60
+
+# windows of the metrics, The unit is second.
+METRICS_WINDOWS = (1, 10, 60)
+
+class ChannelMetrics():
+    """frame rate, throughput, jitter and drops of a channel.
+
+    The frames of each second are counted in a bucket of a fixed ring, so
+    recording a frame costs the same whatever the rate. A window sums the
+    buckets of its last complete seconds.
+    """
+    def __init__(self):
+        self.lock = threading.Lock()
+        # second counted in each bucket, a bucket is reset when reused
+        self.seconds = [-1] * METRICS_BUCKETS
+        self.frames = [0] * METRICS_BUCKETS
+        self.bytes = [0] * METRICS_BUCKETS
+        self.drops = [0] * METRICS_BUCKETS
+        # number, sum and sum of squares of the inter-frame intervals
+        self.intervals = [0] * METRICS_BUCKETS
+        self.interval_sums = [0.0] * METRICS_BUCKETS
+        self.interval_squares = [0.0] * METRICS_BUCKETS
+        self.last_frame_time = None
+        # the current second, its bucket, and the frames of the second
+        # before it
+        self.second = -1
+        self.index = 0
+        self.last_second_frames = 0
+
+    def _start_second(self, second):
+        """Internal func, move to the bucket of a new second"""
+        last_index = (second - 1) % METRICS_BUCKETS
+        if self.seconds[last_index] == second - 1:
+            self.last_second_frames = self.frames[last_index]
+        else:
+            self.last_second_frames = 0
+
+        index = second % METRICS_BUCKETS
+        self.seconds[index] = second
+        self.frames[index] = 0
+        self.bytes[index] = 0
+        self.drops[index] = 0
+        self.intervals[index] = 0
+        self.interval_sums[index] = 0.0
+        self.interval_squares[index] = 0.0
+        self.second = second
+        self.index = index
+
+    def add_frames(self, size, frame_num=1):
+        """
+        record frames received together
+        Args:
+            size: bytes of the frames
+            frame_num: number of the frames, more than 1 for a batch
+        Returns:
+            frames received in the last complete second
+        """
+        now = time.time()
+        second = int(now)
+        with self.lock:
+            if second != self.second:
+                self._start_second(second)
+            index = self.index
+            self.frames[index] += frame_num
+            self.bytes[index] += size
+            if self.last_frame_time is not None:
+                interval = now - self.last_frame_time
+                self.intervals[index] += 1
+                self.interval_sums[index] += interval
+                self.interval_squares[index] += interval * interval
+            self.last_frame_time = now
+            return self.last_second_frames
+
+    def add_drops(self, dropped):
+        """record frames dropped because the channel is full"""
+        second = int(time.time())
+        with self.lock:
+            if second != self.second:
+                self._start_second(second)
+            self.drops[self.index] += dropped
+
+    def get_fps(self):
+        """frames received in the last complete second"""
+        second = int(time.time()) - 1
+        with self.lock:
+            index = second % METRICS_BUCKETS
+            if self.seconds[index] != second:
+                return 0
+            return self.frames[index]
+
+    def get_window(self, window):
+        """
+        get the metrics of the last complete seconds
+        Args:
+            window: number of seconds, at most METRICS_BUCKETS
+        Returns:
+            dict of fps, bytes_per_second, jitter_ms and drops, jitter is
+            the standard deviation of the inter-frame intervals
+        """
+        now = int(time.time())
+        frames = size = drops = intervals = 0
+        interval_sum = interval_square = 0.0
+        with self.lock:
+            for second in range(now - window, now):
+                index = second % METRICS_BUCKETS
+                if self.seconds[index] != second:
+                    continue
+                frames += self.frames[index]
+                size += self.bytes[index]
+                drops += self.drops[index]
+                intervals += self.intervals[index]
+                interval_sum += self.interval_sums[index]
+                interval_square += self.interval_squares[index]
+
+        jitter = 0.0
+        if intervals > 1:
+            mean = interval_sum / intervals
+            jitter = max(interval_square / intervals - mean * mean, 0) ** 0.5
+
+        return {'fps': round(frames / window, 2),
+                'bytes_per_second': size // window,
+                'jitter_ms': round(jitter * 1000, 2),
+                'drops': drops}
+
+    def get_all(self):
+        """get the metrics of all the windows, keyed by "1s", "10s"..."""
+        return {"{}s".format(window): self.get_window(window)
+                for window in METRICS_WINDOWS}
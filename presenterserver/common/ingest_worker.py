@@ -0,0 +1,532 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+"""multi-process ingest of presenter agent connections.
+
+Each worker process binds the presenter server port with SO_REUSEPORT and
+runs its own epoll loop, so messages of agents are received and parsed on
+all the cores. Channels are owned by the main process, which serves the
+web pages. A worker asks the main process to open a channel, and forwards
+the frames of the channel over its IPC bus, a duplex pipe between them.
+"""
+
+import os
+import time
+import struct
+import signal
+import socket
+import logging
+import threading
+import collections
+import multiprocessing
+import multiprocessing.reduction
+from common.channel_manager import ChannelManager
+from common.channel_handler import ChannelHandler
+from common.channel_handler import RING_POLICY_BLOCK
+from common.channel_handler import RING_POLICY_DROP_NEWEST
+import common.presenter_message_pb2 as pb2
+from common.presenter_socket_server import open_channel
+
+# max number of ingest worker processes
+MAX_WORKER_NUM = 64
+
+# socket fileno of a worker is mapped to a key unique in the main process,
+# key = (worker index + 1) * WORKER_FD_SPACE + fileno
+WORKER_FD_SPACE = 1 << 20
+
+# messages of the IPC bus, from worker to main process
+BUS_OPEN = "open"
+BUS_CLOSE = "close"
+BUS_HEARTBEAT = "heartbeat"
+BUS_IMAGES = "images"
+
+# length head of a message on the bus, the worker frames its messages as
+# multiprocessing.Connection does, the main process receives them with
+# recv() and recv_bytes()
+BUS_MSG_HEAD = struct.Struct('!i')
+
+# max bytes of the messages queued on the bus of a worker. Beyond it the
+# frames are dropped by the policy of the frame ring, or with
+# RING_POLICY_BLOCK the agent connections of the worker are not read
+MAX_BUS_UNSENT_BYTES = 64 * 1024 * 1024
+
+# max buffers sent by one sendmsg()
+MAX_SEND_BUFFERS = 512
+
+class BusMessage():
+    """a message queued on the bus, its buffers are sent in order"""
+    def __init__(self, buffers, key=None, frame_num=0, dropped=0):
+        """
+        Args:
+            buffers: bytes-like objects of the message, heads included
+            key: key of the channel of the frames
+            frame_num: number of the frames in the message, 0 if the
+                       message is not frames
+            dropped: frames dropped before, reported by the message
+        """
+        self.buffers = buffers
+        self.size = sum(len(buf) for buf in buffers)
+        self.key = key
+        self.frame_num = frame_num
+        self.dropped = dropped
+
+class PendingOpen():
+    """an open channel request of the worker waiting for its reply"""
+    def __init__(self, channel_manager, channel_name, media_type, conn,
+                 callback):
+        self.channel_manager = channel_manager
+        self.channel_name = channel_name
+        self.media_type = media_type
+        self.conn = conn
+        self.sock_fileno = conn.fileno()
+        self.callback = callback
+        # the connection is closed and the channel is closed on the bus
+        self.cancelled = False
+
+    def is_closed(self):
+        """the agent connection is closed before the reply"""
+        return self.conn.fileno() == -1
+
+
+class IngestBus():
+    """worker side of the IPC bus, used by the epoll thread of the worker.
+    The main process only sends replies of the open channel requests, in
+    request order, so the epoll thread polls the bus with the sockets.
+    Messages to the main process are queued and sent without blocking,
+    the epoll thread flushes them when the bus is writable"""
+    def __init__(self, conn, worker_index, policy=None):
+        """
+        Args:
+            conn: worker end of a duplex multiprocessing.Pipe()
+            worker_index: index of the worker
+            policy: RING_POLICY_* applied to the frames if the bus is full,
+                    the policy of the frame rings by default
+        """
+        self.conn = conn
+        # the pipe is a socket pair, sent to with MSG_DONTWAIT so that
+        # replies are still received by the blocking conn
+        self.sock = socket.socket(fileno=os.dup(conn.fileno()))
+        self.worker_index = worker_index
+        if policy is None:
+            policy = ChannelHandler.frame_ring_policy
+        self.policy = policy
+        # PendingOpen of the requests sent, in sending order
+        self.pending_opens = collections.deque()
+        # BusMessage not sent yet, bytes of them, and bytes of the first
+        # one sent
+        self.unsent = collections.deque()
+        self.unsent_bytes = 0
+        self.sent = 0
+        # key -> frames dropped since the last frames of the channel sent
+        self.dropped = {}
+        # the main process exits, messages are discarded
+        self.closed = False
+
+    def fileno(self):
+        """fileno of the bus, readable when replies come"""
+        return self.conn.fileno()
+
+    def close(self):
+        """close the worker end of the bus"""
+        self.sock.close()
+        self.conn.close()
+
+    def has_unsent(self):
+        """messages are waiting for the bus to be writable"""
+        return bool(self.unsent)
+
+    def is_blocked(self):
+        """the bus is full with RING_POLICY_BLOCK, no more frames should be
+        received until it is flushed"""
+        return self.policy == RING_POLICY_BLOCK and not self.closed and \
+               self.unsent_bytes > MAX_BUS_UNSENT_BYTES
+
+    @staticmethod
+    def _pack(buf):
+        """buffers of a message of raw bytes"""
+        return [BUS_MSG_HEAD.pack(len(buf)), buf]
+
+    def _send(self, obj):
+        """queue a pickled message, never dropped"""
+        self._queue(BusMessage(self._pack(
+            multiprocessing.reduction.ForkingPickler.dumps(obj))))
+
+    def _queue(self, message):
+        """queue a message, and send as much as possible"""
+        if self.closed:
+            return
+        self.unsent.append(message)
+        self.unsent_bytes += message.size
+        self.flush()
+
+    def flush(self):
+        """send the queued messages until the bus is full, never blocks"""
+        while self.unsent:
+            message = self.unsent[0]
+            buffers = []
+            skip = self.sent
+            for buf in message.buffers:
+                if skip >= len(buf):
+                    skip -= len(buf)
+                    continue
+                buffers.append(memoryview(buf)[skip:])
+                skip = 0
+
+            try:
+                sent = self.sock.sendmsg(buffers[:MAX_SEND_BUFFERS], [],
+                                         socket.MSG_DONTWAIT)
+            except (BlockingIOError, InterruptedError):
+                return
+            except OSError:
+                self._discard()
+                return
+
+            self.sent += sent
+            self.unsent_bytes -= sent
+            if self.sent == message.size:
+                self.unsent.popleft()
+                self.sent = 0
+
+    def _discard(self):
+        """the main process exits, discard the messages"""
+        if not self.closed:
+            logging.error("main process exited, %d bus messages discarded",
+                          len(self.unsent))
+            self.closed = True
+            self.unsent.clear()
+            self.unsent_bytes = 0
+            self.sent = 0
+
+    def _reserve(self, size):
+        """
+        Make room for frames of size bytes by the policy
+        Returns:
+            False if the frames are to be dropped
+        """
+        if not self.unsent or \
+           self.unsent_bytes + size <= MAX_BUS_UNSENT_BYTES:
+            return True
+
+        if self.policy == RING_POLICY_DROP_NEWEST:
+            return False
+
+        if self.policy == RING_POLICY_BLOCK:
+            return True
+
+        # the frames not being sent are dropped, oldest first
+        messages = self.unsent
+        self.unsent = collections.deque()
+        for index, message in enumerate(messages):
+            if message.frame_num and (index > 0 or self.sent == 0) and \
+               self.unsent_bytes + size > MAX_BUS_UNSENT_BYTES:
+                self.unsent_bytes -= message.size
+                self._add_dropped(message.key,
+                                  message.frame_num + message.dropped)
+            else:
+                self.unsent.append(message)
+        return True
+
+    def _add_dropped(self, key, frame_num):
+        """count frames of a channel dropped on the bus"""
+        self.dropped[key] = self.dropped.get(key, 0) + frame_num
+
+    def get_key(self, sock_fileno):
+        """key of a socket fileno of the worker in the main process"""
+        return (self.worker_index + 1) * WORKER_FD_SPACE + sock_fileno
+
+    def open_channel(self, channel_manager, channel_name, media_type, conn,
+                     callback):
+        """
+        Open a channel in the main process, same as open_channel(), without
+        waiting for the result
+        Args:
+            channel_manager: ChannelManager of the worker
+            channel_name: channel name
+            media_type: image or video
+            conn: socket connection of the agent
+            callback: invoked by process_replies() with the
+                      OpenChannelErrorCode, returns False if the
+                      connection is to be closed
+        """
+        sock_fileno = conn.fileno()
+        key = self.get_key(sock_fileno)
+        # a closed connection may have a request of the same fileno
+        # waiting, its channel is closed before the new one is opened
+        for pending in self.pending_opens:
+            if pending.sock_fileno == sock_fileno and pending.is_closed():
+                self._cancel(pending)
+
+        self._send((BUS_OPEN, key, channel_name, media_type))
+        self.pending_opens.append(PendingOpen(channel_manager, channel_name,
+                                              media_type, conn, callback))
+
+    def _cancel(self, pending):
+        """close the channel of a request whose connection is closed"""
+        if not pending.cancelled:
+            pending.cancelled = True
+            self.close_channel(pending.sock_fileno)
+
+    def process_replies(self):
+        """
+        Process the replies received, never blocks
+        Returns:
+            ret: False if the main process exits
+            conns: connections whose callbacks return False
+        """
+        failed = []
+        try:
+            while self.conn.poll():
+                err_code = self.conn.recv()
+                if not self.pending_opens:
+                    logging.error("unexpected bus reply %s", err_code)
+                    continue
+                pending = self.pending_opens.popleft()
+                if not self._reply(pending, err_code):
+                    failed.append(pending.conn)
+        except (EOFError, OSError):
+            logging.error("main process exited, %d channels not opened",
+                          len(self.pending_opens))
+            self._discard()
+            while self.pending_opens:
+                pending = self.pending_opens.popleft()
+                if not self._reply(pending, pb2.kOpenChannelErrorOther):
+                    failed.append(pending.conn)
+            return False, failed
+
+        return True, failed
+
+    def _reply(self, pending, err_code):
+        """
+        Complete an open channel request
+        Returns:
+            False if the connection is to be closed
+        """
+        if pending.cancelled:
+            return True
+
+        if pending.is_closed():
+            if err_code == 0:
+                self._cancel(pending)
+            return True
+
+        if err_code == 0:
+            handler = RemoteChannelHandler(self, pending.sock_fileno,
+                                           pending.channel_name,
+                                           pending.media_type)
+            pending.channel_manager.create_channel_resource(
+                pending.channel_name, pending.sock_fileno,
+                pending.media_type, handler)
+        return pending.callback(err_code)
+
+    def close_channel(self, sock_fileno):
+        """close the channel of a socket fileno in the main process"""
+        key = self.get_key(sock_fileno)
+        self.dropped.pop(key, None)
+        self._send((BUS_CLOSE, key))
+
+    def set_heartbeat(self, sock_fileno):
+        """refresh heartbeat of the channel in the main process"""
+        self._send((BUS_HEARTBEAT, self.get_key(sock_fileno)))
+
+    def save_images(self, sock_fileno, images):
+        """
+        Forward images to the channel in the main process, the data is sent
+        as raw bytes after the other fields. The data is not pickled, but
+        it is copied through the pipe, measured 0.3 to 1.4ms per MB for
+        both processes on one core, against 0.05 to 0.1ms of a memcpy.
+        If the bus is full the frames are dropped by the policy, and the
+        drops are reported with the next frames of the channel
+        Args:
+            sock_fileno: socket fileno of the agent connection
+            images: list of (data, width, height, rectangle_list, crop_list)
+        """
+        key = self.get_key(sock_fileno)
+        buffers = []
+        for data, _, _, _, crop_list in images:
+            buffers += self._pack(data)
+            for crop in crop_list or []:
+                buffers += self._pack(crop)
+
+        if not self._reserve(sum(len(buf) for buf in buffers)):
+            self._add_dropped(key, len(images))
+            return
+
+        dropped = self.dropped.pop(key, 0)
+        head = self._pack(multiprocessing.reduction.ForkingPickler.dumps(
+            (BUS_IMAGES, key,
+             [(width, height, rectangle_list,
+               None if crop_list is None else len(crop_list))
+              for _, width, height, rectangle_list, crop_list in images],
+             dropped)))
+        self._queue(BusMessage(head + buffers, key, len(images), dropped))
+
+
+class RemoteChannelHandler():
+    """channel handler in a worker, the channel handler in the main process
+    is called through the IPC bus"""
+    def __init__(self, bus, sock_fileno, channel_name, media_type):
+        self.bus = bus
+        self.sock_fileno = sock_fileno
+        self.channel_name = channel_name
+        self.media_type = media_type
+
+    def close(self):
+        """the agent connection is closed, release the channel"""
+        self.bus.close_channel(self.sock_fileno)
+
+    def set_heartbeat(self):
+        """record heartbeat"""
+        self.bus.set_heartbeat(self.sock_fileno)
+
+    def save_image(self, data, width, height, rectangle_list, crop_list=None):
+        """save image receive from socket"""
+        self.bus.save_images(self.sock_fileno,
+                             [(data, width, height, rectangle_list,
+                               crop_list)])
+
+    def save_images(self, images):
+        """save a batch of images receive from socket"""
+        self.bus.save_images(self.sock_fileno,
+                             [(data, width, height, rectangle_list, None)
+                              for data, width, height, rectangle_list
+                              in images])
+
+    def save_rois(self, data, width, height, rectangle_list, crop_list):
+        """save crops of the detected objects receive from socket"""
+        self.save_image(data, width, height, rectangle_list, crop_list)
+
+    def get_media_type(self):
+        """get media_type, support image or video"""
+        return self.media_type
+
+
+def _run_worker(server_class, server_address, worker_index, conn):
+    """entrance of a worker process"""
+    # signals are handled by the main process, which stops the workers
+    signal.signal(signal.SIGINT, signal.SIG_IGN)
+    signal.signal(signal.SIGTERM, signal.SIG_DFL)
+    server = server_class(server_address,
+                          ingest_bus=IngestBus(conn, worker_index))
+    # exit with the main process
+    parent = os.getppid()
+    while os.getppid() == parent:
+        time.sleep(1)
+    server.set_exit_switch()
+
+
+class IngestWorkerPool():
+    """worker processes ingesting agent connections, and the main process
+    side of their IPC buses"""
+    def __init__(self, server_class, server_address, worker_num):
+        """
+        Args:
+            server_class: PresenterSocketServer subclass run by the workers
+            server_address: server listen address, shared by the workers
+            worker_num: number of worker processes
+        """
+        self.channel_manager = ChannelManager([])
+        # channels are opened by the bus threads of all the workers
+        self.open_lock = threading.Lock()
+        self.workers = []
+        for i in range(worker_num):
+            parent_conn, child_conn = multiprocessing.Pipe()
+            worker = multiprocessing.Process(
+                target=_run_worker, name="ingest-worker-{}".format(i),
+                args=(server_class, server_address, i, child_conn),
+                daemon=True)
+            worker.start()
+            child_conn.close()
+            self.workers.append(worker)
+            threading.Thread(target=self._bus_thread, args=(i, parent_conn),
+                             daemon=True).start()
+
+        logging.info("%d ingest workers started", worker_num)
+
+    def _bus_thread(self, worker_index, conn):
+        """serve the IPC bus of a worker until it exits"""
+        keys = set()
+        try:
+            while True:
+                msg = conn.recv()
+                if msg[0] == BUS_IMAGES:
+                    self._save_images(conn, msg[1], msg[2], msg[3])
+                elif msg[0] == BUS_HEARTBEAT:
+                    handler = self.channel_manager.get_channel_handler_by_fd(
+                        msg[1])
+                    if handler is not None:
+                        handler.set_heartbeat()
+                elif msg[0] == BUS_OPEN:
+                    with self.open_lock:
+                        err_code = open_channel(self.channel_manager, msg[2],
+                                                msg[3], msg[1])
+                    if err_code == 0:
+                        keys.add(msg[1])
+                    conn.send(err_code)
+                elif msg[0] == BUS_CLOSE:
+                    keys.discard(msg[1])
+                    self.channel_manager.clean_channel_resource_by_fd(msg[1])
+                else:
+                    logging.error("unknown bus message %s", msg[0])
+        except (EOFError, OSError):
+            logging.error("ingest worker %d exited", worker_index)
+
+        # channels of the worker are released
+        for key in keys:
+            self.channel_manager.clean_channel_resource_by_fd(key)
+
+    def _save_images(self, conn, key, images, dropped):
+        """receive the data of forwarded images, and save them. dropped is
+        the number of frames of the channel dropped by the worker before"""
+        received = []
+        for width, height, rectangle_list, crop_num in images:
+            data = conn.recv_bytes()
+            crop_list = None
+            if crop_num is not None:
+                crop_list = [conn.recv_bytes() for _ in range(crop_num)]
+            received.append((data, width, height, rectangle_list, crop_list))
+
+        # the channel may be deleted by the web page meanwhile
+        handler = self.channel_manager.get_channel_handler_by_fd(key)
+        if handler is None:
+            return
+
+        if dropped:
+            handler.metrics.add_drops(dropped)
+        if len(received) > 1:
+            handler.save_images([image[:4] for image in received])
+        else:
+            handler.save_image(*received[0])
+
+    def stop_thread(self):
+        """stop the channel threads and the workers"""
+        self.channel_manager.close_all_thread()
+        for worker in self.workers:
+            worker.terminate()
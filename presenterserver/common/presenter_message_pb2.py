@@ -52,7 +52,7 @@ DESCRIPTOR = _descriptor.FileDescriptor(
   name='presenter_message.proto',
   package='ascend.presenter.proto',
   syntax='proto3',
-  serialized_pb=_b('\n\x17presenter_message.proto\x12\x16\x61scend.presenter.proto\"l\n\x12OpenChannelRequest\x12\x14\n\x0c\x63hannel_name\x18\x01 \x01(\t\x12@\n\x0c\x63ontent_type\x18\x02 \x01(\x0e\x32*.ascend.presenter.proto.ChannelContentType\"n\n\x13OpenChannelResponse\x12@\n\nerror_code\x18\x01 \x01(\x0e\x32,.ascend.presenter.proto.OpenChannelErrorCode\x12\x15\n\rerror_message\x18\x02 \x01(\t\"\x12\n\x10HeartbeatMessage\"\"\n\nCoordinate\x12\t\n\x01x\x18\x01 \x01(\r\x12\t\n\x01y\x18\x02 \x01(\r\"\x94\x01\n\x0eRectangle_Attr\x12\x34\n\x08left_top\x18\x01 \x01(\x0b\x32\".ascend.presenter.proto.Coordinate\x12\x38\n\x0cright_bottom\x18\x02 \x01(\x0b\x32\".ascend.presenter.proto.Coordinate\x12\x12\n\nlabel_text\x18\x03 \x01(\t\"\xb7\x01\n\x13PresentImageRequest\x12\x33\n\x06\x66ormat\x18\x01 \x01(\x0e\x32#.ascend.presenter.proto.ImageFormat\x12\r\n\x05width\x18\x02 \x01(\r\x12\x0e\n\x06height\x18\x03 \x01(\r\x12\x0c\n\x04\x64\x61ta\x18\x04 \x01(\x0c\x12>\n\x0erectangle_list\x18\x05 \x03(\x0b\x32&.ascend.presenter.proto.Rectangle_Attr\"o\n\x14PresentImageResponse\x12@\n\nerror_code\x18\x01 \x01(\x0e\x32,.ascend.presenter.proto.PresentDataErrorCode\x12\x15\n\rerror_message\x18\x02 \x01(\t*\xa5\x01\n\x14OpenChannelErrorCode\x12\x19\n\x15kOpenChannelErrorNone\x10\x00\x12\"\n\x1ekOpenChannelErrorNoSuchChannel\x10\x01\x12)\n%kOpenChannelErrorChannelAlreadyOpened\x10\x02\x12#\n\x16kOpenChannelErrorOther\x10\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01*P\n\x12\x43hannelContentType\x12\x1c\n\x18kChannelContentTypeImage\x10\x00\x12\x1c\n\x18kChannelContentTypeVideo\x10\x01*#\n\x0bImageFormat\x12\x14\n\x10kImageFormatJpeg\x10\x00*\xa4\x01\n\x14PresentDataErrorCode\x12\x19\n\x15kPresentDataErrorNone\x10\x00\x12$\n kPresentDataErrorUnsupportedType\x10\x01\x12&\n\"kPresentDataErrorUnsupportedFormat\x10\x02\x12#\n\x16kPresentDataErrorOther\x10\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01\x62\x06proto3')
+  serialized_pb=_b('\n\x17presenter_message.proto\x12\x16\x61scend.presenter.proto\"\xaa\x01\n\x12OpenChannelRequest\x12\x14\n\x0c\x63hannel_name\x18\x01 \x01(\t\x12@\n\x0c\x63ontent_type\x18\x02 \x01(\x0e\x32*.ascend.presenter.proto.ChannelContentType\x12<\n\x0b\x63ompression\x18\x03 \x01(\x0e\x32\'.ascend.presenter.proto.CompressionType\"\xac\x01\n\x13OpenChannelResponse\x12@\n\nerror_code\x18\x01 \x01(\x0e\x32,.ascend.presenter.proto.OpenChannelErrorCode\x12\x15\n\rerror_message\x18\x02 \x01(\t\x12<\n\x0b\x63ompression\x18\x03 \x01(\x0e\x32\'.ascend.presenter.proto.CompressionType\"\x12\n\x10HeartbeatMessage\"\"\n\nCoordinate\x12\t\n\x01x\x18\x01 \x01(\r\x12\t\n\x01y\x18\x02 \x01(\r\"\x94\x01\n\x0eRectangle_Attr\x12\x34\n\x08left_top\x18\x01 \x01(\x0b\x32\".ascend.presenter.proto.Coordinate\x12\x38\n\x0cright_bottom\x18\x02 \x01(\x0b\x32\".ascend.presenter.proto.Coordinate\x12\x12\n\nlabel_text\x18\x03 \x01(\t\"\xb7\x01\n\x13PresentImageRequest\x12\x33\n\x06\x66ormat\x18\x01 \x01(\x0e\x32#.ascend.presenter.proto.ImageFormat\x12\r\n\x05width\x18\x02 \x01(\r\x12\x0e\n\x06height\x18\x03 \x01(\r\x12\x0c\n\x04\x64\x61ta\x18\x04 \x01(\x0c\x12>\n\x0erectangle_list\x18\x05 \x03(\x0b\x32&.ascend.presenter.proto.Rectangle_Attr\"o\n\x14PresentImageResponse\x12@\n\nerror_code\x18\x01 \x01(\x0e\x32,.ascend.presenter.proto.PresentDataErrorCode\x12\x15\n\rerror_message\x18\x02 \x01(\t\"n\n\x18PresentImageBatchRequest\x12?\n\nimage_list\x18\x01 \x03(\x0b\x32+.ascend.presenter.proto.PresentImageRequest\x12\x11\n\tdata_list\x18\x02 \x03(\x0c\"\xc8\x01\n\x11PresentRoiRequest\x12\x33\n\x06\x66ormat\x18\x01 \x01(\x0e\x32#.ascend.presenter.proto.ImageFormat\x12\r\n\x05width\x18\x02 \x01(\r\x12\x0e\n\x06height\x18\x03 \x01(\r\x12\x0c\n\x04\x64\x61ta\x18\x04 \x01(\x0c\x12>\n\x0erectangle_list\x18\x05 \x03(\x0b\x32&.ascend.presenter.proto.Rectangle_Attr\x12\x11\n\tdata_list\x18\x06 \x03(\x0c\"\xa0\x01\n\x11PresentImageChunk\x12\x10\n\x08\x66rame_id\x18\x01 \x01(\r\x12\r\n\x05index\x18\x02 \x01(\r\x12\x0c\n\x04last\x18\x03 \x01(\x08\x12\x12\n\ntotal_size\x18\x04 \x01(\r\x12:\n\x05image\x18\x05 \x01(\x0b\x32+.ascend.presenter.proto.PresentImageRequest\x12\x0c\n\x04\x64\x61ta\x18\x06 \x01(\x0c*\xa5\x01\n\x14OpenChannelErrorCode\x12\x19\n\x15kOpenChannelErrorNone\x10\x00\x12\"\n\x1ekOpenChannelErrorNoSuchChannel\x10\x01\x12)\n%kOpenChannelErrorChannelAlreadyOpened\x10\x02\x12#\n\x16kOpenChannelErrorOther\x10\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01*P\n\x12\x43hannelContentType\x12\x1c\n\x18kChannelContentTypeImage\x10\x00\x12\x1c\n\x18kChannelContentTypeVideo\x10\x01*R\n\x0f\x43ompressionType\x12\x14\n\x10kCompressionNone\x10\x00\x12\x13\n\x0fkCompressionLz4\x10\x01\x12\x14\n\x10kCompressionZstd\x10\x02*#\n\x0bImageFormat\x12\x14\n\x10kImageFormatJpeg\x10\x00*\xa4\x01\n\x14PresentDataErrorCode\x12\x19\n\x15kPresentDataErrorNone\x10\x00\x12$\n kPresentDataErrorUnsupportedType\x10\x01\x12&\n\"kPresentDataErrorUnsupportedFormat\x10\x02\x12#\n\x16kPresentDataErrorOther\x10\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01\x62\x06proto3')
 )
 
 _OPENCHANNELERRORCODE = _descriptor.EnumDescriptor(
@@ -80,8 +80,8 @@ _OPENCHANNELERRORCODE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   options=None,
-  serialized_start=780,
-  serialized_end=945,
+  serialized_start=1384,
+  serialized_end=1549,
 )
 _sym_db.RegisterEnumDescriptor(_OPENCHANNELERRORCODE)
 
@@ -103,12 +103,39 @@ _CHANNELCONTENTTYPE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   options=None,
-  serialized_start=947,
-  serialized_end=1027,
+  serialized_start=1551,
+  serialized_end=1631,
 )
 _sym_db.RegisterEnumDescriptor(_CHANNELCONTENTTYPE)
 
 ChannelContentType = enum_type_wrapper.EnumTypeWrapper(_CHANNELCONTENTTYPE)
+_COMPRESSIONTYPE = _descriptor.EnumDescriptor(
+  name='CompressionType',
+  full_name='ascend.presenter.proto.CompressionType',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='kCompressionNone', index=0, number=0,
+      options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='kCompressionLz4', index=1, number=1,
+      options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='kCompressionZstd', index=2, number=2,
+      options=None,
+      type=None),
+  ],
+  containing_type=None,
+  options=None,
+  serialized_start=1633,
+  serialized_end=1715,
+)
+_sym_db.RegisterEnumDescriptor(_COMPRESSIONTYPE)
+
+CompressionType = enum_type_wrapper.EnumTypeWrapper(_COMPRESSIONTYPE)
 _IMAGEFORMAT = _descriptor.EnumDescriptor(
   name='ImageFormat',
   full_name='ascend.presenter.proto.ImageFormat',
@@ -122,8 +149,8 @@ _IMAGEFORMAT = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   options=None,
-  serialized_start=1029,
-  serialized_end=1064,
+  serialized_start=1717,
+  serialized_end=1752,
 )
 _sym_db.RegisterEnumDescriptor(_IMAGEFORMAT)
 
@@ -153,8 +180,8 @@ _PRESENTDATAERRORCODE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   options=None,
-  serialized_start=1067,
-  serialized_end=1231,
+  serialized_start=1755,
+  serialized_end=1919,
 )
 _sym_db.RegisterEnumDescriptor(_PRESENTDATAERRORCODE)
 
@@ -165,6 +192,9 @@ kOpenChannelErrorChannelAlreadyOpened = 2
 kOpenChannelErrorOther = -1
 kChannelContentTypeImage = 0
 kChannelContentTypeVideo = 1
+kCompressionNone = 0
+kCompressionLz4 = 1
+kCompressionZstd = 2
 kImageFormatJpeg = 0
 kPresentDataErrorNone = 0
 kPresentDataErrorUnsupportedType = 1
@@ -194,6 +224,13 @@ _OPENCHANNELREQUEST = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='compression', full_name='ascend.presenter.proto.OpenChannelRequest.compression', index=2,
+      number=3, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -206,8 +243,8 @@ _OPENCHANNELREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=51,
-  serialized_end=159,
+  serialized_start=52,
+  serialized_end=222,
 )
 
 
@@ -232,6 +269,13 @@ _OPENCHANNELRESPONSE = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='compression', full_name='ascend.presenter.proto.OpenChannelResponse.compression', index=2,
+      number=3, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -244,8 +288,8 @@ _OPENCHANNELRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=161,
-  serialized_end=271,
+  serialized_start=225,
+  serialized_end=397,
 )
 
 
@@ -268,8 +312,8 @@ _HEARTBEATMESSAGE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=273,
-  serialized_end=291,
+  serialized_start=399,
+  serialized_end=417,
 )
 
 
@@ -306,8 +350,8 @@ _COORDINATE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=293,
-  serialized_end=327,
+  serialized_start=419,
+  serialized_end=453,
 )
 
 
@@ -351,8 +395,8 @@ _RECTANGLE_ATTR = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=330,
-  serialized_end=478,
+  serialized_start=456,
+  serialized_end=604,
 )
 
 
@@ -410,8 +454,8 @@ _PRESENTIMAGEREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=481,
-  serialized_end=664,
+  serialized_start=607,
+  serialized_end=790,
 )
 
 
@@ -448,17 +492,193 @@ _PRESENTIMAGERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=666,
-  serialized_end=777,
+  serialized_start=792,
+  serialized_end=903,
+)
+
+
+_PRESENTIMAGEBATCHREQUEST = _descriptor.Descriptor(
+  name='PresentImageBatchRequest',
+  full_name='ascend.presenter.proto.PresentImageBatchRequest',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='image_list', full_name='ascend.presenter.proto.PresentImageBatchRequest.image_list', index=0,
+      number=1, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='data_list', full_name='ascend.presenter.proto.PresentImageBatchRequest.data_list', index=1,
+      number=2, type=12, cpp_type=9, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=905,
+  serialized_end=1015,
+)
+
+
+_PRESENTROIREQUEST = _descriptor.Descriptor(
+  name='PresentRoiRequest',
+  full_name='ascend.presenter.proto.PresentRoiRequest',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='format', full_name='ascend.presenter.proto.PresentRoiRequest.format', index=0,
+      number=1, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='width', full_name='ascend.presenter.proto.PresentRoiRequest.width', index=1,
+      number=2, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='height', full_name='ascend.presenter.proto.PresentRoiRequest.height', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='data', full_name='ascend.presenter.proto.PresentRoiRequest.data', index=3,
+      number=4, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='rectangle_list', full_name='ascend.presenter.proto.PresentRoiRequest.rectangle_list', index=4,
+      number=5, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='data_list', full_name='ascend.presenter.proto.PresentRoiRequest.data_list', index=5,
+      number=6, type=12, cpp_type=9, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=1018,
+  serialized_end=1218,
+)
+
+
+_PRESENTIMAGECHUNK = _descriptor.Descriptor(
+  name='PresentImageChunk',
+  full_name='ascend.presenter.proto.PresentImageChunk',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='frame_id', full_name='ascend.presenter.proto.PresentImageChunk.frame_id', index=0,
+      number=1, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='index', full_name='ascend.presenter.proto.PresentImageChunk.index', index=1,
+      number=2, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='last', full_name='ascend.presenter.proto.PresentImageChunk.last', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='total_size', full_name='ascend.presenter.proto.PresentImageChunk.total_size', index=3,
+      number=4, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='image', full_name='ascend.presenter.proto.PresentImageChunk.image', index=4,
+      number=5, type=11, cpp_type=10, label=1,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='data', full_name='ascend.presenter.proto.PresentImageChunk.data', index=5,
+      number=6, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=1221,
+  serialized_end=1381,
 )
 
 _OPENCHANNELREQUEST.fields_by_name['content_type'].enum_type = _CHANNELCONTENTTYPE
+_OPENCHANNELREQUEST.fields_by_name['compression'].enum_type = _COMPRESSIONTYPE
 _OPENCHANNELRESPONSE.fields_by_name['error_code'].enum_type = _OPENCHANNELERRORCODE
+_OPENCHANNELRESPONSE.fields_by_name['compression'].enum_type = _COMPRESSIONTYPE
 _RECTANGLE_ATTR.fields_by_name['left_top'].message_type = _COORDINATE
 _RECTANGLE_ATTR.fields_by_name['right_bottom'].message_type = _COORDINATE
 _PRESENTIMAGEREQUEST.fields_by_name['format'].enum_type = _IMAGEFORMAT
 _PRESENTIMAGEREQUEST.fields_by_name['rectangle_list'].message_type = _RECTANGLE_ATTR
 _PRESENTIMAGERESPONSE.fields_by_name['error_code'].enum_type = _PRESENTDATAERRORCODE
+_PRESENTIMAGEBATCHREQUEST.fields_by_name['image_list'].message_type = _PRESENTIMAGEREQUEST
+_PRESENTROIREQUEST.fields_by_name['format'].enum_type = _IMAGEFORMAT
+_PRESENTROIREQUEST.fields_by_name['rectangle_list'].message_type = _RECTANGLE_ATTR
+_PRESENTIMAGECHUNK.fields_by_name['image'].message_type = _PRESENTIMAGEREQUEST
 DESCRIPTOR.message_types_by_name['OpenChannelRequest'] = _OPENCHANNELREQUEST
 DESCRIPTOR.message_types_by_name['OpenChannelResponse'] = _OPENCHANNELRESPONSE
 DESCRIPTOR.message_types_by_name['HeartbeatMessage'] = _HEARTBEATMESSAGE
@@ -466,8 +686,12 @@ DESCRIPTOR.message_types_by_name['Coordinate'] = _COORDINATE
 DESCRIPTOR.message_types_by_name['Rectangle_Attr'] = _RECTANGLE_ATTR
 DESCRIPTOR.message_types_by_name['PresentImageRequest'] = _PRESENTIMAGEREQUEST
 DESCRIPTOR.message_types_by_name['PresentImageResponse'] = _PRESENTIMAGERESPONSE
+DESCRIPTOR.message_types_by_name['PresentImageBatchRequest'] = _PRESENTIMAGEBATCHREQUEST
+DESCRIPTOR.message_types_by_name['PresentRoiRequest'] = _PRESENTROIREQUEST
+DESCRIPTOR.message_types_by_name['PresentImageChunk'] = _PRESENTIMAGECHUNK
 DESCRIPTOR.enum_types_by_name['OpenChannelErrorCode'] = _OPENCHANNELERRORCODE
 DESCRIPTOR.enum_types_by_name['ChannelContentType'] = _CHANNELCONTENTTYPE
+DESCRIPTOR.enum_types_by_name['CompressionType'] = _COMPRESSIONTYPE
 DESCRIPTOR.enum_types_by_name['ImageFormat'] = _IMAGEFORMAT
 DESCRIPTOR.enum_types_by_name['PresentDataErrorCode'] = _PRESENTDATAERRORCODE
 _sym_db.RegisterFileDescriptor(DESCRIPTOR)
@@ -521,5 +745,26 @@ PresentImageResponse = _reflection.GeneratedProtocolMessageType('PresentImageRes
   ))
 _sym_db.RegisterMessage(PresentImageResponse)
 
+PresentImageBatchRequest = _reflection.GeneratedProtocolMessageType('PresentImageBatchRequest', (_message.Message,), dict(
+  DESCRIPTOR = _PRESENTIMAGEBATCHREQUEST,
+  __module__ = 'presenter_message_pb2'
+  # @@protoc_insertion_point(class_scope:ascend.presenter.proto.PresentImageBatchRequest)
+  ))
+_sym_db.RegisterMessage(PresentImageBatchRequest)
+
+PresentRoiRequest = _reflection.GeneratedProtocolMessageType('PresentRoiRequest', (_message.Message,), dict(
+  DESCRIPTOR = _PRESENTROIREQUEST,
+  __module__ = 'presenter_message_pb2'
+  # @@protoc_insertion_point(class_scope:ascend.presenter.proto.PresentRoiRequest)
+  ))
+_sym_db.RegisterMessage(PresentRoiRequest)
+
+PresentImageChunk = _reflection.GeneratedProtocolMessageType('PresentImageChunk', (_message.Message,), dict(
+  DESCRIPTOR = _PRESENTIMAGECHUNK,
+  __module__ = 'presenter_message_pb2'
+  # @@protoc_insertion_point(class_scope:ascend.presenter.proto.PresentImageChunk)
+  ))
+_sym_db.RegisterMessage(PresentImageChunk)
+
 
 # @@protoc_insertion_point(module_scope)
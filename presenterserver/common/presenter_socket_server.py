@@ -41,6 +41,17 @@ import common.presenter_message_pb2 as pb2
 from common.channel_manager import ChannelManager
 from common.channel_handler import ChannelHandler
 
+# compression of message fields is optional, accepted if the module exists
+try:
+    import lz4.block
+except ImportError:
+    lz4 = None
+
+try:
+    import zstandard
+except ImportError:
+    zstandard = None
+
 #read nothing from socket.recv()
 SOCK_RECV_NULL = b''
 
@@ -49,23 +60,385 @@ EPOLL_TIMEOUT = 1
 
 # it specifies the number of unaccepted connections that
 # the system will allow before refusing new connections.
-SOCKET_WAIT_QUEUE = 2
+SOCKET_WAIT_QUEUE = 128
 
 # message head length, include 4 bytes message total length
 # and 1 byte message name length
 MSG_HEAD_LENGTH = 5
 
+# message head: 4 bytes message total length in network byte order
+# and 1 byte message name length
+MSG_HEAD = struct.Struct('!IB')
+
+# buffer of a connection for message heads and small messages, a larger
+# message is received into a buffer of its own
+RECV_BUFFER_SIZE = 256 * 1024
+
+# max bytes read from a connection per epoll event, other connections are
+# served before the rest of a large message is read
+MAX_READ_PER_EVENT = 4 * 1024 * 1024
+
+# max length of a message, agent sends images larger than 8MB in chunks
+MAX_MSG_LENGTH = 16 * 1024 * 1024
+
+# max bytes queued for a connection which is not writable, an agent not
+# reading its responses is disconnected beyond it
+MAX_UNSENT_BYTES = 1024 * 1024
+
+# events of an agent connection, and of one with bytes unsent
+CONN_EVENTS = select.EPOLLIN | select.EPOLLHUP
+CONN_EVENTS_UNSENT = CONN_EVENTS | select.EPOLLOUT
+
+# set in message name length if the fields of the message are compressed
+MSG_COMPRESSED_FLAG = 0x80
+
+# compression head of a compressed message: 1 byte compression type,
+# 4 bytes original size and 4 bytes compressed size
+COMPRESSION_HEAD = struct.Struct('!BII')
+
+# max size of the decompressed fields, same as the max message size
+MAX_DECOMPRESSED_SIZE = 10 * 1024 * 1024
+
+
+def get_supported_compressions():
+    '''compression types supported by the installed modules'''
+    supported = []
+    if lz4 is not None:
+        supported.append(pb2.kCompressionLz4)
+    if zstandard is not None:
+        supported.append(pb2.kCompressionZstd)
+    return supported
+
+
+def decompress_msg_body(msg_body):
+    '''
+    Args:
+        msg_body: body of a compressed message, the compression head and
+                  the compressed fields, followed by the raw TLVs
+    Returns:
+        the body with the fields decompressed, None if it is invalid
+    '''
+    if len(msg_body) < COMPRESSION_HEAD.size:
+        logging.error("compressed msg body too short: %u", len(msg_body))
+        return None
+
+    comp_type, orig_size, comp_size = COMPRESSION_HEAD.unpack_from(msg_body)
+    fields_end = COMPRESSION_HEAD.size + comp_size
+    if fields_end > len(msg_body) or orig_size > MAX_DECOMPRESSED_SIZE:
+        logging.error("invalid compression head, orig %u, compressed %u",
+                      orig_size, comp_size)
+        return None
+
+    data = memoryview(msg_body)[COMPRESSION_HEAD.size:fields_end]
+    try:
+        if comp_type == pb2.kCompressionLz4 and lz4 is not None:
+            fields = lz4.block.decompress(data, uncompressed_size=orig_size)
+        elif comp_type == pb2.kCompressionZstd and zstandard is not None:
+            fields = zstandard.ZstdDecompressor().decompress(
+                data, max_output_size=orig_size)
+        else:
+            logging.error("unsupported compression type %u", comp_type)
+            return None
+    except Exception as exp:
+        logging.error("decompress failed: %s", exp)
+        return None
+
+    if len(fields) != orig_size:
+        logging.error("decompressed size %u, expect %u", len(fields),
+                      orig_size)
+        return None
+
+    return fields + memoryview(msg_body)[fields_end:]
+
+
+def _read_varint(data, pos):
+    '''
+    Args:
+        data: memoryview of a serialized protobuf message
+        pos: position of the varint
+    Returns:
+        value: value of the varint
+        pos: position after the varint
+    '''
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise DecodeError("Truncated message.")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+        if shift >= 64:
+            raise DecodeError("Too many bytes when decoding varint.")
+
+
+def parse_message(message, msg_data, bytes_fields=()):
+    '''
+    Parse a message, the data of its top level bytes fields in bytes_fields
+    is sliced out of msg_data instead of being copied by protobuf
+    Args:
+        message: protobuf message to parse into
+        msg_data: serialized message, bytes-like
+        bytes_fields: field numbers of the bytes fields to slice out
+    Returns:
+        dict of field number -> list of memoryview, in message order
+    Raises:
+        DecodeError: msg_data is invalid
+    '''
+    view = memoryview(msg_data)
+    fields = {number: [] for number in bytes_fields}
+    others = []
+    others_start = 0
+    pos = 0
+    while pos < len(view):
+        field_start = pos
+        tag, pos = _read_varint(view, pos)
+        wire_type = tag & 0x7
+        if wire_type == 0:
+            _, pos = _read_varint(view, pos)
+        elif wire_type == 1:
+            pos += 8
+        elif wire_type == 2:
+            length, pos = _read_varint(view, pos)
+            if tag >> 3 in fields and pos + length <= len(view):
+                fields[tag >> 3].append(view[pos:pos + length])
+                others.append(view[others_start:field_start])
+                others_start = pos + length
+            pos += length
+        elif wire_type == 5:
+            pos += 4
+        else:
+            raise DecodeError("Unsupported wire type %u." % wire_type)
+
+    if pos > len(view):
+        raise DecodeError("Truncated message.")
+
+    # the other fields are small, parsed by protobuf as usual
+    others.append(view[others_start:])
+    message.ParseFromString(b''.join(others))
+    return fields
+
+class MessageReader():
+    """reassemble the messages of a non-blocking connection.
+
+    Message heads and small messages are received into a buffer reused by
+    the connection. The body of a large message is received into a buffer
+    of its own with recv_into(), so the image data is never copied. A
+    message is returned once all of its bytes come, so the epoll thread
+    never waits for a slow agent.
+    """
+    def __init__(self, conn):
+        """
+        Args:
+            conn: a non-blocking socket connection
+        """
+        self.conn = conn
+        self.buf = bytearray(RECV_BUFFER_SIZE)
+        self.view = memoryview(self.buf)
+        # received but not parsed bytes are buf[start:end]
+        self.start = 0
+        self.end = 0
+        # the large message being received: (msg_name, compressed), its
+        # body and the bytes of the body received
+        self.large_msg = None
+        self.large_body = None
+        self.large_received = 0
+
+    def read(self):
+        '''
+        Read the available bytes and parse the complete messages
+        Returns:
+            ret: False if the connection is closed or a message is invalid
+            msgs: list of (msg_name, msg_body) of the complete messages
+        '''
+        msgs = []
+        read_len = 0
+        while read_len < MAX_READ_PER_EVENT:
+            if self.large_body is not None:
+                target = memoryview(self.large_body)[self.large_received:]
+            else:
+                self._compact()
+                target = self.view[self.end:]
+
+            try:
+                recv_len = self.conn.recv_into(target)
+            except (BlockingIOError, InterruptedError):
+                break
+            except socket.error:
+                logging.error("socket %u exception:socket.error",
+                              self.conn.fileno())
+                return False, msgs
+
+            if recv_len == 0:
+                logging.info("socket %u closed by peer", self.conn.fileno())
+                return False, msgs
+
+            read_len += recv_len
+            if self.large_body is not None:
+                self.large_received += recv_len
+            else:
+                self.end += recv_len
+
+            if not self._parse(msgs):
+                return False, msgs
+
+            # nothing more to read for now
+            if recv_len < len(target):
+                break
+
+        return True, msgs
+
+    def _compact(self):
+        '''move the unparsed bytes to the head of the buffer if it is full'''
+        if self.end < len(self.buf) or self.start == 0:
+            return
+
+        remaining = self.end - self.start
+        self.buf[:remaining] = self.view[self.start:self.end]
+        self.start = 0
+        self.end = remaining
+
+    def _parse(self, msgs):
+        '''
+        Parse the complete messages, the bytes of an incomplete message are
+        kept for the next read
+        Args:
+            msgs: complete messages are appended as (msg_name, msg_body)
+        Returns:
+            False if a message is invalid
+        '''
+        if self.large_body is not None:
+            if self.large_received < len(self.large_body):
+                return True
+
+            msg_name, compressed = self.large_msg
+            body = self.large_body
+            self.large_msg = None
+            self.large_body = None
+            if not self._append_msg(msgs, msg_name, compressed, body):
+                return False
+
+        while self.end - self.start >= MSG_HEAD_LENGTH:
+            msg_total_len, msg_name_len = MSG_HEAD.unpack_from(self.buf,
+                                                              self.start)
+            compressed = (msg_name_len & MSG_COMPRESSED_FLAG) != 0
+            msg_name_len &= ~MSG_COMPRESSED_FLAG
+            if msg_total_len < MSG_HEAD_LENGTH + msg_name_len or \
+               msg_total_len > MAX_MSG_LENGTH:
+                logging.error("msg_total_len:%u, msg_name_len:%u is invalid",
+                              msg_total_len, msg_name_len)
+                return False
+
+            name_start = self.start + MSG_HEAD_LENGTH
+            name_end = name_start + msg_name_len
+            if name_end > self.end:
+                break
+
+            try:
+                msg_name = str(self.view[name_start:name_end], "utf-8")
+            except UnicodeDecodeError:
+                logging.error("msg name decode to utf-8 error")
+                return False
+
+            msg_end = self.start + msg_total_len
+            if msg_total_len > len(self.buf):
+                # the received part of the body is copied, the rest is
+                # received into the body directly
+                received = self.end - name_end
+                self.large_msg = (msg_name, compressed)
+                self.large_body = bytearray(msg_end - name_end)
+                self.large_body[:received] = self.view[name_end:self.end]
+                self.large_received = received
+                self.start = self.end = 0
+                return True
+
+            if msg_end > self.end:
+                break
+
+            msg_body = bytes(self.view[name_end:msg_end])
+            self.start = msg_end
+            if not self._append_msg(msgs, msg_name, compressed, msg_body):
+                return False
+
+        if self.start == self.end:
+            self.start = self.end = 0
+        return True
+
+    @staticmethod
+    def _append_msg(msgs, msg_name, compressed, msg_body):
+        '''append a complete message, decompressed if necessary'''
+        if compressed:
+            msg_body = decompress_msg_body(msg_body)
+            if msg_body is None:
+                return False
+
+        msgs.append((msg_name, msg_body))
+        return True
+
+
+def open_channel(channel_manager, channel_name, media_type, sock_fileno):
+    '''
+    Open a channel for an agent connection
+    Args:
+        channel_manager: ChannelManager owning the channels
+        channel_name: channel name
+        media_type: image or video
+        sock_fileno: socket fileno of the agent connection
+    Returns:
+        OpenChannelErrorCode
+    '''
+    # check channel name if exist 如果通道不存在,则创建
+    if not channel_manager.is_channel_exist(channel_name):
+        logging.error("channel name %s is not exist.", channel_name)
+        # if channel is not exist, need to create the channel
+        ret = channel_manager.register_one_channel(channel_name)
+        if ret != ChannelManager.err_code_ok:
+            #如果创建失败,给agent发回应,回应中错误码为pb2.kOpenChannelErrorOther
+            logging.error("Create the channel %s failed!, and ret is %d",
+                          channel_name, ret)
+            return pb2.kOpenChannelErrorOther
+
+    # check channel path if busy 如果通道处于busy状态,给agent发回应,回应中错误码为pb2.kOpenChannelErrorChannelAlreadyOpened
+    if channel_manager.is_channel_busy(channel_name):
+        logging.error("channel path %s is busy.", channel_name)
+        return pb2.kOpenChannelErrorChannelAlreadyOpened
+
+    # if channel type is image, need clean image if exist
+    channel_manager.clean_channel_image(channel_name)
+
+    handler = ChannelHandler(channel_name, media_type)
+    channel_manager.create_channel_resource(
+        channel_name, sock_fileno, media_type, handler)
+    return pb2.kOpenChannelErrorNone
+
+
 #presenter server的socket服务端
 class PresenterSocketServer():
     """a socket server communication with presenter agent.
 
     """
-    def __init__(self, server_address):
+    def __init__(self, server_address, ingest_bus=None):
         """
         Args:
             server_address: server listen address,
                             include an ipv4 address and a port.
+            ingest_bus: IngestBus of an ingest worker process, channels are
+                        opened in the main process through it. None if the
+                        server runs in the main process
         """
+        self.ingest_bus = ingest_bus
+
+        # epoll of the listen thread, and the bytes not sent yet of each
+        # socket fileno, only used in the listen thread
+        self.epoll = None
+        self.unsent = {}
+        # sockets not read until the ingest bus is flushed, and the events
+        # the ingest bus is registered with, only used in the listen thread
+        self.paused = set()
+        self.bus_events = 0
 
         # thread exit switch, if set true, thread must exit immediately.
         self.thread_exit_switch = False
@@ -87,6 +460,11 @@ class PresenterSocketServer():
         # Create a socket server.
         self._sock_server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
         self._sock_server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        # ingest workers listen on the same port, the kernel balances the
+        # agent connections between them
+        if self.ingest_bus is not None:
+            self._sock_server.setsockopt(socket.SOL_SOCKET,
+                                         socket.SO_REUSEPORT, 1)
         self._sock_server.bind(server_address)
         self._sock_server.listen(SOCKET_WAIT_QUEUE)
         self._sock_server.setblocking(False)
@@ -104,155 +482,111 @@ class PresenterSocketServer():
         """set switch True to stop presenter socket server thread."""
         self.thread_exit_switch = True
 
-    def _read_socket(self, conn, read_len):
-        '''
-        Read fixed length data
-        Args:
-            conn: a socket connection
-            read_len: read fix byte.
-        Returns:
-            ret: True or False
-            buf: read fix byte buf.
-        '''
-        has_read_len = 0
-        read_buf = SOCK_RECV_NULL
-        total_buf = SOCK_RECV_NULL
-        while has_read_len != read_len:
-            try:
-                read_buf = conn.recv(read_len - has_read_len)
-            except socket.error:
-                logging.error("socket %u exception:socket.error", conn.fileno())
-                return False, None
-            if read_buf == SOCK_RECV_NULL:
-                return False, None
-            total_buf += read_buf
-            has_read_len = len(total_buf)
-
-        return True, total_buf
-
-    def _read_msg_head(self, sock_fileno, conns):
-        '''
-        Args:
-            sock_fileno: a socket fileno
-            conns: all socket connections which created by server.
-        Returns:
-            msg_total_len: total message length.
-            msg_name_len: message name length.
-        '''
-        ret, msg_head = self._read_socket(conns[sock_fileno], self.msg_head_len)
-        if not ret:
-            logging.error("socket %u receive msg head null", sock_fileno)
-            return None, None
-
-        # in Struct(), 'I' is unsigned int, 'B' is unsigned char
-        msg_head_data = struct.Struct('IB')
-        (msg_total_len, msg_name_len) = msg_head_data.unpack(msg_head)
-        msg_total_len = socket.ntohl(msg_total_len)
-
-        return msg_total_len, msg_name_len
-
-    def _read_msg_name(self, sock_fd, conns, msg_name_len):
+    def _process_epollin(self, sock_fileno, epoll, conns, readers):
         '''
         Args:
-            sock_fd: a socket fileno
-            conns: all socket connections which created by server.
-            msg_name_len: message name length.
-        Returns:
-            ret: True or False
-            msg_name: message name.
+            sock_fileno: a socket fileno, return value of socket.fileno()
+            epoll: a set of select.epoll.
+            conns: all socket connections registered in epoll
+            readers: MessageReader of each socket connection
         '''
-        ret, msg_name = self._read_socket(conns[sock_fd], msg_name_len)
-        if not ret:
-            logging.error("socket %u receive msg name null", sock_fd)
-            return False, None
+        ret, msgs = readers[sock_fileno].read()
         try:
-            msg_name = msg_name.decode("utf-8")
-        except UnicodeDecodeError:
-            logging.error("msg name decode to utf-8 error")
-            return False, None
-
-        return True, msg_name
+            for msg_name, msg_body in msgs:
+                if not self._process_msg(conns[sock_fileno], msg_name,
+                                         msg_body):
+                    ret = False
+                    break
+        except socket.error:
+            logging.error("send socket error.")
+            ret = False
 
-    def _read_msg_body(self, sock_fd, conns, msg_body_len, msgs):
-        '''
-        Args:
-            sock_fd: a socket fileno
-            conns: all socket connections which created by server.
-            msg_name_len: message name length.
-            msgs: msg read from a socket
-        Returns:
-            ret: True or False
-        '''
-        ret, msg_body = self._read_socket(conns[sock_fd], msg_body_len)
         if not ret:
-            logging.error("socket %u receive msg body null", sock_fd)
-            return False
-        msgs[sock_fd] = msg_body
-        return True
-
-    def _read_sock_and_process_msg(self, sock_fileno, conns, msgs):
+            self._close_connect(sock_fileno, epoll, conns, readers)
+        elif self.ingest_bus is not None and self.ingest_bus.is_blocked():
+            # the agent waits for the frames received to be forwarded
+            self.paused.add(sock_fileno)
+            epoll.modify(sock_fileno, self._get_conn_events(sock_fileno))
+
+    def _get_conn_events(self, sock_fileno):
+        '''events a connection is registered with'''
+        events = CONN_EVENTS
+        if sock_fileno in self.paused:
+            events &= ~select.EPOLLIN
+        if sock_fileno in self.unsent:
+            events |= select.EPOLLOUT
+        return events
+
+    def _update_bus_events(self, epoll):
         '''
+        Wait for the ingest bus to be writable while messages are queued,
+        and resume the connections paused once it is not full
         Args:
-            sock_fileno: a socket fileno, return value of socket.fileno()
-            conns: all socket connections registered in epoll
-            msgs: msg read from a socket
-        Returns:
-            ret: True or False
+            epoll: a set of select.epoll.
         '''
-
-        # Step1: read msg head
-        msg_total_len, msg_name_len = self._read_msg_head(sock_fileno, conns)
-        if msg_total_len is None:
-            logging.error("msg_total_len is None.")
-            return False
-
-        # Step2: read msg name
-        ret, msg_name = self._read_msg_name(sock_fileno, conns, msg_name_len)
-        if not ret:
-            return ret
-
-        # Step3:  read msg body
-        msg_body_len = msg_total_len - self.msg_head_len - msg_name_len
-        if msg_body_len < 0:
-            logging.error("msg_total_len:%u, msg_name_len:%u, msg_body_len:%u",
-                          msg_total_len, msg_name_len, msg_body_len)
-            return False
-        ret = self._read_msg_body(sock_fileno, conns, msg_body_len, msgs)
-        if not ret:
-            return ret
-
-        # Step4: process msg
-        ret = self._process_msg(conns[sock_fileno], msg_name, msgs[sock_fileno])
-        return ret
-
-    def _process_epollin(self, sock_fileno, epoll, conns, msgs):
+        # unregistered once the main process exits
+        if self.bus_events:
+            events = select.EPOLLIN
+            if self.ingest_bus.has_unsent():
+                events |= select.EPOLLOUT
+            if events != self.bus_events:
+                epoll.modify(self.ingest_bus.fileno(), events)
+                self.bus_events = events
+
+        if self.paused and not self.ingest_bus.is_blocked():
+            paused = self.paused
+            self.paused = set()
+            for sock_fileno in paused:
+                epoll.modify(sock_fileno, self._get_conn_events(sock_fileno))
+
+    def _process_epollout(self, sock_fileno, epoll, conns, readers):
         '''
+        Send the bytes queued for a connection which becomes writable
         Args:
             sock_fileno: a socket fileno, return value of socket.fileno()
             epoll: a set of select.epoll.
             conns: all socket connections registered in epoll
-            msgs: msg read from a socket
+            readers: MessageReader of each socket connection
         '''
-        msgs[sock_fileno] = b''
+        unsent = self.unsent[sock_fileno]
         try:
-            ret = self._read_sock_and_process_msg(sock_fileno, conns, msgs)
-            if not ret:
-                self._clean_connect(sock_fileno, epoll, conns, msgs)
+            sent = conns[sock_fileno].send(unsent)
+        except (BlockingIOError, InterruptedError):
+            return
         except socket.error:
-            logging.error("receive socket error.")
-            self._clean_connect(sock_fileno, epoll, conns, msgs)
+            logging.error("send socket error.")
+            self._close_connect(sock_fileno, epoll, conns, readers)
+            return
+
+        del unsent[:sent]
+        if not unsent:
+            del self.unsent[sock_fileno]
+            epoll.modify(sock_fileno, self._get_conn_events(sock_fileno))
+
+    def _close_connect(self, sock_fileno, epoll, conns, readers):
+        '''
+        Drop the bytes unsent, and close the connection by _clean_connect()
+        of the subclass
+        '''
+        self.unsent.pop(sock_fileno, None)
+        self.paused.discard(sock_fileno)
+        self._clean_connect(sock_fileno, epoll, conns, readers)
 
-    def _accept_new_socket(self, epoll, conns):
+    def _accept_new_socket(self, epoll, conns, readers):
         '''
         Args:
             epoll: a set of select.epoll.
             conns: all socket connections registered in epoll
+            readers: MessageReader of each socket connection
         '''
         try:
             new_conn, address = self._sock_server.accept()
-            new_conn.setblocking(True)
-            epoll.register(new_conn.fileno(), select.EPOLLIN | select.EPOLLHUP)
+            # never block the epoll thread, messages are reassembled by
+            # MessageReader
+            new_conn.setblocking(False)
+            epoll.register(new_conn.fileno(), CONN_EVENTS)
             conns[new_conn.fileno()] = new_conn
+            readers[new_conn.fileno()] = MessageReader(new_conn)
             logging.info("create new connection:client-ip:%s, client-port:%s, fd:%s",
                          address[0], address[1], new_conn.fileno())
         except socket.error:
@@ -261,10 +595,14 @@ class PresenterSocketServer():
     def _server_listen_thread(self):
         """socket server thread, epoll listening all the socket events"""
         epoll = select.epoll()
+        self.epoll = epoll
         epoll.register(self._sock_server.fileno(), select.EPOLLIN | select.EPOLLHUP)
+        if self.ingest_bus is not None:
+            self.bus_events = select.EPOLLIN
+            epoll.register(self.ingest_bus.fileno(), self.bus_events)
         try:
             conns = {}
-            msgs = {}
+            readers = {}
             while True:
                 # thread must exit immediately
                 if self.thread_exit_switch:
@@ -278,20 +616,44 @@ class PresenterSocketServer():
                 for sock_fileno, event in events:
                     # new connection request from presenter agent
                     if self._sock_server.fileno() == sock_fileno:
-                        self._accept_new_socket(epoll, conns)
+                        self._accept_new_socket(epoll, conns, readers)
+
+                    # replies of the main process to an ingest worker, or
+                    # the bus is writable
+                    elif self.ingest_bus is not None and \
+                         self.ingest_bus.fileno() == sock_fileno:
+                        if event & select.EPOLLOUT:
+                            self.ingest_bus.flush()
+                        if event & (select.EPOLLIN | select.EPOLLHUP):
+                            self._process_bus_replies(epoll, conns, readers)
+
+                    # closed while processing the events before
+                    elif sock_fileno not in conns:
+                        continue
 
                     # remote connection closed
                     # it means presenter agent exit withot close socket.
                     elif event & select.EPOLLHUP:
                         logging.info("receive event EPOLLHUP")
-                        self._clean_connect(sock_fileno, epoll, conns, msgs)
-                    # new data coming in a socket connection
-                    elif event & select.EPOLLIN:
-                        self._process_epollin(sock_fileno, epoll, conns, msgs)
+                        self._close_connect(sock_fileno, epoll, conns,
+                                            readers)
+                    # new data coming in a socket connection, or queued
+                    # bytes can be sent
+                    elif event & CONN_EVENTS_UNSENT:
+                        if event & select.EPOLLOUT:
+                            self._process_epollout(sock_fileno, epoll, conns,
+                                                   readers)
+                        if event & select.EPOLLIN and sock_fileno in conns:
+                            self._process_epollin(sock_fileno, epoll, conns,
+                                                  readers)
                     # receive event not recognize
                     else:
                         logging.error("not recognize event %f", event)
-                        self._clean_connect(sock_fileno, epoll, conns, msgs)
+                        self._close_connect(sock_fileno, epoll, conns,
+                                            readers)
+
+                if self.ingest_bus is not None:
+                    self._update_bus_events(epoll)
 
         finally:
             logging.info("conns:%s", conns)
@@ -353,26 +715,6 @@ class PresenterSocketServer():
         #获取通道名称
         channel_name = request.channel_name
 
-        # check channel name if exist 如果通道不存在,则创建
-        if not self.channel_manager.is_channel_exist(channel_name):
-            logging.error("channel name %s is not exist.", channel_name)
-            # if channel is not exist, need to create the channel
-            ret = self.channel_manager.register_one_channel(channel_name)
-            if ret != ChannelManager.err_code_ok:
-                #如果创建失败,给agent发回应,回应中错误码为pb2.kOpenChannelErrorOther
-                logging.error("Create the channel %s failed!, and ret is %d", channel_name, ret)
-                err_code =  pb2.kOpenChannelErrorOther
-                self._response_open_channel(conn, channel_name, response, err_code)
-
-        # check channel path if busy 如果通道处于busy状态,给agent发回应,回应中错误码为pb2.kOpenChannelErrorChannelAlreadyOpened
-        if self.channel_manager.is_channel_busy(channel_name):
-            logging.error("channel path %s is busy.", channel_name)
-            err_code = pb2.kOpenChannelErrorChannelAlreadyOpened
-            return self._response_open_channel(conn, channel_name, response,
-                                               err_code)
-
-        # if channel type is image, need clean image if exist
-        self.channel_manager.clean_channel_image(channel_name)
         #检查channel类型是image还是video
         if request.content_type == pb2.kChannelContentTypeImage:
             media_type = "image"
@@ -385,12 +727,51 @@ class PresenterSocketServer():
             return self._response_open_channel(conn, channel_name, response,
                                                pb2.kOpenChannelErrorOther)
 
-        handler = ChannelHandler(channel_name, media_type)
-        self.channel_manager.create_channel_resource(
-            channel_name, conn.fileno(), media_type, handler)
+        # the agent compresses the fields of the messages if accepted
+        if request.compression in get_supported_compressions():
+            response.compression = request.compression
+        else:
+            response.compression = pb2.kCompressionNone
+
+        def reply(err_code):
+            if err_code != pb2.kOpenChannelErrorNone:
+                response.compression = pb2.kCompressionNone
+            try:
+                return self._response_open_channel(conn, channel_name,
+                                                   response, err_code)
+            except socket.error:
+                logging.error("send socket error.")
+                return False
+
+        # an ingest worker opens the channel in the main process, and
+        # replies once the result comes back over the bus. The agent sends
+        # nothing else before the reply
+        if self.ingest_bus is not None:
+            self.ingest_bus.open_channel(self.channel_manager, channel_name,
+                                         media_type, conn, reply)
+            return True
+
+        return reply(open_channel(self.channel_manager, channel_name,
+                                  media_type, conn.fileno()))
+
+    def _process_bus_replies(self, epoll, conns, readers):
+        '''
+        Reply the open channel requests answered by the main process
+        Args:
+            epoll: a set of select.epoll.
+            conns: all socket connections registered in epoll
+            readers: MessageReader of each socket connection
+        '''
+        ret, failed = self.ingest_bus.process_replies()
+        for conn in failed:
+            sock_fileno = conn.fileno()
+            if conns.get(sock_fileno) is conn:
+                self._close_connect(sock_fileno, epoll, conns, readers)
+
+        if not ret:
+            epoll.unregister(self.ingest_bus.fileno())
+            self.bus_events = 0
 
-        return self._response_open_channel(conn, channel_name, response,
-                                           pb2.kOpenChannelErrorNone)
     #发送开启通道的回应消息
     def _response_open_channel(self, conn, channel_name, response, err_code):
         """
@@ -421,6 +802,8 @@ class PresenterSocketServer():
         |-------------------------------------------------------------------
         |error_message    |    string        |    xx bytes                 |
         |-------------------------------------------------------------------
+        |compression      |    enum          |    CompressionType          |
+        |-------------------------------------------------------------------
 
         enum OpenChannelErrorCode {
             kOpenChannelErrorNone = 0;
@@ -466,4 +849,30 @@ class PresenterSocketServer():
         packed_msg_head = s.pack(*msg_head)
         msg_data = packed_msg_head + \
             bytes(msg_name, encoding="utf-8") + message_data
-        conn.sendall(msg_data)
+        self._send_all(conn, msg_data)
+
+    def _send_all(self, conn, data):
+        '''
+        sendall() of a non-blocking connection, the bytes the socket does
+        not take are queued, and sent in order once it is writable
+        Args:
+            conn: a socket connection.
+            data: bytes to send.
+        Raises:
+            socket.error: send failed, or too many bytes are queued
+        '''
+        sock_fileno = conn.fileno()
+        unsent = self.unsent.get(sock_fileno)
+        if unsent is not None:
+            if len(unsent) + len(data) > MAX_UNSENT_BYTES:
+                raise socket.error("{} bytes unsent".format(len(unsent)))
+            unsent += data
+            return
+
+        try:
+            sent = conn.send(data)
+        except (BlockingIOError, InterruptedError):
+            sent = 0
+        if sent < len(data):
+            self.unsent[sock_fileno] = bytearray(memoryview(data)[sent:])
+            self.epoll.modify(sock_fileno, self._get_conn_events(sock_fileno))
@@ -35,6 +35,17 @@
 import os
 import configparser
 import common.parameter_validation as validate
+from common.ingest_worker import MAX_WORKER_NUM
+from common.channel_manager import MAX_CHANNEL_NUM
+from common.channel_handler import FRAME_RING_SIZE
+from common.channel_handler import RING_POLICIES
+from common.channel_handler import RING_POLICY_DROP_OLDEST
+
+# upper bound of max_channel_num
+MAX_CHANNEL_LIMIT = 65536
+
+# upper bound of frame_ring_size
+MAX_FRAME_RING_SIZE = 1024
 
 class ConfigParser():
     """ parse configuration from the config.conf"""
@@ -55,7 +66,14 @@ class ConfigParser():
         if not validate.validate_ip(ConfigParser.web_server_ip) or \
            not validate.validate_ip(ConfigParser.presenter_server_ip) or \
            not validate.validate_port(ConfigParser.web_server_port) or \
-           not validate.validate_port(ConfigParser.presenter_server_port):
+           not validate.validate_port(ConfigParser.presenter_server_port) or \
+           not validate.validate_integer(ConfigParser.presenter_server_workers,
+                                         0, MAX_WORKER_NUM) or \
+           not validate.validate_integer(ConfigParser.max_channel_num,
+                                         1, MAX_CHANNEL_LIMIT) or \
+           not validate.validate_integer(ConfigParser.frame_ring_size,
+                                         1, MAX_FRAME_RING_SIZE) or \
+           ConfigParser.frame_ring_policy not in RING_POLICIES:
             return False
         return True
 
@@ -72,6 +90,18 @@ class ConfigParser():
         cls.web_server_port = config_parser.get('baseconf', 'web_server_port')
         cls.presenter_server_port = \
             config_parser.get('baseconf', 'presenter_server_port')
+        cls.presenter_server_workers = \
+            config_parser.get('baseconf', 'presenter_server_workers',
+                              fallback='0')
+        cls.max_channel_num = \
+            config_parser.get('baseconf', 'max_channel_num',
+                              fallback=str(MAX_CHANNEL_NUM))
+        cls.frame_ring_size = \
+            config_parser.get('baseconf', 'frame_ring_size',
+                              fallback=str(FRAME_RING_SIZE))
+        cls.frame_ring_policy = \
+            config_parser.get('baseconf', 'frame_ring_policy',
+                              fallback=RING_POLICY_DROP_OLDEST)
 
 
     @staticmethod
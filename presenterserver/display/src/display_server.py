@@ -39,31 +39,106 @@ from google.protobuf.message import DecodeError
 import common.presenter_message_pb2 as pb2
 from common.channel_manager import ChannelManager
 from common.presenter_socket_server import PresenterSocketServer
+from common.presenter_socket_server import parse_message
 from common.channel_handler import ChannelHandler
+from common.ingest_worker import IngestWorkerPool
 from display.src.config_parser import ConfigParser
 
+# max size of an image sent in chunks, the whole image is kept in memory
+# until its last chunk comes
+MAX_CHUNKED_IMAGE_SIZE = 128 * 1024 * 1024
+# max bytes received of all the images being reassembled, an image which
+# does not fit is dropped
+MAX_REASSEMBLY_BYTES = 256 * 1024 * 1024
+# max images being reassembled on a connection, the oldest is dropped
+MAX_CHUNKED_IMAGES_PER_CONN = 8
+
+class ChunkedImage():
+    '''an image being reassembled from PresentImageChunk messages'''
+    def __init__(self, chunk):
+        self.frame_id = chunk.frame_id
+        self.image = chunk.image
+        self.total_size = chunk.total_size
+        self.next_index = 0
+        self.failed = False
+        # grows as the chunks come, a sender can not make the server
+        # allocate more than it really sends
+        self.data = bytearray()
+        if chunk.total_size == 0 or \
+           chunk.total_size > MAX_CHUNKED_IMAGE_SIZE:
+            logging.error("chunked image size %u is invalid, max %u",
+                          chunk.total_size, MAX_CHUNKED_IMAGE_SIZE)
+            self.failed = True
+
+    def append(self, index, data):
+        '''
+        append data of a chunk to the image
+        Returns:
+            change of the bytes kept, negative if the image fails
+        '''
+        if self.failed:
+            return 0
+
+        if index != self.next_index:
+            logging.error("chunk %u of image %u is missing, %u received",
+                          self.next_index, self.frame_id, index)
+            return -self.fail()
+
+        if len(self.data) + len(data) > self.total_size:
+            logging.error("chunked image %u overflows, size %u, received %u",
+                          self.frame_id, self.total_size,
+                          len(self.data) + len(data))
+            return -self.fail()
+
+        self.data += data
+        self.next_index += 1
+        return len(data)
+
+    def fail(self):
+        '''
+        drop the data, the image is kept until its last chunk to respond
+        Returns:
+            number of bytes released
+        '''
+        released = len(self.data)
+        self.failed = True
+        self.data = bytearray()
+        return released
+
+    def complete(self):
+        '''all the data of the image is received'''
+        return not self.failed and len(self.data) == self.total_size
+
 class DisplayServer(PresenterSocketServer):
     '''A server for face detection'''
-    def __init__(self, server_address):
+    def __init__(self, server_address, ingest_bus=None):
         '''init func'''
         self.channel_manager = ChannelManager(["image", "video"])
-        super(DisplayServer, self).__init__(server_address)
+        # fd -> {frame_id: ChunkedImage}, the images of a connection are
+        # in the order their first chunks came
+        self.chunked_images = {}
+        # bytes received of all the images being reassembled
+        self.reassembly_bytes = 0
+        super(DisplayServer, self).__init__(server_address, ingest_bus)
 
-    def _clean_connect(self, sock_fileno, epoll, conns, msgs):
+    def _clean_connect(self, sock_fileno, epoll, conns, readers):
         """
         close socket, and clean local variables
         Args:
             sock_fileno: a socket fileno, return value of socket.fileno()
             epoll: a set of select.epoll.
             conns: all socket connections registered in epoll
-            msgs: msg read from a socket
+            readers: MessageReader of each socket connection
         """
         logging.info("clean fd:%s, conns:%s", sock_fileno, conns)
         self.channel_manager.clean_channel_resource_by_fd(sock_fileno)
+        images = self.chunked_images.pop(sock_fileno, {})
+        for image in images.values():
+            self.reassembly_bytes -= image.fail()
         epoll.unregister(sock_fileno)
         conns[sock_fileno].close()
         del conns[sock_fileno]
-        del msgs[sock_fileno]
+        del readers[sock_fileno]
 
     #消息处理入口
     def _process_msg(self, conn, msg_name, msg_data):
@@ -85,6 +160,15 @@ class DisplayServer(PresenterSocketServer):
         # process image request, receive an image data from presenter agent
         elif msg_name == pb2._PRESENTIMAGEREQUEST.full_name:
             ret = self._process_image_request(conn, msg_data)
+        # process image batch request, several images acked by one response
+        elif msg_name == pb2._PRESENTIMAGEBATCHREQUEST.full_name:
+            ret = self._process_image_batch_request(conn, msg_data)
+        # process roi request, receive crops of the detected objects
+        elif msg_name == pb2._PRESENTROIREQUEST.full_name:
+            ret = self._process_roi_request(conn, msg_data)
+        # process a chunk of a large image, acked after the last chunk
+        elif msg_name == pb2._PRESENTIMAGECHUNK.full_name:
+            ret = self._process_image_chunk(conn, msg_data)
         # process heartbeat request, it used to keepalive a channel path
         elif msg_name == pb2._HEARTBEATMESSAGE.full_name:
             ret = self._process_heartbeat(conn)
@@ -162,9 +246,10 @@ class DisplayServer(PresenterSocketServer):
         request = pb2.PresentImageRequest()
         response = pb2.PresentImageResponse()
 
-        # Parse msg_data from protobuf
+        # Parse msg_data from protobuf, the image data is not copied
         try:
-            request.ParseFromString(msg_data)
+            fields = parse_message(request, msg_data,
+                                   [pb2.PresentImageRequest.DATA_FIELD_NUMBER])
         except DecodeError:
             logging.error("ParseFromString exception: Error parsing message")
             err_code = pb2.kPresentDataErrorOther
@@ -177,22 +262,248 @@ class DisplayServer(PresenterSocketServer):
             err_code = pb2.kPresentDataErrorOther
             return self._response_image_request(conn, response, err_code)
         #从消息数据中获取推理结果数据
-        rectangle_list = []
-        if request.rectangle_list:
-            for one_rectangle in request.rectangle_list:
-                rectangle = []
-                rectangle.append(one_rectangle.left_top.x)
-                rectangle.append(one_rectangle.left_top.y)
-                rectangle.append(one_rectangle.right_bottom.x)
-                rectangle.append(one_rectangle.right_bottom.y)
-                rectangle.append(one_rectangle.label_text)
-                # add the detection result to list
-                rectangle_list.append(rectangle)
+        rectangle_list = self._get_rectangle_list(request)
         #保存图像数据和推理结果
-        handler.save_image(request.data, request.width, request.height, rectangle_list)
+        # the last one wins if the field is repeated, same as protobuf
+        data_list = fields[pb2.PresentImageRequest.DATA_FIELD_NUMBER]
+        data = data_list[-1] if data_list else b''
+        handler.save_image(data, request.width, request.height, rectangle_list)
+        return self._response_image_request(conn, response,
+                                            pb2.kPresentDataErrorNone)
+
+    def _process_image_chunk(self, conn, msg_data):
+        """
+        Deserialization protobuf and reassemble a chunked image, only the
+        last chunk is responded, with the result of the whole image
+        Args:
+            conn: a socket connection
+            msg_data: a protobuf struct, include image chunk.
+
+        protobuf structure like this:
+         ------------------------------------------------------------
+        |frame_id      |    uint32, same for the chunks of an image  |
+        |------------------------------------------------------------
+        |index         |    uint32, 0, 1, ... in sending order       |
+        |------------------------------------------------------------
+        |last          |    bool, set in the last chunk              |
+        |------------------------------------------------------------
+        |total_size    |    uint32, size of the data, in chunk 0     |
+        |------------------------------------------------------------
+        |image         |    PresentImageRequest without data, chunk 0|
+        |------------------------------------------------------------
+        |data          |    bytes, part of the image data            |
+        |------------------------------------------------------------
+        """
+        chunk = pb2.PresentImageChunk()
+        response = pb2.PresentImageResponse()
+
+        try:
+            fields = parse_message(chunk, msg_data,
+                                   [pb2.PresentImageChunk.DATA_FIELD_NUMBER])
+        except DecodeError:
+            # the frame can not be told, so the stream is out of sync
+            logging.error("ParseFromString exception: Error parsing message")
+            return False
+
+        data_list = fields[pb2.PresentImageChunk.DATA_FIELD_NUMBER]
+        data = data_list[-1] if data_list else b''
+        sock_fileno = conn.fileno()
+        images = self.chunked_images.setdefault(sock_fileno, {})
+        if chunk.index == 0:
+            self._drop_chunked_image(images, chunk.frame_id)
+            if len(images) >= MAX_CHUNKED_IMAGES_PER_CONN:
+                self._drop_chunked_image(images, next(iter(images)))
+            images[chunk.frame_id] = ChunkedImage(chunk)
+
+        image = images.get(chunk.frame_id)
+        if image is None:
+            logging.error("unexpected chunk %u of image %u",
+                          chunk.index, chunk.frame_id)
+        elif not image.failed and \
+             self.reassembly_bytes + len(data) > MAX_REASSEMBLY_BYTES:
+            logging.error("chunked image %u is dropped, %u bytes of images "
+                          "are being reassembled", chunk.frame_id,
+                          self.reassembly_bytes)
+            self.reassembly_bytes -= image.fail()
+        else:
+            self.reassembly_bytes += image.append(chunk.index, data)
+
+        handler = self.channel_manager.get_channel_handler_by_fd(sock_fileno)
+        if not chunk.last:
+            # a large image takes a while, keep the channel alive
+            if handler is not None:
+                handler.set_heartbeat()
+            return True
+
+        image = images.pop(chunk.frame_id, None)
+        if image is not None:
+            self.reassembly_bytes -= len(image.data)
+
+        if handler is None:
+            logging.error("get channel handler failed")
+            err_code = pb2.kPresentDataErrorOther
+            return self._response_image_request(conn, response, err_code)
+
+        if image is None or not image.complete():
+            logging.error("chunked image %u is incomplete", chunk.frame_id)
+            err_code = pb2.kPresentDataErrorOther
+            return self._response_image_request(conn, response, err_code)
+
+        handler.save_image(image.data, image.image.width,
+                           image.image.height,
+                           self._get_rectangle_list(image.image))
+        return self._response_image_request(conn, response,
+                                            pb2.kPresentDataErrorNone)
+
+    def _drop_chunked_image(self, images, frame_id):
+        """
+        Drop an image being reassembled, its last chunk is responded as
+        incomplete
+        Args:
+            images: the images being reassembled on a connection
+            frame_id: frame id of the image
+        """
+        image = images.pop(frame_id, None)
+        if image is not None:
+            logging.error("chunked image %u is dropped, %u received",
+                          frame_id, len(image.data))
+            self.reassembly_bytes -= image.fail()
+
+    def _process_image_batch_request(self, conn, msg_data):
+        """
+        Deserialization protobuf and process display image batch request,
+        the whole batch is acked by one PresentImageResponse
+        Args:
+            conn: a socket connection
+            msg_data: a protobuf struct, include image batch request.
+
+        protobuf structure like this:
+         ------------------------------------------------------
+        |image_list    |    repeated PresentImageRequest       |
+        |------------------------------------------------------
+        |data_list     |    repeated bytes, data of image_list |
+        |------------------------------------------------------
+        """
+        request = pb2.PresentImageBatchRequest()
+        response = pb2.PresentImageResponse()
+
+        try:
+            fields = parse_message(
+                request, msg_data,
+                [pb2.PresentImageBatchRequest.DATA_LIST_FIELD_NUMBER])
+        except DecodeError:
+            logging.error("ParseFromString exception: Error parsing message")
+            err_code = pb2.kPresentDataErrorOther
+            return self._response_image_request(conn, response, err_code)
+
+        data_list = fields[pb2.PresentImageBatchRequest.DATA_LIST_FIELD_NUMBER]
+        if not request.image_list or \
+           len(request.image_list) != len(data_list):
+            logging.error("image batch has %d images but %d data",
+                          len(request.image_list), len(data_list))
+            err_code = pb2.kPresentDataErrorOther
+            return self._response_image_request(conn, response, err_code)
+
+        sock_fileno = conn.fileno()
+        handler = self.channel_manager.get_channel_handler_by_fd(sock_fileno)
+        if handler is None:
+            logging.error("get channel handler failed")
+            err_code = pb2.kPresentDataErrorOther
+            return self._response_image_request(conn, response, err_code)
+
+        images = []
+        for image, data in zip(request.image_list, data_list):
+            images.append((data, image.width, image.height,
+                           self._get_rectangle_list(image)))
+        handler.save_images(images)
+        return self._response_image_request(conn, response,
+                                            pb2.kPresentDataErrorNone)
+
+    def _process_roi_request(self, conn, msg_data):
+        """
+        Deserialization protobuf and process display roi request, the crops
+        are composited on the last low-res full frame by the browser
+        Args:
+            conn: a socket connection
+            msg_data: a protobuf struct, include roi request.
+
+        protobuf structure like this:
+         ------------------------------------------------------------
+        |width         |    uint32, width of the full frame          |
+        |------------------------------------------------------------
+        |height        |    uint32, height of the full frame         |
+        |------------------------------------------------------------
+        |data          |    bytes, optional low-res full frame       |
+        |------------------------------------------------------------
+        |rectangle_list|    repeated Rectangle_Attr, crop regions    |
+        |------------------------------------------------------------
+        |data_list     |    repeated bytes, data of rectangle_list   |
+        |------------------------------------------------------------
+        """
+        request = pb2.PresentRoiRequest()
+        response = pb2.PresentImageResponse()
+
+        try:
+            fields = parse_message(
+                request, msg_data,
+                [pb2.PresentRoiRequest.DATA_FIELD_NUMBER,
+                 pb2.PresentRoiRequest.DATA_LIST_FIELD_NUMBER])
+        except DecodeError:
+            logging.error("ParseFromString exception: Error parsing message")
+            err_code = pb2.kPresentDataErrorOther
+            return self._response_image_request(conn, response, err_code)
+
+        crop_list = fields[pb2.PresentRoiRequest.DATA_LIST_FIELD_NUMBER]
+        if not request.rectangle_list or \
+           len(request.rectangle_list) != len(crop_list):
+            logging.error("roi request has %d regions but %d crops",
+                          len(request.rectangle_list), len(crop_list))
+            err_code = pb2.kPresentDataErrorOther
+            return self._response_image_request(conn, response, err_code)
+
+        sock_fileno = conn.fileno()
+        handler = self.channel_manager.get_channel_handler_by_fd(sock_fileno)
+        if handler is None:
+            logging.error("get channel handler failed")
+            err_code = pb2.kPresentDataErrorOther
+            return self._response_image_request(conn, response, err_code)
+
+        # crops are streamed, a still image channel has nothing to
+        # composite them on
+        if handler.get_media_type() != "video":
+            logging.error("roi request is only supported by video channel")
+            err_code = pb2.kPresentDataErrorUnsupportedType
+            return self._response_image_request(conn, response, err_code)
+
+        data_list = fields[pb2.PresentRoiRequest.DATA_FIELD_NUMBER]
+        data = data_list[-1] if data_list else b''
+        handler.save_rois(data, request.width, request.height,
+                          self._get_rectangle_list(request), crop_list)
         return self._response_image_request(conn, response,
                                             pb2.kPresentDataErrorNone)
 
+    def _get_rectangle_list(self, request):
+        """
+        get detection results of a PresentImageRequest or PresentRoiRequest
+        Args:
+            request: a PresentImageRequest or PresentRoiRequest
+
+        Returns:
+            list of [left_top.x, left_top.y, right_bottom.x, right_bottom.y,
+                     label_text]
+        """
+        rectangle_list = []
+        for one_rectangle in request.rectangle_list:
+            rectangle = []
+            rectangle.append(one_rectangle.left_top.x)
+            rectangle.append(one_rectangle.left_top.y)
+            rectangle.append(one_rectangle.right_bottom.x)
+            rectangle.append(one_rectangle.right_bottom.y)
+            rectangle.append(one_rectangle.label_text)
+            # add the detection result to list
+            rectangle_list.append(rectangle)
+        return rectangle_list
+
     def stop_thread(self):
         channel_manager = ChannelManager([])
         channel_manager.close_all_thread()
@@ -212,6 +523,12 @@ def run():
         return None
 
     logging.info("presenter server is starting...")
+    ChannelManager.set_max_channel_num(int(config.max_channel_num))
+    ChannelHandler.set_frame_ring(int(config.frame_ring_size),
+                                  config.frame_ring_policy)
     server_address = (config.presenter_server_ip,
                       int(config.presenter_server_port))
+    worker_num = int(config.presenter_server_workers)
+    if worker_num > 0:
+        return IngestWorkerPool(DisplayServer, server_address, worker_num)
     return DisplayServer(server_address)
@@ -38,15 +38,98 @@ import os
 import re
 import random
 import base64
+import struct
 import threading
-import time
 import logging
+import tornado.concurrent
+import tornado.escape
 import tornado.ioloop
 import tornado.web
 import tornado.gen
 import tornado.websocket
 import display.src.config_parser as config_parser
 from common.channel_manager import ChannelManager
+from common.channel_handler import ChannelHandler
+
+# binary frame message, see WebApp.make_frame_binary
+FRAME_HEAD = struct.Struct('!BBHIIHHIIf')
+FRAME_RECTANGLE = struct.Struct('!IIIIH')
+FRAME_CROP = struct.Struct('!I')
+FRAME_VERSION = 1
+# the frame has a crop list, maybe empty
+FRAME_FLAG_CROPS = 0x1
+# the metrics fields are set
+FRAME_FLAG_METRICS = 0x2
+
+# boundary of the parts of a MJPEG stream, see MjpegHandler
+MJPEG_BOUNDARY = "frame"
+
+class FramePayload:
+    """
+    a frame pushed to the viewers of a channel. Its json and binary
+    messages are made once, on first use, and shared by all the viewers,
+    so sending the frame to a viewer is only a socket write
+    """
+    def __init__(self, channel_name, frame_info):
+        """
+        @param channel_name: channel of the frame
+        @param frame_info: frame handed over by the video thread
+        """
+        self.channel_name = channel_name
+        self.frame_info = frame_info
+        self.metrics = None
+        self.json = None
+        self.binary = None
+        self.part = None
+
+    def _get_metrics(self):
+        """
+        metrics of the channel when the frame is first sent, None if the
+        channel is closed
+        """
+        if self.metrics is None:
+            handler = G_WEBAPP.channel_mgr.get_channel_handler_by_name(
+                self.channel_name)
+            if handler is not None:
+                self.metrics = handler.metrics.get_window(10)
+        return self.metrics
+
+    def get_message(self, binary):
+        """
+        @param binary: True for the binary message, False for json
+        @return return the message, bytes or json string
+        """
+        if binary:
+            if self.binary is None:
+                self.binary = WebApp.make_frame_binary(self.frame_info,
+                                                       self._get_metrics())
+            return self.binary
+
+        if self.json is None:
+            self.json = tornado.escape.json_encode(
+                WebApp.make_frame_message(self.frame_info,
+                                          self._get_metrics()))
+        return self.json
+
+    def get_part(self):
+        """
+        @return return the part of a MJPEG stream, the JPEG data as is
+        """
+        if self.part is None:
+            self.part = make_mjpeg_part(self.frame_info[0])
+        return self.part
+
+
+def make_mjpeg_part(image):
+    """
+    make a part of a multipart/x-mixed-replace stream
+
+    @param image: JPEG data
+    @return return bytes of the part
+    """
+    head = ("--%s\r\nContent-Type: image/jpeg\r\nContent-Length: %d\r\n\r\n"
+            % (MJPEG_BOUNDARY, len(image))).encode('utf-8')
+    return b''.join((head, image, b'\r\n'))
 
 class WebApp:
     """
@@ -61,6 +144,12 @@ class WebApp:
 
         self.request_list = set()
 
+        # channel name -> set of WebSocket viewing the channel
+        self.viewers = {}
+
+        # IOLoop of the web server, the frames are pushed on it
+        self.io_loop = None
+
         self.lock = threading.Lock()
 
     def __new__(cls, *args, **kwargs):
@@ -118,8 +207,10 @@ class WebApp:
 
         #  check register result
         if self.channel_mgr.err_code_too_many_channel == flag:
-            logging.info("Only supports up to 10 channels, add channel failed")
-            ret["msg"] = "Only supports up to 10 channels"
+            logging.info("Only supports up to %d channels, add channel failed",
+                         self.channel_mgr.max_channel_num)
+            ret["msg"] = "Only supports up to %d channels" % \
+                         self.channel_mgr.max_channel_num
 
         elif self.channel_mgr.err_code_repeat_channel == flag:
             logging.info("%s already exist, add channel failed", channel_name)
@@ -160,6 +251,8 @@ class WebApp:
                 continue
 
             self.channel_mgr.unregister_one_channel(item)
+            for viewer in list(self.viewers.get(item, ())):
+                viewer.close()
             logging.info("delete channel %s succeed", item)
 
         ret["ret"] = "success"
@@ -185,6 +278,24 @@ class WebApp:
 
         return ret
 
+    def get_metrics(self):
+        """
+        get metrics of all channels
+
+        @return: return dictionary, channels: list of name, status and
+                 metrics of 1s, 10s and 60s windows, metrics is None if the
+                 channel is not opened by an agent.
+        """
+        channels = []
+        for item in self.channel_mgr.list_channels():
+            handler = self.channel_mgr.get_channel_handler_by_name(
+                item['name'])
+            item['metrics'] = None if handler is None \
+                              else handler.metrics.get_all()
+            channels.append(item)
+
+        return {'channels': channels}
+
     def is_channel_exists(self, name):
         """
         view channel content via browser.
@@ -247,35 +358,153 @@ class WebApp:
             return {'type': 'image', 'image':image_data, 'fps':0, 'status':'ok'}
 
 
-        fps = 0    # fps for video
-        image = None    # image for video & image
-        rectangle_list = None
         handler = self.channel_mgr.get_channel_handler_by_name(channel_name)
+        if handler is None:
+            return {'type': 'unkown', 'image':None, 'fps':0, 'status':'loading'}
+
+        # frames of a video channel are pushed to the viewers by push_frame
+        if handler.get_media_type() == "video":
+            return {'type': 'video', 'image':None, 'fps':0, 'status':'pushed'}
 
-        if handler is not None:
-            media_type = handler.get_media_type()
+        # the image of the image channel is not received yet
+        return {'type': 'image', 'image':None, 'fps':0, 'status':'loading'}
 
-            # if type is image then get image data
-            if media_type == "image":
-                image = handler.get_image_data()
+    @staticmethod
+    def make_frame_message(frame_info, metrics):
+        """
+        make the message of a frame of a video channel
 
-            # for video
-            else:
-                frame_info = handler.get_frame()
-                image = frame_info[0]
-                fps = frame_info[1]
-                rectangle_list = frame_info[4]
+        @param frame_info: (image, fps, width, height, rectangle_list,
+                           crop_list) handed over by the video thread
+        @param metrics: metrics of the channel, None if it is closed
+        @return return dictionary sent to the browser in json
+        """
+        image, fps, width, height, rectangle_list, crop_list = frame_info
+        image = base64.b64encode(image).decode('utf-8')
 
-            status = "loading"
+        # crops of the detected objects, the browser composites them
+        # on the last full frame, image is empty if no new one comes
+        if crop_list is not None:
+            crop_list = [base64.b64encode(crop).decode('utf-8')
+                         for crop in crop_list]
 
-            # decode binary to utf-8 when image is not None
-            if image is not None:
-                status = "ok"
-                image = base64.b64encode(image).decode('utf-8')
+        return {'type': 'video', 'image':image, 'fps':fps, 'status':'ok',
+                'rectangle_list':rectangle_list, 'width':width,
+                'height':height, 'crop_list':crop_list,
+                'metrics':metrics}
 
-            return {'type': media_type, 'image':image, 'fps':fps, 'status':status, 'rectangle_list':rectangle_list}
+    @staticmethod
+    def make_frame_binary(frame_info, metrics):
+        """
+        make the binary message of a frame of a video channel, the JPEG data
+        is sent as is. All the fields are in network byte order
+
+        message structure like this:
+        --------------------------------------------------------------------
+        |version             |    uint8       |    FRAME_VERSION            |
+        |-------------------------------------------------------------------
+        |flags               |    uint8       |    FRAME_FLAG_*             |
+        |-------------------------------------------------------------------
+        |fps                 |    uint16      |                             |
+        |-------------------------------------------------------------------
+        |width, height       |    uint32 x 2  |                             |
+        |-------------------------------------------------------------------
+        |rectangle number    |    uint16      |                             |
+        |-------------------------------------------------------------------
+        |crop number         |    uint16      |                             |
+        |-------------------------------------------------------------------
+        |bytes per second    |    uint32      |    metrics of last 10s      |
+        |-------------------------------------------------------------------
+        |drops               |    uint32      |    metrics of last 10s      |
+        |-------------------------------------------------------------------
+        |jitter in ms        |    float32     |    metrics of last 10s      |
+        |-------------------------------------------------------------------
+        |rectangles          |    xx bytes    |    see below                |
+        |-------------------------------------------------------------------
+        |crops               |    xx bytes    |    uint32 size, JPEG data   |
+        |-------------------------------------------------------------------
+        |image               |    xx bytes    |    JPEG data, to the end    |
+        --------------------------------------------------------------------
+
+        a rectangle: left top x, y, right bottom x, y in uint32, label
+        length in uint16, and the label in utf-8
+
+        @param frame_info: (image, fps, width, height, rectangle_list,
+                           crop_list) handed over by the video thread
+        @param metrics: metrics of the channel, None if it is closed
+        @return return bytes sent to the browser in a binary message
+        """
+        image, fps, width, height, rectangle_list, crop_list = frame_info
+        rectangle_list = rectangle_list or []
+        flags = 0
+        if crop_list is not None:
+            flags |= FRAME_FLAG_CROPS
         else:
-            return {'type': 'unkown', 'image':None, 'fps':0, 'status':'loading'}
+            crop_list = []
+
+        bytes_per_second = drops = 0
+        jitter = 0.0
+        if metrics is not None:
+            flags |= FRAME_FLAG_METRICS
+            bytes_per_second = metrics['bytes_per_second']
+            drops = metrics['drops']
+            jitter = metrics['jitter_ms']
+
+        parts = [FRAME_HEAD.pack(FRAME_VERSION, flags, min(fps, 0xffff),
+                                 width, height, len(rectangle_list),
+                                 len(crop_list), bytes_per_second, drops,
+                                 jitter)]
+        for rectangle in rectangle_list:
+            label = rectangle[4].encode('utf-8')[:0xffff]
+            parts.append(FRAME_RECTANGLE.pack(rectangle[0], rectangle[1],
+                                              rectangle[2], rectangle[3],
+                                              len(label)))
+            parts.append(label)
+
+        for crop in crop_list:
+            parts.append(FRAME_CROP.pack(len(crop)))
+            parts.append(crop)
+
+        parts.append(image)
+        return b''.join(parts)
+
+    def on_frame(self, channel_name, frame_info):
+        """
+        frame listener of the channel handlers, called by the video thread
+        of a channel, the frame is pushed to the viewers on the IOLoop
+
+        @param channel_name: channel of the frame
+        @param frame_info: frame handed over by the video thread
+        """
+        # viewers is changed on the IOLoop only, a viewer added meanwhile
+        # gets the next frame
+        if channel_name in self.viewers:
+            self.io_loop.add_callback(self.push_frame, channel_name,
+                                      frame_info)
+
+    def push_frame(self, channel_name, frame_info):
+        """
+        push a frame to the viewers of the channel, run on the IOLoop
+        """
+        payload = FramePayload(channel_name, frame_info)
+        for viewer in list(self.viewers.get(channel_name, ())):
+            viewer.push_frame(payload)
+
+    def add_viewer(self, channel_name, viewer):
+        """
+        a web socket views the channel, run on the IOLoop
+        """
+        self.viewers.setdefault(channel_name, set()).add(viewer)
+
+    def remove_viewer(self, channel_name, viewer):
+        """
+        a web socket stops viewing the channel, run on the IOLoop
+        """
+        viewers = self.viewers.get(channel_name)
+        if viewers is not None:
+            viewers.discard(viewer)
+            if not viewers:
+                del self.viewers[channel_name]
 
 # pylint: disable=abstract-method
 class BaseHandler(tornado.web.RequestHandler):
@@ -341,6 +570,129 @@ class ViewHandler(BaseHandler):
         else:
             raise tornado.web.HTTPError(404)
 
+# pylint: disable=abstract-method
+class MetricsHandler(BaseHandler):
+    """
+    handler metrics request
+    """
+    @tornado.web.asynchronous
+    def get(self, *args, **kwargs):
+        """
+        handle request for metrics of all channels, in json
+        """
+        self.finish(G_WEBAPP.get_metrics())
+
+# pylint: disable=abstract-method
+class MjpegHandler(BaseHandler):
+    """
+    handler MJPEG stream request, for the clients not speaking the web
+    socket protocol, e.g. ffmpeg or an <img> tag
+    """
+    @tornado.gen.coroutine
+    def get(self, channel_name):
+        """
+        stream the frames of a video channel as multipart/x-mixed-replace,
+        until the client or the channel is closed. An image channel gets
+        its image as the only part
+        """
+        self.channel_name = channel_name
+        # frame waiting for the one being sent, older ones are skipped
+        self.sending = False
+        self.pending = None
+        self.skipped = 0
+        self.closed = tornado.concurrent.Future()
+
+        if not G_WEBAPP.is_channel_exists(channel_name):
+            raise tornado.web.HTTPError(404)
+
+        handler = G_WEBAPP.channel_mgr.get_channel_handler_by_name(
+            channel_name)
+        image_data = G_WEBAPP.channel_mgr.get_channel_image(channel_name)
+        # the image of the image channel is not received yet, the frames
+        # of a channel not opened yet come when it is opened
+        if image_data is None and handler is not None and \
+           handler.get_media_type() != "video":
+            raise tornado.web.HTTPError(404)
+
+        self.set_header("Content-Type",
+                        "multipart/x-mixed-replace; boundary=" + MJPEG_BOUNDARY)
+        self.set_header("Cache-Control", "no-cache, no-store")
+        if image_data is not None:
+            self.finish(make_mjpeg_part(image_data))
+            return
+
+        yield self.flush()
+        G_WEBAPP.add_viewer(channel_name, self)
+        yield self.closed
+
+        G_WEBAPP.remove_viewer(channel_name, self)
+        if self.skipped:
+            logging.info("MJPEG client of %s skipped %d frames", channel_name,
+                         self.skipped)
+        if self.request.connection.stream is not None and \
+           not self.request.connection.stream.closed():
+            self.finish()
+
+    def on_connection_close(self):
+        """
+        called when the client closes the connection
+        """
+        self.close()
+
+    def close(self):
+        """
+        stop streaming, called when the channel is deleted
+        """
+        if not self.closed.done():
+            self.closed.set_result(None)
+
+    def push_frame(self, payload):
+        """
+        push a frame of the channel, run on the IOLoop. If the client is
+        still receiving the last frame, the frame waits, replacing the one
+        waiting before it, so a slow client skips frames. The frames
+        with only crops of the last image have no image to stream
+
+        @param payload: FramePayload of the frame
+        """
+        if not payload.frame_info[0]:
+            return
+
+        if self.sending:
+            if self.pending is not None:
+                self.skipped += 1
+            self.pending = payload
+            return
+
+        self._send_frame(payload)
+
+    def _send_frame(self, payload):
+        """
+        send a frame, the next frame is sent when it is written
+        """
+        if self.closed.done():
+            return
+
+        self.write(payload.get_part())
+        self.sending = True
+        tornado.ioloop.IOLoop.current().add_future(self.flush(),
+                                                   self._on_sent)
+
+    def _on_sent(self, future):
+        """
+        the last frame is written, send the frame waiting
+        """
+        self.sending = False
+        # the connection is closed
+        if future.exception() is not None:
+            self.close()
+            return
+
+        if self.pending is not None:
+            payload = self.pending
+            self.pending = None
+            self._send_frame(payload)
+
 
 class WebSocket(tornado.websocket.WebSocketHandler):
     """
@@ -354,9 +706,21 @@ class WebSocket(tornado.websocket.WebSocketHandler):
         self.req_id = self.get_argument("req", '', True)
         self.channel_name = self.get_argument("name", '', True)
 
+        # binary frame messages for the browsers supporting them, json
+        # otherwise
+        self.binary = self.get_argument("format", "json", True) == "binary"
+
+        # frame waiting for the one being sent, older ones are skipped
+        self.sending = False
+        self.pending = None
+        self.skipped = 0
+
         # check request valid or not.
         if not G_WEBAPP.has_request((self.req_id, self.channel_name)):
             self.close()
+            return
+
+        G_WEBAPP.add_viewer(self.channel_name, self)
 
 
     @staticmethod
@@ -383,6 +747,53 @@ class WebSocket(tornado.websocket.WebSocketHandler):
         """
         called when closed web socket
         """
+        G_WEBAPP.remove_viewer(self.channel_name, self)
+        if self.skipped:
+            logging.info("viewer of %s skipped %d frames", self.channel_name,
+                         self.skipped)
+
+    def push_frame(self, payload):
+        """
+        push a frame of the channel, run on the IOLoop. If the browser is
+        still receiving the last frame, the frame waits, replacing the one
+        waiting before it, so a slow browser skips frames
+
+        @param payload: FramePayload of the frame
+        """
+        if self.sending:
+            if self.pending is not None:
+                self.skipped += 1
+            self.pending = payload
+            return
+
+        self._send_frame(payload)
+
+    def _send_frame(self, payload):
+        """
+        send a frame, the next frame is sent when it is written
+        """
+        try:
+            future = self.write_message(payload.get_message(self.binary),
+                                        binary=self.binary)
+        except tornado.websocket.WebSocketClosedError:
+            return
+
+        self.sending = True
+        tornado.ioloop.IOLoop.current().add_future(future, self._on_sent)
+
+    def _on_sent(self, future):
+        """
+        the last frame is written, send the frame waiting
+        """
+        self.sending = False
+        # the web socket is closed
+        if future.exception() is not None:
+            return
+
+        if self.pending is not None:
+            payload = self.pending
+            self.pending = None
+            self._send_frame(payload)
 
     @tornado.web.asynchronous
     @tornado.gen.coroutine
@@ -407,20 +818,19 @@ class WebSocket(tornado.websocket.WebSocketHandler):
 
         result = G_WEBAPP.get_media_data(self.channel_name)
 
-        # sleep 100ms if status not ok for frequently query
-        if result['status'] != 'ok':
-            time.sleep(0.1)
-
-
-
         # if channel not exist close websocket.
         if result['status'] == "error":
             self.close()
-        # send message to client
+        # frames of video channel are pushed
+        elif result['status'] == "pushed":
+            return
+        # send message to client, the browser asks again later if the
+        # image is loading
         else:
             # close websoket when send failed or for image channel.
             ret = WebSocket.send_message(self, result)
-            if not ret or result['type'] == "image":
+            if not ret or (result['type'] == "image" and
+                           result['status'] == "ok"):
                 self.close()
 
 
@@ -439,6 +849,9 @@ def get_webapp():
                                             (r"/add", AddHandler),
                                             (r"/del", DelHandler),
                                             (r"/view", ViewHandler),
+                                            (r"/metrics", MetricsHandler),
+                                            (r"/stream/(.+)\.mjpg",
+                                             MjpegHandler),
                                             (r"/static/(.*)",
                                              tornado.web.StaticFileHandler,
                                              {"path": staticfilepath}),
@@ -457,6 +870,8 @@ def start_webapp():
     """
     http_server = get_webapp()
     config = config_parser.ConfigParser()
+    G_WEBAPP.io_loop = tornado.ioloop.IOLoop.instance()
+    ChannelHandler.set_frame_listener(G_WEBAPP.on_frame)
     http_server.listen(config.web_server_port, address=config.web_server_ip)
 
     print("Please visit http://" + config.web_server_ip + ":" +
@@ -34,6 +34,7 @@
 import os
 import sys
 import time
+import threading
 import unittest
 from unittest.mock import patch
 path = os.path.dirname(__file__)
@@ -107,6 +108,60 @@ class TestChannelHandler(unittest.TestCase):
         image = handler.get_image()
         self.assertEqual(data, image)
 
+    def test_save_images_image(self):
+        """test_save_images_image"""
+        channel_name = "image"
+        media_type = "image"
+        handler = channel_handler.ChannelHandler(channel_name, media_type)
+
+        images = [("image data 1", 100, 100, []),
+                  ("image data 2", 100, 100, [])]
+        handler.save_images(images)
+        image = handler.get_image()
+        self.assertEqual("image data 2", image)
+
+    @patch('common.channel_handler.ChannelHandler._create_thread')
+    def test_save_images_video(self, mock_create_thread):
+        """test_save_images_video"""
+        channel_name = "video"
+        media_type = "video"
+        handler = channel_handler.ChannelHandler(channel_name, media_type)
+        mock_create_thread.assert_called_once_with()
+
+        # every frame of the batch is queued in order, the ring of 4
+        # frames drops the oldest ones
+        images = [(b"image data %d" % i, 100, 100, [i]) for i in range(6)]
+        handler.save_images(images)
+        for i in range(2, 6):
+            frame = handler.frame_ring.get(0)
+            self.assertEqual(b"image data %d" % i, frame[0])
+            self.assertEqual([i], frame[4])
+        self.assertEqual(None, handler.frame_ring.get(0))
+        self.assertEqual(2, handler.frame_ring.dropped)
+        metrics = handler.metrics
+        self.assertEqual(6, metrics.frames[metrics.index])
+        self.assertEqual(2, metrics.drops[metrics.index])
+        handler.frame_ring.close()
+
+    @patch('common.channel_handler.ThreadEvent')
+    def test_save_rois_video(self, mock_class):
+        """test_save_rois_video"""
+        thread_event = mock_class.return_value
+        thread_event.wait.return_value = True
+
+        channel_name = "video"
+        media_type = "video"
+        handler = channel_handler.ChannelHandler(channel_name, media_type)
+
+        # no full frame, the crops alone make a frame
+        handler.save_rois(b"", 100, 100, [[1, 1, 5, 5, "face"]], [b"crop"])
+        time.sleep(0.05)
+        frame_info = handler.get_frame()
+        self.assertEqual(b"", frame_info[0])
+        self.assertEqual([[1, 1, 5, 5, "face"]], frame_info[4])
+        self.assertEqual([b"crop"], frame_info[5])
+        handler.close_thread()
+
     @patch('common.channel_handler.ThreadEvent')
     def test_save_image_video(self, mock_class):
         """test_save_image_video"""
@@ -137,6 +192,43 @@ class TestChannelHandler(unittest.TestCase):
         handler.set_heartbeat()
         self.assertEqual(handler.close_thread_switch, True)
 
+    def test_frame_ring_drop(self):
+        """test_frame_ring_drop"""
+        ring = channel_handler.FrameRing(
+            2, channel_handler.RING_POLICY_DROP_OLDEST)
+        for i in range(3):
+            self.assertEqual(True, ring.put(i))
+        self.assertEqual(1, ring.get(0))
+        self.assertEqual(2, ring.get(0))
+        self.assertEqual(None, ring.get(0))
+
+        ring = channel_handler.FrameRing(
+            2, channel_handler.RING_POLICY_DROP_NEWEST)
+        for i in range(3):
+            self.assertEqual(i < 2, ring.put(i))
+        self.assertEqual(0, ring.get(0))
+        self.assertEqual(1, ring.get(0))
+        self.assertEqual(1, ring.dropped)
+
+    def test_frame_ring_block(self):
+        """test_frame_ring_block"""
+        ring = channel_handler.FrameRing(1, channel_handler.RING_POLICY_BLOCK)
+        ring.put(0)
+        thread = threading.Thread(target=ring.put, args=(1,))
+        thread.start()
+        time.sleep(0.05)
+        self.assertEqual(True, thread.is_alive())
+        self.assertEqual(0, ring.get(1))
+        thread.join(1)
+        self.assertEqual(1, ring.get(1))
+
+        # a closed ring never blocks
+        ring.put(2)
+        ring.close()
+        self.assertEqual(False, ring.put(3))
+        self.assertEqual(None, ring.get(1))
+
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -129,6 +129,7 @@ class TestChannelManager(unittest.TestCase):
             channel_name = i["name"]
             self.manager.unregister_one_channel(channel_name)
 
+        self.manager.set_max_channel_num(10)
         channel_name = "video1"
         self.assertEqual(False, self.manager.is_channel_exist(channel_name))
 
@@ -151,9 +152,16 @@ class TestChannelManager(unittest.TestCase):
         ret = self.manager.register_one_channel(channel_name)
         self.assertEqual(ret, self.manager.err_code_too_many_channel)
 
+        self.manager.set_max_channel_num(11)
+        ret = self.manager.register_one_channel(channel_name)
+        self.assertEqual(ret, self.manager.err_code_ok)
+        self.assertEqual(["video{}".format(i) for i in range(1, 12)],
+                         [i["name"] for i in self.manager.list_channels()])
+
         for i in self.manager.list_channels():
             channel_name = i["name"]
             self.manager.unregister_one_channel(channel_name)
+        self.manager.set_max_channel_num(channel_manager.MAX_CHANNEL_NUM)
 
     def test_save_channel_path_image(self):
         """test_save_channel_path_image"""
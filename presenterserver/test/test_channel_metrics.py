@@ -0,0 +1,104 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+"""utest channel metrics module"""
+
+import os
+import sys
+import unittest
+from unittest.mock import patch
+path = os.path.dirname(__file__)
+index = path.rfind("ascenddk")
+workspace = path[0: index]
+path = os.path.join(workspace, "ascenddk/common/presenter/server")
+sys.path.append(path)
+
+import common.channel_metrics as channel_metrics
+
+class TestChannelMetrics(unittest.TestCase):
+    """TestChannelMetrics"""
+
+    @patch('common.channel_metrics.time')
+    def test_window(self, mock_time):
+        """test_window"""
+        metrics = channel_metrics.ChannelMetrics()
+        # 10 frames of 100 bytes per second for 20 seconds, one drop each
+        # second, evenly spaced
+        for i in range(200):
+            mock_time.time.return_value = 1000 + i * 0.1
+            metrics.add_frames(100)
+            if i % 10 == 0:
+                metrics.add_drops(1)
+
+        mock_time.time.return_value = 1020.05
+        self.assertEqual(10, metrics.get_fps())
+        window = metrics.get_window(10)
+        self.assertEqual(10, window['fps'])
+        self.assertEqual(1000, window['bytes_per_second'])
+        self.assertEqual(10, window['drops'])
+        self.assertAlmostEqual(0, window['jitter_ms'], places=3)
+
+        # the 60s window counts only the 20 seconds with frames
+        window = metrics.get_all()['60s']
+        self.assertEqual(round(200 / 60, 2), window['fps'])
+        self.assertEqual(20, window['drops'])
+
+    @patch('common.channel_metrics.time')
+    def test_stale_bucket(self, mock_time):
+        """test_stale_bucket"""
+        metrics = channel_metrics.ChannelMetrics()
+        mock_time.time.return_value = 1000.5
+        metrics.add_frames(100, frame_num=5)
+
+        # the bucket of second 1000 is reused by second 1060
+        mock_time.time.return_value = 1060.5
+        metrics.add_frames(100)
+        mock_time.time.return_value = 1061.5
+        self.assertEqual(1, metrics.get_fps())
+        self.assertEqual(round(1 / 60, 2), metrics.get_window(60)['fps'])
+
+    @patch('common.channel_metrics.time')
+    def test_jitter(self, mock_time):
+        """test_jitter"""
+        metrics = channel_metrics.ChannelMetrics()
+        # intervals alternate between 50ms and 150ms
+        now = 1000.0
+        for i in range(11):
+            mock_time.time.return_value = now
+            metrics.add_frames(100)
+            now += 0.05 if i % 2 == 0 else 0.15
+
+        mock_time.time.return_value = 1003.0
+        self.assertAlmostEqual(50, metrics.get_window(10)['jitter_ms'],
+                               places=1)
+
+if __name__ == '__main__':
+    unittest.main()
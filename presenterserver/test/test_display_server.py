@@ -0,0 +1,211 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+"""utest channel metrics module"""
+
+import os
+import sys
+import unittest
+from unittest.mock import MagicMock
+from unittest.mock import patch
+path = os.path.dirname(__file__)
+index = path.rfind("ascenddk")
+workspace = path[0: index]
+path = os.path.join(workspace, "ascenddk/common/presenter/server")
+sys.path.append(path)
+
+import common.presenter_message_pb2 as pb2
+import display.src.display_server as display_server
+from display.src.display_server import DisplayServer
+
+FD = 7
+
+def image_chunk(frame_id, index, data, last=False, total_size=0):
+    """serialized PresentImageChunk, chunk 0 carries the image request"""
+    chunk = pb2.PresentImageChunk()
+    chunk.frame_id = frame_id
+    chunk.index = index
+    chunk.last = last
+    chunk.data = data
+    if index == 0:
+        chunk.total_size = total_size
+        chunk.image.format = pb2.kImageFormatJpeg
+        chunk.image.width = 64
+        chunk.image.height = 48
+    return chunk.SerializeToString()
+
+class TestChunkedImage(unittest.TestCase):
+    """TestChunkedImage"""
+
+    @patch('common.presenter_socket_server.PresenterSocketServer.'
+           '_create_socket_server')
+    def setUp(self, mock_create):
+        self.server = DisplayServer(("127.0.0.1", 0))
+        self.handler = MagicMock()
+        self.server.channel_manager = MagicMock()
+        self.server.channel_manager.get_channel_handler_by_fd.return_value = \
+            self.handler
+        self.server.send_message = MagicMock()
+        self.conn = MagicMock()
+        self.conn.fileno.return_value = FD
+
+    def send(self, frame_id, index, data, last=False, total_size=0):
+        """process a chunk, returns the responded error code if any"""
+        self.server.send_message.reset_mock()
+        msg_data = image_chunk(frame_id, index, data, last, total_size)
+        self.assertTrue(self.server._process_image_chunk(self.conn, msg_data)
+                        or last)
+        if not self.server.send_message.called:
+            return None
+        return self.server.send_message.call_args[0][1].error_code
+
+    def saved(self):
+        """data of the images saved, in saving order"""
+        return [bytes(call[0][0])
+                for call in self.handler.save_image.call_args_list]
+
+    def test_reassemble(self):
+        """test_reassemble"""
+        self.assertIsNone(self.send(1, 0, b'ab', total_size=5))
+        self.assertIsNone(self.send(1, 1, b'cd'))
+        self.assertEqual(4, self.server.reassembly_bytes)
+        self.assertEqual(pb2.kPresentDataErrorNone,
+                         self.send(1, 2, b'e', last=True))
+        self.assertEqual([b'abcde'], self.saved())
+        self.assertEqual(0, self.server.reassembly_bytes)
+        self.assertEqual({}, self.server.chunked_images[FD])
+
+    def test_interleaved_frames(self):
+        """images sent by several threads of a connection"""
+        self.send(1, 0, b'ab', total_size=4)
+        self.send(2, 0, b'xy', total_size=3)
+        self.assertEqual(pb2.kPresentDataErrorNone,
+                         self.send(2, 1, b'z', last=True))
+        self.assertEqual(pb2.kPresentDataErrorNone,
+                         self.send(1, 1, b'cd', last=True))
+        self.assertEqual([b'xyz', b'abcd'], self.saved())
+        self.assertEqual(0, self.server.reassembly_bytes)
+
+    def test_out_of_order_chunks(self):
+        """test_out_of_order_chunks"""
+        self.send(1, 0, b'ab', total_size=6)
+        self.send(1, 2, b'ef')
+        self.assertEqual(0, self.server.reassembly_bytes)
+        self.send(1, 1, b'cd')
+        self.assertEqual(pb2.kPresentDataErrorOther,
+                         self.send(1, 3, b'', last=True))
+        self.assertEqual([], self.saved())
+
+        # the connection goes on with the next image
+        self.send(2, 0, b'a', total_size=2)
+        self.assertEqual(pb2.kPresentDataErrorNone,
+                         self.send(2, 1, b'b', last=True))
+        self.assertEqual([b'ab'], self.saved())
+
+    def test_missing_chunk(self):
+        """test_missing_chunk"""
+        self.send(1, 0, b'ab', total_size=6)
+        self.assertEqual(pb2.kPresentDataErrorOther,
+                         self.send(1, 2, b'ef', last=True))
+        self.assertEqual([], self.saved())
+        self.assertEqual(0, self.server.reassembly_bytes)
+
+    def test_missing_first_chunk(self):
+        """test_missing_first_chunk"""
+        self.assertIsNone(self.send(1, 1, b'cd'))
+        self.assertEqual(pb2.kPresentDataErrorOther,
+                         self.send(1, 2, b'ef', last=True))
+        self.assertEqual([], self.saved())
+
+    def test_missing_last_chunk(self):
+        """the data of an image never completed is released"""
+        self.send(1, 0, b'ab', total_size=4)
+        self.send(1, 0, b'xy', total_size=3)
+        self.assertEqual(2, self.server.reassembly_bytes)
+        self.assertEqual(pb2.kPresentDataErrorNone,
+                         self.send(1, 1, b'z', last=True))
+        self.assertEqual([b'xyz'], self.saved())
+        self.assertEqual(0, self.server.reassembly_bytes)
+
+        self.send(2, 0, b'ab', total_size=4)
+        self.server._clean_connect(FD, MagicMock(), {FD: self.conn},
+                                   {FD: None})
+        self.assertEqual(0, self.server.reassembly_bytes)
+        self.assertNotIn(FD, self.server.chunked_images)
+
+    def test_size(self):
+        """test_size"""
+        size = display_server.MAX_CHUNKED_IMAGE_SIZE + 1
+        self.send(1, 0, b'ab', total_size=size)
+        self.assertEqual(0, self.server.reassembly_bytes)
+        self.assertEqual(pb2.kPresentDataErrorOther,
+                         self.send(1, 1, b'cd', last=True))
+
+        # more data than the size of the image
+        self.send(2, 0, b'ab', total_size=3)
+        self.assertEqual(pb2.kPresentDataErrorOther,
+                         self.send(2, 1, b'cd', last=True))
+        self.assertEqual([], self.saved())
+        self.assertEqual(0, self.server.reassembly_bytes)
+
+    @patch('display.src.display_server.MAX_REASSEMBLY_BYTES', 6)
+    def test_reassembly_bytes_limit(self):
+        """test_reassembly_bytes_limit"""
+        self.send(1, 0, b'abcd', total_size=5)
+        self.send(2, 0, b'xy', total_size=4)
+        self.assertEqual(6, self.server.reassembly_bytes)
+        # the image which does not fit is dropped, the others go on
+        self.send(2, 1, b'z')
+        self.assertEqual(4, self.server.reassembly_bytes)
+        self.assertEqual(pb2.kPresentDataErrorOther,
+                         self.send(2, 2, b'w', last=True))
+        self.assertEqual(pb2.kPresentDataErrorNone,
+                         self.send(1, 1, b'e', last=True))
+        self.assertEqual([b'abcde'], self.saved())
+        self.assertEqual(0, self.server.reassembly_bytes)
+
+    @patch('display.src.display_server.MAX_CHUNKED_IMAGES_PER_CONN', 2)
+    def test_images_per_connection_limit(self):
+        """test_images_per_connection_limit"""
+        self.send(1, 0, b'a', total_size=2)
+        self.send(2, 0, b'b', total_size=2)
+        self.send(3, 0, b'c', total_size=2)
+        # the oldest image is dropped
+        self.assertEqual([2, 3], list(self.server.chunked_images[FD]))
+        self.assertEqual(2, self.server.reassembly_bytes)
+        self.assertEqual(pb2.kPresentDataErrorOther,
+                         self.send(1, 1, b'a', last=True))
+        self.assertEqual(pb2.kPresentDataErrorNone,
+                         self.send(3, 1, b'c', last=True))
+        self.assertEqual([b'cc'], self.saved())
+
+if __name__ == '__main__':
+    unittest.main()
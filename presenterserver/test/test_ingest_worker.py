@@ -0,0 +1,407 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+"""utest channel metrics module"""
+
+import os
+import sys
+import time
+import select
+import threading
+import unittest
+import multiprocessing
+from unittest.mock import MagicMock
+from unittest.mock import patch
+path = os.path.dirname(__file__)
+index = path.rfind("ascenddk")
+workspace = path[0: index]
+path = os.path.join(workspace, "ascenddk/common/presenter/server")
+sys.path.append(path)
+
+import common.presenter_message_pb2 as pb2
+from common.ingest_worker import IngestBus
+from common.ingest_worker import IngestWorkerPool
+from common.ingest_worker import WORKER_FD_SPACE
+from common.channel_handler import RING_POLICY_BLOCK
+from common.channel_handler import RING_POLICY_DROP_NEWEST
+from common.channel_handler import RING_POLICY_DROP_OLDEST
+from display.src.display_server import DisplayServer
+
+WORKER_INDEX = 2
+WAIT_TIMEOUT = 5
+FRAME_SIZE = 4 * 1024 * 1024
+
+class FakeChannelManager():
+    """channels by fd, ChannelManager is a singleton shared by the worker
+    and the main process sides in one process"""
+    def __init__(self):
+        self.handlers = {}
+
+    def create_channel_resource(self, channel_name, channel_fd, media_type,
+                                handler):
+        """create_channel_resource"""
+        self.handlers[channel_fd] = handler
+
+    def clean_channel_resource_by_fd(self, sock_fileno):
+        """clean_channel_resource_by_fd"""
+        handler = self.handlers.pop(sock_fileno, None)
+        if handler is not None:
+            handler.close()
+
+    def get_channel_handler_by_fd(self, sock_fileno):
+        """get_channel_handler_by_fd"""
+        return self.handlers.get(sock_fileno)
+
+class FakeConn():
+    """agent connection, fileno is -1 once closed like a socket"""
+    def __init__(self, sock_fileno):
+        self.sock_fileno = sock_fileno
+
+    def fileno(self):
+        """fileno"""
+        return self.sock_fileno
+
+    def close(self):
+        """close"""
+        self.sock_fileno = -1
+
+def fake_open_channel(channel_manager, channel_name, media_type, key):
+    """open_channel of the main process, channel "busy" is always busy"""
+    if channel_name == "busy":
+        return pb2.kOpenChannelErrorChannelAlreadyOpened
+    channel_manager.create_channel_resource(channel_name, key, media_type,
+                                            MagicMock())
+    return pb2.kOpenChannelErrorNone
+
+def wait_until(predicate):
+    """wait for the bus thread of the main process"""
+    deadline = time.time() + WAIT_TIMEOUT
+    while not predicate():
+        if time.time() > deadline:
+            return False
+        time.sleep(0.01)
+    return True
+
+class TestIngestBus(unittest.TestCase):
+    """the worker side and the main process side of the bus, with the bus
+    thread of the main process in this process"""
+
+    def setUp(self):
+        patcher = patch('common.ingest_worker.open_channel',
+                        side_effect=fake_open_channel)
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+        self.main_conn, worker_conn = multiprocessing.Pipe()
+        self.pool = IngestWorkerPool.__new__(IngestWorkerPool)
+        self.pool.channel_manager = FakeChannelManager()
+        self.pool.open_lock = threading.Lock()
+        self.pool.workers = []
+        self.bus_thread = threading.Thread(
+            target=self.pool._bus_thread, args=(WORKER_INDEX, self.main_conn))
+        self.bus_thread.start()
+        self.addCleanup(self.bus_thread.join, WAIT_TIMEOUT)
+
+        self.bus = IngestBus(worker_conn, WORKER_INDEX)
+        self.addCleanup(self.bus.close)
+        self.channel_manager = FakeChannelManager()
+        self.results = {}
+
+    def key(self, sock_fileno):
+        """key of a worker fileno in the main process"""
+        return (WORKER_INDEX + 1) * WORKER_FD_SPACE + sock_fileno
+
+    def open(self, conn, channel_name="video"):
+        """request to open a channel, the result is kept in self.results"""
+        def callback(err_code):
+            self.results[conn] = err_code
+            return err_code == pb2.kOpenChannelErrorNone
+        self.bus.open_channel(self.channel_manager, channel_name, "video",
+                              conn, callback)
+
+    def process_replies(self, count):
+        """process the replies of the bus until count are received"""
+        failed = []
+        deadline = time.time() + WAIT_TIMEOUT
+        while len(self.bus.pending_opens) > count and \
+              time.time() < deadline:
+            self.bus.conn.poll(WAIT_TIMEOUT)
+            ret, conns = self.bus.process_replies()
+            self.assertTrue(ret)
+            failed += conns
+        return failed
+
+    def test_open_frame_close(self):
+        """test_open_frame_close"""
+        conn = FakeConn(5)
+        self.open(conn)
+        # never blocks for the reply
+        self.assertEqual({}, self.results)
+        self.assertEqual([], self.process_replies(0))
+        self.assertEqual(pb2.kOpenChannelErrorNone, self.results[conn])
+        handler = self.channel_manager.get_channel_handler_by_fd(5)
+        self.assertEqual("video", handler.channel_name)
+        main_handler = self.pool.channel_manager.get_channel_handler_by_fd(
+            self.key(5))
+        self.assertIsNotNone(main_handler)
+
+        handler.set_heartbeat()
+        handler.save_image(memoryview(b'abc'), 64, 48, [1])
+        handler.save_images([(b'de', 32, 24, []), (b'f', 16, 12, [2])])
+        handler.save_rois(b'', 64, 48, [3], [b'g', b'hi'])
+        self.assertTrue(wait_until(
+            lambda: main_handler.save_image.call_count == 2))
+        main_handler.set_heartbeat.assert_called_once_with()
+        self.assertEqual(
+            [(b'abc', 64, 48, [1], None), (b'', 64, 48, [3], [b'g', b'hi'])],
+            [call[0] for call in main_handler.save_image.call_args_list])
+        main_handler.save_images.assert_called_once_with(
+            [(b'de', 32, 24, []), (b'f', 16, 12, [2])])
+
+        self.channel_manager.clean_channel_resource_by_fd(5)
+        self.assertTrue(wait_until(
+            lambda: self.pool.channel_manager.get_channel_handler_by_fd(
+                self.key(5)) is None))
+        main_handler.close.assert_called_once_with()
+
+    def test_open_failed(self):
+        """test_open_failed"""
+        conn = FakeConn(5)
+        self.open(conn, "busy")
+        self.assertEqual([conn], self.process_replies(0))
+        self.assertEqual(pb2.kOpenChannelErrorChannelAlreadyOpened,
+                         self.results[conn])
+        self.assertIsNone(self.channel_manager.get_channel_handler_by_fd(5))
+
+    def test_replies_in_order(self):
+        """test_replies_in_order"""
+        conns = [FakeConn(5), FakeConn(6), FakeConn(7)]
+        self.open(conns[0])
+        self.open(conns[1], "busy")
+        self.open(conns[2], "image")
+        self.assertEqual([conns[1]], self.process_replies(0))
+        self.assertEqual([pb2.kOpenChannelErrorNone,
+                          pb2.kOpenChannelErrorChannelAlreadyOpened,
+                          pb2.kOpenChannelErrorNone],
+                         [self.results[conn] for conn in conns])
+        self.assertEqual([5, 7], sorted(self.channel_manager.handlers))
+
+    def test_connection_closed_before_reply(self):
+        """the channel opened for a closed connection is closed"""
+        conn = FakeConn(5)
+        self.open(conn)
+        conn.close()
+        self.assertEqual([], self.process_replies(0))
+        self.assertEqual({}, self.results)
+        self.assertEqual({}, self.channel_manager.handlers)
+        self.assertTrue(wait_until(
+            lambda: not self.pool.channel_manager.handlers))
+
+    def test_fileno_reused_before_reply(self):
+        """the channel of the closed connection is closed before the new
+        connection of the same fileno opens its channel"""
+        old_conn = FakeConn(5)
+        self.open(old_conn, "old")
+        old_conn.close()
+        new_conn = FakeConn(5)
+        self.open(new_conn, "new")
+        self.assertEqual([], self.process_replies(0))
+        self.assertEqual({new_conn: pb2.kOpenChannelErrorNone}, self.results)
+        self.assertEqual("new",
+                         self.channel_manager.handlers[5].channel_name)
+        self.assertTrue(wait_until(
+            lambda: len(self.pool.channel_manager.handlers) == 1))
+        # the channel of the new connection is kept
+        main_handler = self.pool.channel_manager.handlers[self.key(5)]
+        main_handler.close.assert_not_called()
+
+    def test_main_process_exited(self):
+        """test_main_process_exited"""
+        main_conn, worker_conn = multiprocessing.Pipe()
+        self.bus = IngestBus(worker_conn, WORKER_INDEX)
+        self.addCleanup(self.bus.close)
+        conn = FakeConn(5)
+        self.open(conn)
+        main_conn.close()
+        ret, failed = self.bus.process_replies()
+        self.assertFalse(ret)
+        self.assertEqual([conn], failed)
+        self.assertEqual(pb2.kOpenChannelErrorOther, self.results[conn])
+        # messages are discarded once the main process exits
+        self.bus.set_heartbeat(5)
+        self.assertFalse(self.bus.has_unsent())
+
+@patch('common.ingest_worker.MAX_BUS_UNSENT_BYTES', 2 * FRAME_SIZE)
+class TestIngestBusFull(unittest.TestCase):
+    """frames forwarded while the main process does not receive them"""
+
+    def setUp(self):
+        self.main_conn, worker_conn = multiprocessing.Pipe()
+        self.addCleanup(self.main_conn.close)
+        self.worker_conn = worker_conn
+        self.pool = IngestWorkerPool.__new__(IngestWorkerPool)
+        self.pool.channel_manager = FakeChannelManager()
+        self.pool.open_lock = threading.Lock()
+        self.pool.workers = []
+        self.key = (WORKER_INDEX + 1) * WORKER_FD_SPACE + 5
+        self.main_handler = MagicMock()
+        self.pool.channel_manager.handlers[self.key] = self.main_handler
+
+    def forward(self, policy):
+        """forward frames 0 to 4 with the bus full"""
+        self.bus = IngestBus(self.worker_conn, WORKER_INDEX, policy)
+        self.addCleanup(self.bus.close)
+        for i in range(5):
+            self.bus.save_images(5, [(bytes([i]) * FRAME_SIZE, 64, 48, [],
+                                      None)])
+            # the socket buffer holds a part of the first frame only
+            self.assertTrue(self.bus.has_unsent())
+
+    def receive(self):
+        """receive the frames queued, then forward frame 5"""
+        bus_thread = threading.Thread(
+            target=self.pool._bus_thread, args=(WORKER_INDEX, self.main_conn))
+        bus_thread.start()
+        while self.bus.has_unsent():
+            self.bus.flush()
+            time.sleep(0.001)
+        self.bus.save_images(5, [(bytes([5]) * FRAME_SIZE, 64, 48, [], None)])
+        while self.bus.has_unsent():
+            self.bus.flush()
+            time.sleep(0.001)
+        self.bus.close()
+        bus_thread.join(WAIT_TIMEOUT)
+        self.assertFalse(bus_thread.is_alive())
+        # the frames received, by their first bytes
+        received = [call[0][0] for call in
+                    self.main_handler.save_image.call_args_list]
+        for data in received:
+            self.assertEqual(FRAME_SIZE, len(data))
+        return [data[0] for data in received]
+
+    def test_drop_newest(self):
+        """test_drop_newest"""
+        self.forward(RING_POLICY_DROP_NEWEST)
+        self.assertFalse(self.bus.is_blocked())
+        self.assertEqual({self.key: 3}, self.bus.dropped)
+        received = self.receive()
+        self.assertEqual([0, 1, 5], received)
+        self.main_handler.metrics.add_drops.assert_called_once_with(3)
+
+    def test_drop_oldest(self):
+        """test_drop_oldest"""
+        self.forward(RING_POLICY_DROP_OLDEST)
+        self.assertFalse(self.bus.is_blocked())
+        self.assertLessEqual(self.bus.unsent_bytes, 2 * FRAME_SIZE)
+        # the first frame is being sent, the latest one is kept
+        received = self.receive()
+        self.assertEqual([0, 4, 5], received)
+        self.main_handler.metrics.add_drops.assert_called_once_with(3)
+
+    def test_block(self):
+        """test_block"""
+        self.forward(RING_POLICY_BLOCK)
+        self.assertTrue(self.bus.is_blocked())
+        self.assertEqual({}, self.bus.dropped)
+        received = self.receive()
+        self.assertEqual(list(range(6)), received)
+        self.main_handler.metrics.add_drops.assert_not_called()
+
+    def test_control_messages_in_order(self):
+        """heartbeat and close are never dropped, and keep their order
+        with the frames"""
+        self.forward(RING_POLICY_DROP_NEWEST)
+        self.bus.set_heartbeat(5)
+        self.bus.close_channel(5)
+        self.assertEqual({}, self.bus.dropped)
+        received = self.receive()
+        self.assertEqual([0, 1], received)
+        self.main_handler.set_heartbeat.assert_called_once_with()
+        self.main_handler.close.assert_called_once_with()
+
+class TestIngestWorkerServer(unittest.TestCase):
+    """open channel requests of the agents in an ingest worker"""
+
+    @patch('common.presenter_socket_server.PresenterSocketServer.'
+           '_create_socket_server')
+    def test_open_channel_replied_later(self, mock_create):
+        """test_open_channel_replied_later"""
+        bus = MagicMock()
+        server = DisplayServer(("127.0.0.1", 0), ingest_bus=bus)
+        server.send_message = MagicMock()
+        request = pb2.OpenChannelRequest()
+        request.channel_name = "video"
+        request.content_type = pb2.kChannelContentTypeVideo
+        conn = FakeConn(5)
+        self.assertTrue(server._process_open_channel(
+            conn, request.SerializeToString()))
+        server.send_message.assert_not_called()
+
+        callback = bus.open_channel.call_args[0][4]
+        self.assertTrue(callback(pb2.kOpenChannelErrorNone))
+        response = server.send_message.call_args[0][1]
+        self.assertEqual(pb2.kOpenChannelErrorNone, response.error_code)
+
+        # a failed send closes the connection
+        server.send_message.side_effect = OSError
+        self.assertFalse(callback(pb2.kOpenChannelErrorNone))
+
+    @patch('common.presenter_socket_server.PresenterSocketServer.'
+           '_create_socket_server')
+    def test_paused_while_bus_blocked(self, mock_create):
+        """agent connections are not read while the bus is full"""
+        bus = MagicMock()
+        bus.fileno.return_value = 3
+        server = DisplayServer(("127.0.0.1", 0), ingest_bus=bus)
+        server.bus_events = select.EPOLLIN
+        epoll = MagicMock()
+        reader = MagicMock()
+        reader.read.return_value = (True, [])
+        conns = {5: FakeConn(5)}
+        readers = {5: reader}
+
+        bus.is_blocked.return_value = True
+        bus.has_unsent.return_value = True
+        server._process_epollin(5, epoll, conns, readers)
+        epoll.modify.assert_called_once_with(5, select.EPOLLHUP)
+        server._update_bus_events(epoll)
+        epoll.modify.assert_called_with(3, select.EPOLLIN | select.EPOLLOUT)
+
+        bus.is_blocked.return_value = False
+        bus.has_unsent.return_value = False
+        epoll.reset_mock()
+        server._update_bus_events(epoll)
+        epoll.modify.assert_any_call(3, select.EPOLLIN)
+        epoll.modify.assert_any_call(5, select.EPOLLIN | select.EPOLLHUP)
+        self.assertEqual(set(), server.paused)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,284 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+"""utest channel metrics module"""
+
+"""utest message reader of presenter socket server"""
+
+import os
+import sys
+import socket
+import select
+import unittest
+from unittest.mock import MagicMock
+from unittest.mock import patch
+path = os.path.dirname(__file__)
+index = path.rfind("ascenddk")
+workspace = path[0: index]
+path = os.path.join(workspace, "ascenddk/common/presenter/server")
+sys.path.append(path)
+
+import common.presenter_message_pb2 as pb2
+import common.presenter_socket_server as presenter_socket_server
+from common.presenter_socket_server import MessageReader
+from common.presenter_socket_server import PresenterSocketServer
+from common.presenter_socket_server import parse_message
+from common.presenter_socket_server import MSG_HEAD
+from common.presenter_socket_server import CONN_EVENTS
+from common.presenter_socket_server import CONN_EVENTS_UNSENT
+
+PRESENT_IMAGE_NAME = pb2._PRESENTIMAGEREQUEST.full_name
+
+def pack_message(msg_name, msg_body):
+    """head, name and body of a message, as the agent sends it"""
+    name = bytes(msg_name, encoding="utf-8")
+    return MSG_HEAD.pack(MSG_HEAD.size + len(name) + len(msg_body),
+                         len(name)) + name + msg_body
+
+def image_message(size):
+    """serialized PresentImageRequest with size bytes of image data"""
+    request = pb2.PresentImageRequest()
+    request.width = 16
+    request.height = 8
+    request.data = bytes(i % 251 for i in range(size))
+    return request.SerializeToString()
+
+
+class TestMessageReader(unittest.TestCase):
+    """TestMessageReader"""
+    def setUp(self):
+        self.agent, self.conn = socket.socketpair()
+        self.conn.setblocking(False)
+        self.reader = MessageReader(self.conn)
+
+    def tearDown(self):
+        self.agent.close()
+        self.conn.close()
+
+    def _send_and_read(self, data):
+        """send data, reading as the socket buffer fills"""
+        self.agent.setblocking(False)
+        msgs = []
+        view = memoryview(data)
+        while view:
+            try:
+                view = view[self.agent.send(view):]
+            except BlockingIOError:
+                pass
+            ret, part = self.reader.read()
+            self.assertEqual(ret, True)
+            msgs += part
+        return msgs
+
+    def test_nothing_to_read(self):
+        """utest"""
+        ret, msgs = self.reader.read()
+        self.assertEqual(ret, True)
+        self.assertEqual(msgs, [])
+
+    def test_partial_head_and_body(self):
+        """utest"""
+        data = pack_message("heartbeat", b"0123456789")
+        for byte in data[:-1]:
+            self.agent.sendall(bytes([byte]))
+            ret, msgs = self.reader.read()
+            self.assertEqual(ret, True)
+            self.assertEqual(msgs, [])
+
+        self.agent.sendall(data[-1:])
+        ret, msgs = self.reader.read()
+        self.assertEqual(ret, True)
+        self.assertEqual(msgs, [("heartbeat", b"0123456789")])
+
+    def test_many_messages_in_one_read(self):
+        """utest"""
+        data = b''.join(pack_message("msg", bytes([i]) * i)
+                        for i in range(10))
+        self.agent.sendall(data)
+        ret, msgs = self.reader.read()
+        self.assertEqual(ret, True)
+        self.assertEqual(msgs, [("msg", bytes([i]) * i) for i in range(10)])
+
+    def test_message_split_across_events(self):
+        """utest"""
+        body = image_message(3 * presenter_socket_server.RECV_BUFFER_SIZE)
+        data = pack_message(PRESENT_IMAGE_NAME, body) + \
+               pack_message("heartbeat", b'')
+        split = [0, 3, 100, len(data) // 2, len(data) - 2, len(data)]
+        msgs = []
+        for start, end in zip(split, split[1:]):
+            msgs += self._send_and_read(data[start:end])
+
+        self.assertEqual(msgs, [(PRESENT_IMAGE_NAME, body),
+                                ("heartbeat", b'')])
+        self.assertEqual(self.reader.large_body, None)
+
+    def test_message_too_long(self):
+        """utest"""
+        name = b"msg"
+        total_len = presenter_socket_server.MAX_MSG_LENGTH + 1
+        self.agent.sendall(MSG_HEAD.pack(total_len, len(name)) + name)
+        ret, msgs = self.reader.read()
+        self.assertEqual(ret, False)
+        self.assertEqual(msgs, [])
+        self.assertEqual(self.reader.large_body, None)
+
+    def test_message_length_too_short(self):
+        """utest"""
+        self.agent.sendall(MSG_HEAD.pack(MSG_HEAD.size + 2, 3) + b"msg")
+        ret, _ = self.reader.read()
+        self.assertEqual(ret, False)
+
+    def test_closed_by_peer(self):
+        """utest"""
+        self.agent.sendall(pack_message("msg", b"body"))
+        self.agent.close()
+        ret, msgs = self.reader.read()
+        self.assertEqual(ret, True)
+        self.assertEqual(msgs, [("msg", b"body")])
+        ret, msgs = self.reader.read()
+        self.assertEqual(ret, False)
+        self.assertEqual(msgs, [])
+
+    @patch("common.presenter_socket_server.MAX_READ_PER_EVENT", 1024)
+    def test_read_per_event_limited(self):
+        """utest"""
+        # the other connections get their turn, the rest is read next event
+        data = b''.join(pack_message("msg", bytes(500)) for _ in range(8))
+        self.agent.sendall(data)
+        reader = MessageReader(self.conn)
+        reader.buf = bytearray(512)
+        reader.view = memoryview(reader.buf)
+        ret, msgs = reader.read()
+        self.assertEqual(ret, True)
+        self.assertLess(len(msgs), 8)
+        received = len(msgs)
+        while received < 8:
+            ret, msgs = reader.read()
+            self.assertEqual(ret, True)
+            self.assertNotEqual(msgs, [])
+            received += len(msgs)
+        self.assertEqual(received, 8)
+
+
+class TestParseMessage(unittest.TestCase):
+    """TestParseMessage"""
+    def test_bytes_field_sliced(self):
+        """utest"""
+        data = image_message(1000)
+        request = pb2.PresentImageRequest()
+        fields = parse_message(request, data, (4,))
+        expected = pb2.PresentImageRequest()
+        expected.ParseFromString(data)
+        self.assertEqual(len(fields[4]), 1)
+        self.assertEqual(bytes(fields[4][0]), expected.data)
+        self.assertIs(fields[4][0].obj, data)
+        self.assertEqual(request.width, 16)
+        self.assertEqual(request.height, 8)
+        self.assertEqual(request.data, b'')
+
+    def test_truncated(self):
+        """utest"""
+        data = image_message(1000)
+        request = pb2.PresentImageRequest()
+        with self.assertRaises(presenter_socket_server.DecodeError):
+            parse_message(request, data[:-1], (4,))
+
+
+class TestSendAll(unittest.TestCase):
+    """unsent bytes of a connection are sent when it is writable"""
+    def setUp(self):
+        self.agent, self.conn = socket.socketpair()
+        self.conn.setblocking(False)
+        self.conn.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 4096)
+        self.fd = self.conn.fileno()
+        self.server = PresenterSocketServer.__new__(PresenterSocketServer)
+        self.server.epoll = MagicMock()
+        self.server.unsent = {}
+        self.server.paused = set()
+        self.server._clean_connect = MagicMock()
+        self.conns = {self.fd: self.conn}
+
+    def tearDown(self):
+        self.agent.close()
+        self.conn.close()
+
+    def _receive(self, size):
+        self.agent.settimeout(1)
+        data = b''
+        while len(data) < size:
+            data += self.agent.recv(size - len(data))
+        return data
+
+    def test_sent_at_once(self):
+        """utest"""
+        self.server._send_all(self.conn, b"response")
+        self.assertEqual(self.server.unsent, {})
+        self.server.epoll.modify.assert_not_called()
+        self.assertEqual(self._receive(8), b"response")
+
+    def test_queued_until_writable(self):
+        """utest"""
+        data = bytes(i % 256 for i in range(1024 * 1024))
+        self.server._send_all(self.conn, data)
+        self.server._send_all(self.conn, b"next")
+        self.assertIn(self.fd, self.server.unsent)
+        self.server.epoll.modify.assert_called_once_with(self.fd,
+                                                         CONN_EVENTS_UNSENT)
+
+        received = b''
+        while self.fd in self.server.unsent:
+            received += self.agent.recv(len(data))
+            self.server._process_epollout(self.fd, self.server.epoll,
+                                          self.conns, {})
+        received += self._receive(len(data) + 4 - len(received))
+        self.assertEqual(received, data + b"next")
+        self.server.epoll.modify.assert_called_with(self.fd, CONN_EVENTS)
+        self.server._clean_connect.assert_not_called()
+
+    def test_too_many_unsent(self):
+        """utest"""
+        self.server._send_all(self.conn, bytes(1024 * 1024))
+        with self.assertRaises(socket.error):
+            self.server._send_all(self.conn, bytes(1024 * 1024))
+
+    def test_send_error(self):
+        """utest"""
+        self.server._send_all(self.conn, bytes(1024 * 1024))
+        self.agent.close()
+        self.server._process_epollout(self.fd, self.server.epoll,
+                                      self.conns, {})
+        self.assertEqual(self.server.unsent, {})
+        self.server._clean_connect.assert_called_once_with(
+            self.fd, self.server.epoll, self.conns, {})
+
+if __name__ == '__main__':
+    unittest.main()
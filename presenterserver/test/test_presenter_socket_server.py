@@ -51,6 +51,7 @@ sys.path.append(path)
 import common.channel_manager as channel_manager
 import common.channel_handler as channel_handler
 import common.presenter_message_pb2 as pb
+from common.presenter_socket_server import MessageReader
 from face_detection.src.face_detection_server import FaceDetectionServer
 
 
@@ -330,11 +331,11 @@ def response_image_request(client):
     except socket.error:
         return False
 
-def socket_error(fd, conns, messages):
+def socket_error(fd, epoll, conns, readers):
     """func"""
     raise socket.error
 
-def mock_recv(len):
+def mock_recv(buf):
     raise socket.error
 
 
@@ -707,7 +708,7 @@ class Test_FaceDetectionServer(unittest.TestCase):
         server.stop_thread()
 
 
-    @patch("socket.socket.recv")
+    @patch("socket.socket.recv_into")
     def test_read_socket(self, mock_socket_recv):
         """utest"""
         mock_socket_recv.side_effect = mock_recv
@@ -716,54 +717,10 @@ class Test_FaceDetectionServer(unittest.TestCase):
 
         client = create_sock_client(server_address)
         self.assertNotEqual(client, None)
-        # test _read_socket
-        ret, _ = server._read_socket(client, 10)
-        self.assertEqual(ret, False)
-
-        # clean
-        client.close()
-        server.stop_thread()
-
-    @patch("socket.socket.recv")
-    def test_read_msg_name(self, mock_socket_recv):
-        """utest"""
-        mock_socket_recv.side_effect = mock_recv
-        server_address = get_socket_server_addr()
-        server = FaceDetectionServer(server_address)
-
-        client = create_sock_client(server_address)
-        self.assertNotEqual(client, None)
-        # prepare para
-        fd = 1
-        conns = {1:client}
-        msg_body_len = 10
-
-        # test _read_socket
-        ret, _ = server._read_msg_name(fd, conns, msg_body_len)
-        self.assertEqual(ret, False)
-
-        # clean
-        client.close()
-        server.stop_thread()
-
-    @patch("socket.socket.recv")
-    def test_read_msg_body(self, mock_socket_recv):
-        """utest"""
-        mock_socket_recv.side_effect = mock_recv
-        server_address = get_socket_server_addr()
-        server = FaceDetectionServer(server_address)
-
-        client = create_sock_client(server_address)
-        self.assertNotEqual(client, None)
-        # prepare para
-        fd = 1
-        conns = {1:client}
-        msg_body_len = 10
-        msgs = {}
-
-        # test _read_socket
-        ret = server._read_msg_body(fd, conns, msg_body_len, msgs)
+        # test MessageReader.read
+        ret, msgs = MessageReader(client).read()
         self.assertEqual(ret, False)
+        self.assertEqual(msgs, [])
 
         # clean
         client.close()
@@ -789,9 +746,9 @@ class Test_FaceDetectionServer(unittest.TestCase):
         server.stop_thread()
 
 
-    @patch("common.presenter_socket_server.PresenterSocketServer._read_msg_body")
-    def test_read_msg_body_error(self, mock_read_msg_body):
-        mock_read_msg_body.return_value = False
+    @patch("common.presenter_socket_server.MessageReader.read")
+    def test_read_msg_body_error(self, mock_read):
+        mock_read.return_value = (False, [])
         server_address = get_socket_server_addr()
         server = FaceDetectionServer(server_address)
 
@@ -812,10 +769,10 @@ class Test_FaceDetectionServer(unittest.TestCase):
 
 
 
-    @patch("common.presenter_socket_server.PresenterSocketServer._read_sock_and_process_msg")
-    def test_socket_recv_error(self, mock_read_and_process_msg):
+    @patch("common.presenter_socket_server.PresenterSocketServer._process_epollin")
+    def test_socket_recv_error(self, mock_process_epollin):
         """utest"""
-        mock_read_and_process_msg.side_effect = socket_error
+        mock_process_epollin.side_effect = socket_error
 
         server_address = get_socket_server_addr()
         server = FaceDetectionServer(server_address)
@@ -0,0 +1,167 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+"""utest channel metrics module"""
+
+"""utest MJPEG stream of web module"""
+
+import os
+import sys
+import unittest
+from unittest.mock import MagicMock
+from unittest.mock import patch
+import tornado.concurrent
+import tornado.iostream
+path = os.path.dirname(__file__)
+index = path.rfind("ascenddk")
+workspace = path[0: index]
+path = os.path.join(workspace, "ascenddk/common/presenter/server")
+sys.path.append(path)
+
+from display.src.web import FramePayload
+from display.src.web import MjpegHandler
+from display.src.web import MJPEG_BOUNDARY
+from display.src.web import make_mjpeg_part
+
+CHANNEL_NAME = "video"
+
+def make_payload(image, crop_list=None):
+    """FramePayload of a frame of the video channel"""
+    return FramePayload(CHANNEL_NAME, (image, 10, 640, 480, [], crop_list))
+
+
+class TestMakeMjpegPart(unittest.TestCase):
+    """TestMakeMjpegPart"""
+    def test_part(self):
+        """utest"""
+        image = b'\xff\xd8\xff\xe0' + bytes(range(256)) + b'\xff\xd9'
+        part = make_mjpeg_part(image)
+        head = ("--%s\r\nContent-Type: image/jpeg\r\nContent-Length: %d"
+                "\r\n\r\n" % (MJPEG_BOUNDARY, len(image))).encode('utf-8')
+        self.assertEqual(part, head + image + b'\r\n')
+
+    def test_part_of_payload_made_once(self):
+        """utest"""
+        payload = make_payload(b'jpeg')
+        part = payload.get_part()
+        self.assertEqual(part, make_mjpeg_part(b'jpeg'))
+        self.assertIs(payload.get_part(), part)
+
+
+class TestMjpegHandler(unittest.TestCase):
+    """frames pushed while the last one is being written"""
+    def setUp(self):
+        self.handler = MjpegHandler.__new__(MjpegHandler)
+        self.handler.channel_name = CHANNEL_NAME
+        self.handler.sending = False
+        self.handler.pending = None
+        self.handler.skipped = 0
+        self.handler.closed = tornado.concurrent.Future()
+        self.handler.write = MagicMock()
+        self.flushes = []
+        self.handler.flush = self._flush
+        patcher = patch("tornado.ioloop.IOLoop.current")
+        self.ioloop = patcher.start().return_value
+        self.addCleanup(patcher.stop)
+
+    def _flush(self):
+        future = tornado.concurrent.Future()
+        self.flushes.append(future)
+        return future
+
+    def _written(self):
+        return [call[0][0] for call in self.handler.write.call_args_list]
+
+    def _complete_flush(self, exception=None):
+        """the last frame is written, or failed to"""
+        future = self.flushes[-1]
+        if exception is None:
+            future.set_result(None)
+        else:
+            future.set_exception(exception)
+        self.ioloop.add_future.assert_called_with(future,
+                                                  self.handler._on_sent)
+        self.handler._on_sent(future)
+
+    def test_frames_sent_in_order(self):
+        """utest"""
+        for image in (b'frame1', b'frame2'):
+            self.handler.push_frame(make_payload(image))
+            self._complete_flush()
+
+        self.assertEqual(self._written(), [make_mjpeg_part(b'frame1'),
+                                           make_mjpeg_part(b'frame2')])
+        self.assertEqual(self.handler.skipped, 0)
+        self.assertFalse(self.handler.sending)
+
+    def test_slow_client_skips_frames(self):
+        """utest"""
+        for i in range(5):
+            self.handler.push_frame(make_payload(b'frame%d' % i))
+
+        # frame0 is being written, frame4 replaced the ones waiting before
+        self.assertEqual(self._written(), [make_mjpeg_part(b'frame0')])
+        self.assertEqual(self.handler.skipped, 3)
+
+        self._complete_flush()
+        self._complete_flush()
+        self.assertEqual(self._written(), [make_mjpeg_part(b'frame0'),
+                                           make_mjpeg_part(b'frame4')])
+        self.assertEqual(self.handler.pending, None)
+        self.assertFalse(self.handler.sending)
+
+    def test_crops_only_frame_skipped(self):
+        """utest"""
+        self.handler.push_frame(make_payload(b'', [b'crop']))
+        self.handler.write.assert_not_called()
+
+        # a crops only frame does not replace the frame waiting
+        self.handler.push_frame(make_payload(b'frame0'))
+        self.handler.push_frame(make_payload(b'frame1'))
+        self.handler.push_frame(make_payload(b'', [b'crop']))
+        self._complete_flush()
+        self.assertEqual(self._written(), [make_mjpeg_part(b'frame0'),
+                                           make_mjpeg_part(b'frame1')])
+        self.assertEqual(self.handler.skipped, 0)
+
+    def test_client_closed(self):
+        """utest"""
+        self.handler.push_frame(make_payload(b'frame0'))
+        self.handler.push_frame(make_payload(b'frame1'))
+        self._complete_flush(tornado.iostream.StreamClosedError())
+        self.assertTrue(self.handler.closed.done())
+
+        # frames after closed are dropped
+        self.handler.push_frame(make_payload(b'frame2'))
+        self.assertEqual(self._written(), [make_mjpeg_part(b'frame0')])
+
+if __name__ == '__main__':
+    unittest.main()